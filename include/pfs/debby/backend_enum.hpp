@@ -1,10 +1,13 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.10.29 Initial version.
+//      2026.10.18 Added `flat_hash_map_st` and `flat_hash_map_mt`.
+//                 Added `radix_tree_st` and `radix_tree_mt`.
+//                 Added `lru_cache_st` and `lru_cache_mt`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -22,6 +25,12 @@ enum class backend_enum
     , lmdb             // KV only
     , mdbx             // KV only
     , rocksdb          // KV only
+    , flat_hash_map_st // in-memory thread unsafe open-addressing hash map, K/V only
+    , flat_hash_map_mt // in-memory thread safe open-addressing hash map, K/V only
+    , radix_tree_st    // in-memory thread unsafe ordered adaptive radix tree, K/V only
+    , radix_tree_mt    // in-memory thread safe ordered adaptive radix tree, K/V only
+    , lru_cache_st     // in-memory thread unsafe memory-bounded cache, K/V only
+    , lru_cache_mt     // in-memory thread safe memory-bounded cache, K/V only
 };
 
 DEBBY__NAMESPACE_END
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "error.hpp"
+#include "exports.hpp"
+#include <pfs/filesystem.hpp>
+#include <pfs/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Blocked (split block) bloom filter.
+ *
+ * @details Each key sets one bit in each of eight 32-bit words of a single 256-bit
+ *          block, so a probe touches one cache line and is checked by a couple of
+ *          vector instructions (AVX2 or SSE2, portable code otherwise). With 10 bits
+ *          per key false positive rate is about 1%.
+ *
+ *          Keys can not be removed from the filter.
+ *
+ * @note Filter is not thread safe: `insert()` must not be called concurrently with
+ *       other methods.
+ */
+class bloom_filter
+{
+public:
+    static constexpr std::size_t BLOCK_WORDS = 8;
+
+private:
+    std::vector<std::uint32_t> _words; // BLOCK_WORDS per block
+    std::uint64_t _count {0};          // Number of inserted keys
+
+public:
+    bloom_filter () = default;
+
+    /**
+     * Constructs empty filter sized for @a expected_keys with @a bits_per_key bits
+     * per key.
+     */
+    DEBBY__EXPORT bloom_filter (std::size_t expected_keys, unsigned bits_per_key = 10);
+
+public:
+    /**
+     * Hash of the key used by `insert()` and `may_contain()`.
+     */
+    DEBBY__EXPORT static std::uint64_t hash (char const * key, std::size_t size) noexcept;
+
+    static std::uint64_t hash (pfs::string_view key) noexcept
+    {
+        return hash(key.data(), key.size());
+    }
+
+    DEBBY__EXPORT void insert (std::uint64_t h) noexcept;
+
+    void insert (pfs::string_view key) noexcept
+    {
+        insert(hash(key));
+    }
+
+    /**
+     * Returns @c false if key with hash @a h was definitely not inserted.
+     */
+    DEBBY__EXPORT bool may_contain (std::uint64_t h) const noexcept;
+
+    bool may_contain (pfs::string_view key) const noexcept
+    {
+        return may_contain(hash(key));
+    }
+
+    /**
+     * Removes all keys keeping the filter size.
+     */
+    DEBBY__EXPORT void clear () noexcept;
+
+    std::size_t block_count () const noexcept
+    {
+        return _words.size() / BLOCK_WORDS;
+    }
+
+    std::size_t size_bytes () const noexcept
+    {
+        return _words.size() * sizeof(std::uint32_t);
+    }
+
+    /**
+     * Number of insertions (including repeated keys).
+     */
+    std::uint64_t count () const noexcept
+    {
+        return _count;
+    }
+
+    /**
+     * False positive rate estimated from the fraction of set bits.
+     */
+    DEBBY__EXPORT double estimated_false_positive_rate () const noexcept;
+
+    /**
+     * Writes filter image into file at @a path (atomically replacing it).
+     *
+     * @throw debby::error()
+     */
+    DEBBY__EXPORT bool save (pfs::filesystem::path const & path, error * perr = nullptr) const;
+
+    /**
+     * Reads filter image from file at @a path.
+     *
+     * @return Empty filter (with zero `block_count()`) on error.
+     *
+     * @throw debby::error{errc::database_not_found} if file does not exist.
+     * @throw debby::error{errc::bad_value} if file is corrupted.
+     * @throw debby::error{errc::unsupported} if file was written on platform with
+     *        different byte order.
+     */
+    DEBBY__EXPORT static bloom_filter load (pfs::filesystem::path const & path, error * perr = nullptr);
+};
+
+DEBBY__NAMESPACE_END
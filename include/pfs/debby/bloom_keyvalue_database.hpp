@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "backend_enum.hpp"
+#include "bloom_filter.hpp"
+#include "error.hpp"
+#include "keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <pfs/string_view.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+struct bloom_options
+{
+    // Initial filter capacity, the filter is sized for the actual number of keys
+    // when rebuilt
+    std::size_t expected_keys {100000};
+
+    unsigned bits_per_key {10};
+
+    // Filter file stored alongside the database, if empty the filter is rebuilt by the
+    // key scan each time the adapter is constructed
+    pfs::filesystem::path path;
+};
+
+struct bloom_stats
+{
+    std::uint64_t lookups {0};         // Number of `get()` calls
+    std::uint64_t negatives {0};       // Lookups answered by the filter (key is absent)
+    std::uint64_t false_positives {0}; // Lookups of absent keys passed through the filter
+
+    /**
+     * Observed fraction of absent key lookups not answered by the filter.
+     */
+    double false_positive_rate () const noexcept
+    {
+        auto absent = negatives + false_positives;
+        return absent == 0 ? 0.0 : static_cast<double>(false_positives) / static_cast<double>(absent);
+    }
+};
+
+/**
+ * Key-value database adapter short-circuiting lookups of absent keys by the bloom
+ * filter (intended for persistent backends where the miss costs a disk read).
+ *
+ * @details The filter is loaded from `bloom_options::path` if the file exists or is
+ *          rebuilt by the key scan. The loaded file is removed until the filter is saved
+ *          again by `save()` or by the destructor, so the filter outdated by a crash is
+ *          never loaded. Removed keys stay in the filter (making it less selective) until
+ *          `rebuild()`.
+ *
+ *          All writes must go through the adapter, otherwise lookups of keys written
+ *          directly may report the key as absent.
+ *
+ * @note Adapter is not thread safe for concurrent writes.
+ */
+template <backend_enum Backend>
+class bloom_keyvalue_database
+{
+public:
+    using database_type = keyvalue_database<Backend>;
+    using key_type = std::string;
+    using string_view = pfs::string_view;
+
+private:
+    struct context
+    {
+        database_type db;
+        bloom_options opts;
+        bloom_filter filter;
+        bool persisted {false}; // Filter file is up to date
+
+        mutable std::atomic<std::uint64_t> lookups {0};
+        mutable std::atomic<std::uint64_t> negatives {0};
+        mutable std::atomic<std::uint64_t> false_positives {0};
+
+        context (database_type && d, bloom_options const & o)
+            : db(std::move(d))
+            , opts(o)
+        {}
+    };
+
+private:
+    std::unique_ptr<context> _d;
+
+public:
+    bloom_keyvalue_database () = default;
+
+    /**
+     * @throw debby::error() if the filter could not be rebuilt.
+     */
+    bloom_keyvalue_database (database_type && db, bloom_options const & opts = bloom_options{}
+        , error * perr = nullptr)
+        : _d(new context(std::move(db), opts))
+    {
+        if (!_d->opts.path.empty()) {
+            error err;
+            _d->filter = bloom_filter::load(_d->opts.path, & err);
+
+            if (!err) {
+                // Removed until saved, see invalidate()
+                std::error_code ec;
+                pfs::filesystem::remove(_d->opts.path, ec);
+                return;
+            }
+        }
+
+        rebuild(perr);
+    }
+
+    bloom_keyvalue_database (bloom_keyvalue_database && other) = default;
+
+    bloom_keyvalue_database & operator = (bloom_keyvalue_database && other)
+    {
+        if (this != & other) {
+            close();
+            _d = std::move(other._d);
+        }
+
+        return *this;
+    }
+
+    bloom_keyvalue_database (bloom_keyvalue_database const &) = delete;
+    bloom_keyvalue_database & operator = (bloom_keyvalue_database const &) = delete;
+
+    /**
+     * Saves the filter (if `bloom_options::path` is specified). Errors are ignored,
+     * call `save()` before to check them.
+     */
+    ~bloom_keyvalue_database ()
+    {
+        close();
+    }
+
+public:
+    operator bool () const noexcept
+    {
+        return _d != nullptr && _d->db;
+    }
+
+    database_type const & database () const noexcept
+    {
+        return _d->db;
+    }
+
+    bloom_filter const & filter () const noexcept
+    {
+        return _d->filter;
+    }
+
+    bloom_stats stats () const noexcept
+    {
+        bloom_stats result;
+        result.lookups = _d->lookups.load(std::memory_order_relaxed);
+        result.negatives = _d->negatives.load(std::memory_order_relaxed);
+        result.false_positives = _d->false_positives.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void reset_stats () noexcept
+    {
+        _d->lookups.store(0, std::memory_order_relaxed);
+        _d->negatives.store(0, std::memory_order_relaxed);
+        _d->false_positives.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Rebuilds the filter by the key scan, sized for the actual number of keys (but
+     * not less than `bloom_options::expected_keys`).
+     *
+     * @throw debby::error()
+     */
+    bool rebuild (error * perr = nullptr)
+    {
+        std::vector<std::uint64_t> hashes;
+        error err;
+
+        _d->db.for_each_key(key_type{}, [& hashes] (key_type const & key) {
+            hashes.push_back(bloom_filter::hash(key.data(), key.size()));
+            return true;
+        }, & err);
+
+        if (err) {
+            // Pass all keys to the database
+            _d->filter = bloom_filter{};
+            invalidate();
+            pfs::throw_or(perr, std::move(err));
+            return false;
+        }
+
+        bloom_filter filter {(std::max)(hashes.size(), _d->opts.expected_keys), _d->opts.bits_per_key};
+
+        for (auto h: hashes)
+            filter.insert(h);
+
+        _d->filter = std::move(filter);
+        invalidate();
+        return true;
+    }
+
+    /**
+     * Writes the filter into `bloom_options::path` (does nothing if path is empty).
+     *
+     * @throw debby::error()
+     */
+    bool save (error * perr = nullptr)
+    {
+        if (_d->opts.path.empty() || _d->persisted)
+            return true;
+
+        // Not initialized filter (failed rebuild) is not persisted
+        if (_d->filter.block_count() == 0)
+            return true;
+
+        if (!_d->filter.save(_d->opts.path, perr))
+            return false;
+
+        _d->persisted = true;
+        return true;
+    }
+
+    /**
+     * @throw debby::error()
+     */
+    void clear (error * perr = nullptr)
+    {
+        error err;
+        _d->db.clear(& err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return;
+        }
+
+        _d->filter.clear();
+        invalidate();
+    }
+
+    /**
+     * Removes entry associated with @a key (the key stays in the filter).
+     *
+     * @throw debby::error()
+     */
+    void remove (key_type const & key, error * perr = nullptr)
+    {
+        _d->db.remove(key, perr);
+    }
+
+    void remove_many (std::vector<key_type> const & keys, error * perr = nullptr)
+    {
+        _d->db.remove_many(keys, perr);
+    }
+
+    /**
+     * Stores @a value associated with @a key (arithmetic types, strings and types
+     * supported by `keyvalue_database`).
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    void set (key_type const & key, T const & value, error * perr = nullptr)
+    {
+        // The key is added before the write, so the failed write can only make the
+        // filter less selective
+        add_key(key);
+        _d->db.set(key, value, perr);
+    }
+
+    void set (key_type const & key, char const * value, std::size_t len, error * perr = nullptr)
+    {
+        add_key(key);
+        _d->db.set(key, value, len, perr);
+    }
+
+    /**
+     * Reads value associated with @a key. Absent keys are reported with
+     * `errc::key_not_found` mostly without accessing the database.
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    std::decay_t<T> get (key_type const & key, error * perr = nullptr) const
+    {
+        using value_type = std::decay_t<T>;
+
+        _d->lookups.fetch_add(1, std::memory_order_relaxed);
+
+        if (!_d->filter.may_contain(string_view{key})) {
+            _d->negatives.fetch_add(1, std::memory_order_relaxed);
+            pfs::throw_or(perr, error {make_error_code(errc::key_not_found)});
+            return value_type{};
+        }
+
+        error err;
+        auto value = _d->db.template get<value_type>(key, & err);
+
+        if (err) {
+            if (err.code() == make_error_code(errc::key_not_found))
+                _d->false_positives.fetch_add(1, std::memory_order_relaxed);
+
+            pfs::throw_or(perr, std::move(err));
+            return value_type{};
+        }
+
+        return value;
+    }
+
+    template <typename T>
+    T get_or (key_type const & key, T const & default_value, error * perr = nullptr) const
+    {
+        error err;
+        auto result = get<T>(key, & err);
+
+        if (!err)
+            return result;
+
+        if (make_error_code(errc::key_not_found) == err.code())
+            return default_value;
+
+        pfs::throw_or(perr, std::move(err));
+        return default_value;
+    }
+
+private:
+    void add_key (key_type const & key)
+    {
+        invalidate();
+        _d->filter.insert(string_view{key});
+    }
+
+    // Removes outdated filter file
+    void invalidate ()
+    {
+        if (!_d->persisted)
+            return;
+
+        std::error_code ec;
+        pfs::filesystem::remove(_d->opts.path, ec);
+        _d->persisted = false;
+    }
+
+    void close ()
+    {
+        if (_d == nullptr)
+            return;
+
+        error err;
+        save(& err);
+    }
+
+public:
+    template <typename ...Args>
+    static bloom_keyvalue_database make (database_type && db, Args &&... args)
+    {
+        return bloom_keyvalue_database {std::move(db), std::forward<Args>(args)...};
+    }
+};
+
+DEBBY__NAMESPACE_END
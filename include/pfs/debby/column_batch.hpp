@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+enum class column_type
+{
+      int64   // Integer and boolean columns
+    , float64 // Floating point columns
+    , binary  // Text and blob columns (and other ones in text representation)
+};
+
+/**
+ * Column values of the batch in layout compatible with Apache Arrow `Int64`, `Float64` and
+ * `LargeBinary` arrays, so buffers can be consumed (or wrapped) without per-cell conversion.
+ *
+ * @details Only buffers of the column type are filled:
+ *          - `int64_values`/`float64_values` contain one value per row (zero for null);
+ *          - `offsets` contains `row_count + 1` offsets into `data`, value of row `i`
+ *            is `data[offsets[i], offsets[i + 1])` (empty for null).
+ *
+ *          `validity` is the bitmap with one bit per row (least significant bit first),
+ *          the bit is set for non-null values.
+ */
+struct column_buffer
+{
+    std::string name;
+    column_type type {column_type::binary};
+    std::size_t null_count {0};
+    std::vector<std::uint8_t> validity;
+    std::vector<std::int64_t> int64_values;
+    std::vector<double> float64_values;
+    std::vector<std::int64_t> offsets;
+    std::string data;
+
+    bool is_null (std::size_t row) const noexcept
+    {
+        return (validity[row / 8] & (1u << (row % 8))) == 0;
+    }
+
+    // Clears values keeping allocated memory
+    void clear () noexcept
+    {
+        null_count = 0;
+        validity.clear();
+        int64_values.clear();
+        float64_values.clear();
+        offsets.clear();
+        data.clear();
+    }
+};
+
+struct column_batch
+{
+    std::size_t row_count {0};
+    std::vector<column_buffer> columns;
+};
+
+DEBBY__NAMESPACE_END
@@ -1,11 +1,12 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2021.12.14 Initial version.
 //      2025.04.12 Refactored.
+//      2026.10.18 Added `transaction_conflict`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "exports.hpp"
@@ -25,6 +26,7 @@ enum class errc
     , bad_value      // Bad/unsuitable value stored
     , sql_error
     , unsupported
+    , transaction_conflict // Transaction should be restarted (e.g. its snapshot is outdated)
 };
 
 class error_category : public std::error_category
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <chrono>
+#include <cstddef>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Group commit of concurrent writes (single-writer backends, e.g. LMDB/MDBX).
+ *
+ * @details Writers (`set()`, `remove()`) are queued, the first writer in the queue (leader)
+ *          performs writes of the queued writers in single write transaction, commits
+ *          it once and releases all of them.
+ */
+struct group_commit_options
+{
+    // Maximum number of writes committed by single transaction
+    std::size_t max_batch_size {256};
+
+    // Time the leader waits for more writers before the transaction until the batch
+    // is full, zero means the batch contains writers queued at the moment only
+    std::chrono::microseconds max_latency {0};
+};
+
+DEBBY__NAMESPACE_END
@@ -1,10 +1,15 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.04 Initial version.
+//      2026.10.18 Added `flat_hash_map` backend.
+//                 Added `radix_tree` backend.
+//                 Added `arena_options` and `make_kv()` overload with arena.
+//                 Added `save()` and `load()`.
+//                 Added `lru_cache` backend.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -12,6 +17,11 @@
 #include "error.hpp"
 #include "exports.hpp"
 #include "keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 #if DEBBY__MAP_ENABLED
 #   include <map>
@@ -25,12 +35,113 @@ DEBBY__NAMESPACE_BEGIN
 
 namespace in_memory {
 
+/**
+ * Options of the per-database pool arena (`map` and `unordered_map` backends only).
+ * Keys, values and container nodes are allocated from the arena, `clear()` returns
+ * all arena memory at once instead of releasing elements one by one.
+ */
+struct arena_options
+{
+    // Size of the block from which small chunks are carved
+    std::size_t block_size {64 * 1024};
+};
+
+/**
+ * Options of the memory-bounded cache (`lru_cache` backends).
+ */
+struct cache_options
+{
+    // Maximum total charge of entries (key and value sizes plus fixed per-entry overhead)
+    std::size_t capacity {64 * 1024 * 1024};
+
+    // Part of capacity (in percents) for protected segment (entries accessed more than once)
+    unsigned int protected_percent {80};
+
+    // Time to live of new or updated entries, zero means no expiration
+    std::chrono::milliseconds default_ttl {0};
+};
+
+/**
+ * Counters of the memory-bounded cache.
+ */
+struct cache_stats
+{
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+    std::uint64_t evictions {0};
+    std::uint64_t expirations {0};
+    std::size_t count {0}; // Current number of entries
+    std::size_t bytes {0}; // Current total charge of entries
+};
+
 template <backend_enum Backend>
 DEBBY__EXPORT keyvalue_database<Backend> make_kv (error * perr = nullptr);
 
+/**
+ * Makes database with elements allocated from the arena.
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT keyvalue_database<Backend> make_kv (arena_options const & opts, error * perr = nullptr);
+
 template <backend_enum Backend>
 DEBBY__EXPORT bool wipe (error * perr = nullptr);
 
+/**
+ * Makes memory-bounded cache (`lru_cache` backends only).
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT keyvalue_database<Backend> make_kv (cache_options const & opts, error * perr = nullptr);
+
+/**
+ * Returns counters of the memory-bounded cache (`lru_cache` backends only).
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT cache_stats stats (keyvalue_database<Backend> const & db);
+
+/**
+ * Sets time to live for entry associated with @a key of the memory-bounded cache
+ * (`lru_cache` backends only). Zero @a ttl removes expiration. Note that `set()`
+ * resets time to live to `cache_options::default_ttl`.
+ *
+ * @return @c false if there is no such key.
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT bool expire (keyvalue_database<Backend> & db, std::string const & key
+    , std::chrono::milliseconds ttl);
+
+/**
+ * Saves snapshot of the database (`map` and `unordered_map` backends only) into file
+ * specified by @a path. Snapshot is written into temporary file first, which replaces
+ * @a path on success.
+ *
+ * @details Snapshot is a versioned binary image of keys and typed values with payload
+ *          checksum. It is portable between platforms with the same byte order and sizes
+ *          of arithmetic types only.
+ *
+ * @throw debby::error()
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT bool save (keyvalue_database<Backend> const & db, pfs::filesystem::path const & path
+    , error * perr = nullptr);
+
+/**
+ * Loads database from snapshot saved by `save()`. File is memory mapped, validated
+ * and loaded by bulk construction.
+ *
+ * @return Loaded database or invalid (closed) database on error.
+ *
+ * @throw debby::error()
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT keyvalue_database<Backend> load (pfs::filesystem::path const & path, error * perr = nullptr);
+
+/**
+ * Loads database from snapshot with elements allocated from the arena.
+ */
+template <backend_enum Backend>
+DEBBY__EXPORT keyvalue_database<Backend> load (pfs::filesystem::path const & path
+    , arena_options const & opts, error * perr = nullptr);
+
 } // namespace in_memory
 
 #if DEBBY__MAP_ENABLED
@@ -109,4 +220,121 @@ keyvalue_database<backend_enum::unordered_map_mt>::wipe (Args &&... args)
 }
 #endif
 
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::flat_hash_map_st>
+keyvalue_database<backend_enum::flat_hash_map_st>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::flat_hash_map_st> {
+        in_memory::make_kv<backend_enum::flat_hash_map_st>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::flat_hash_map_mt>
+keyvalue_database<backend_enum::flat_hash_map_mt>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::flat_hash_map_mt> {
+        in_memory::make_kv<backend_enum::flat_hash_map_mt>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::flat_hash_map_st>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::flat_hash_map_st>(std::forward<Args>(args)...);
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::flat_hash_map_mt>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::flat_hash_map_mt>(std::forward<Args>(args)...);
+}
+#endif
+
+
+#if DEBBY__RADIX_TREE_ENABLED
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::radix_tree_st>
+keyvalue_database<backend_enum::radix_tree_st>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::radix_tree_st> {
+        in_memory::make_kv<backend_enum::radix_tree_st>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::radix_tree_mt>
+keyvalue_database<backend_enum::radix_tree_mt>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::radix_tree_mt> {
+        in_memory::make_kv<backend_enum::radix_tree_mt>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::radix_tree_st>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::radix_tree_st>(std::forward<Args>(args)...);
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::radix_tree_mt>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::radix_tree_mt>(std::forward<Args>(args)...);
+}
+#endif
+
+
+#if DEBBY__LRU_CACHE_ENABLED
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::lru_cache_st>
+keyvalue_database<backend_enum::lru_cache_st>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::lru_cache_st> {
+        in_memory::make_kv<backend_enum::lru_cache_st>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+keyvalue_database<backend_enum::lru_cache_mt>
+keyvalue_database<backend_enum::lru_cache_mt>::make (Args &&... args)
+{
+    return keyvalue_database<backend_enum::lru_cache_mt> {
+        in_memory::make_kv<backend_enum::lru_cache_mt>(std::forward<Args>(args)...)
+    };
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::lru_cache_st>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::lru_cache_st>(std::forward<Args>(args)...);
+}
+
+template <>
+template <typename ...Args>
+bool
+keyvalue_database<backend_enum::lru_cache_mt>::wipe (Args &&... args)
+{
+    return in_memory::wipe<backend_enum::lru_cache_mt>(std::forward<Args>(args)...);
+}
+#endif
+
 DEBBY__NAMESPACE_END
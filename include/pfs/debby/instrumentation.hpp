@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "backend_enum.hpp"
+#include "exports.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Optional per-operation metrics (counts, bytes and latency histograms).
+ *
+ * Recording is compiled in only when the library is built with
+ * `DEBBY__ENABLE_INSTRUMENTATION` (defines `DEBBY__INSTRUMENTATION_ENABLED`),
+ * otherwise `snapshot()` always returns an empty list.
+ *
+ * Each thread records into its own buckets without locking, so `snapshot()`
+ * may observe counters of concurrently running operations slightly skewed.
+ */
+namespace instrumentation {
+
+enum class operation_enum
+{
+      kv_set = 0   // keyvalue_database::set()
+    , kv_get       // keyvalue_database::get()
+    , kv_remove    // keyvalue_database::remove()
+    , stmt_exec    // statement::exec()
+    , result_next  // result::next()
+};
+
+/**
+ * Log-linear (HDR-style) latency histogram in nanoseconds. Values less than 8
+ * are counted exactly, larger values fall into one of 8 sub-buckets per power
+ * of two, so relative error of any reported value is less than 12.5%.
+ */
+struct histogram
+{
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    std::array<std::uint64_t, BUCKET_COUNT> buckets {};
+    std::uint64_t count {0};
+    std::uint64_t sum {0}; // Total nanoseconds
+
+    DEBBY__EXPORT static std::size_t bucket_index (std::uint64_t value) noexcept;
+
+    /**
+     * Largest value counted by bucket with @a index.
+     */
+    DEBBY__EXPORT static std::uint64_t bucket_upper_bound (std::size_t index) noexcept;
+
+    /**
+     * Returns value (upper bound of bucket) at quantile @a q (0.0 ... 1.0).
+     */
+    DEBBY__EXPORT std::uint64_t percentile (double q) const noexcept;
+
+    std::uint64_t max () const noexcept
+    {
+        return percentile(1.0);
+    }
+
+    double mean () const noexcept
+    {
+        return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+    }
+};
+
+struct metric
+{
+    backend_enum backend;
+    operation_enum operation;
+
+    // SQL fingerprint (hash of normalized SQL) for statement/result operations,
+    // zero for key-value operations.
+    std::uint64_t fingerprint {0};
+
+    // Normalized SQL associated with fingerprint.
+    std::string sql;
+
+    // Value bytes written/read for key-value operations, zero otherwise.
+    std::uint64_t bytes {0};
+
+    histogram latency;
+};
+
+/**
+ * Checks if instrumentation is compiled in.
+ */
+DEBBY__EXPORT bool enabled () noexcept;
+
+/**
+ * Collects metrics from all threads since start or last call to reset().
+ */
+DEBBY__EXPORT std::vector<metric> snapshot ();
+
+/**
+ * Resets all metrics.
+ */
+DEBBY__EXPORT void reset ();
+
+/**
+ * Normalizes @a sql: literals and placeholders are replaced by `?`,
+ * value lists collapsed to single `?`, whitespaces collapsed, comments removed
+ * and text outside quoted identifiers lowercased.
+ */
+DEBBY__EXPORT std::string normalize_sql (std::string const & sql);
+
+/**
+ * Calculates fingerprint of @a sql (non-zero hash of normalized SQL).
+ */
+DEBBY__EXPORT std::uint64_t fingerprint (std::string const & sql);
+
+DEBBY__EXPORT char const * to_string (backend_enum backend) noexcept;
+DEBBY__EXPORT char const * to_string (operation_enum op) noexcept;
+
+/**
+ * Exports @a metrics in Prometheus text exposition format.
+ */
+DEBBY__EXPORT std::string to_prometheus (std::vector<metric> const & metrics);
+
+} // namespace instrumentation
+
+DEBBY__NAMESPACE_END
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -10,6 +10,11 @@
 //      2024.11.04 V2 started.
 //      2025.09.29 Changed set/get implementation.
 //                 Added support for custom types.
+//      2026.10.18 Added `remove_many()`.
+//                 Added `for_each_key()`.
+//                 Added `backend_impl()`.
+//                 Added `increment()` and `append()`.
+//                 Added `write_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -21,9 +26,11 @@
 #include "pfs/string_view.hpp"
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -60,6 +67,20 @@ public:
         return _d != nullptr;
     }
 
+    /**
+     * Returns backend implementation (opaque outside the library, used by backend
+     * specific utilities).
+     */
+    impl * backend_impl () noexcept
+    {
+        return _d.get();
+    }
+
+    impl const * backend_impl () const noexcept
+    {
+        return _d.get();
+    }
+
     /**
      * Clear all records from @a table.
      */
@@ -72,6 +93,78 @@ public:
      */
     DEBBY__EXPORT void remove (key_type const & key, error * perr = nullptr);
 
+    /**
+     * Removes entries associated with @a keys from database. Missing keys
+     * are ignored.
+     *
+     * @throw debby::error()
+     */
+    DEBBY__EXPORT void remove_many (std::vector<key_type> const & keys, error * perr = nullptr);
+
+    /**
+     * Performs writes (`set()`, `remove()`, `increment()`, `append()`) made by @a f on
+     * the calling thread as single batch committed once.
+     *
+     * @details Relational backends (`sqlite3`, `psql`) perform @a f inside transaction
+     *          (nested one if called inside another, so it can be discarded alone), LMDB
+     *          and MDBX inside single write transaction (reads inside @a f see the batch
+     *          writes, writers of other threads wait for the batch), RocksDB collects
+     *          writes into `WriteBatch` (reads inside @a f do not see them). Nested call
+     *          of non-relational backends is part of the outer batch. In-memory backends
+     *          apply writes immediately. If @a f throws, the batch is discarded and
+     *          the exception is rethrown.
+     *
+     * @throw debby::error() if the batch could not be started or committed.
+     */
+    DEBBY__EXPORT void write_batch (std::function<void ()> const & f, error * perr = nullptr);
+
+    /**
+     * Calls @a f for each key starting with @a prefix (all keys if @a prefix is empty)
+     * until @a f returns @c false.
+     *
+     * @details Keys are visited in byte-wise order by ordered backends (`map`, `radix_tree`,
+     *          `sqlite3`, `psql`, `lmdb`, `mdbx`, `rocksdb`) and in unspecified order by
+     *          hash based ones. @a f is called while in-memory database is locked or inside
+     *          read transaction, so it must not modify the database.
+     *
+     * @throw debby::error()
+     */
+    DEBBY__EXPORT void for_each_key (key_type const & prefix
+        , std::function<bool (key_type const &)> const & f, error * perr = nullptr) const;
+
+    /**
+     * Adds @a delta to the counter associated with @a key as single atomic operation
+     * (missing key is treated as zero counter).
+     *
+     * @details Counter is `std::int64_t` value (see `get<std::int64_t>()`), overflow
+     *          wraps around. RocksDB applies the operation as blind merge (operand
+     *          resolved on read or compaction), so value which is not a counter is
+     *          treated as zero counter and replaced (see `rocksdb::checked_increment()`
+     *          for the checked variant). Other backends read and write the value inside
+     *          single write transaction (in-memory ones under lock).
+     *
+     * @throw debby::error{errc::bad_value} if value associated with @a key is not
+     *        a counter (except RocksDB).
+     */
+    DEBBY__EXPORT void increment (key_type const & key, std::int64_t delta = 1, error * perr = nullptr);
+
+    /**
+     * Appends character sequence @a data with length @a len to the string associated
+     * with @a key as single atomic operation (missing key is treated as empty string).
+     *
+     * @details See `increment()` for implementation details.
+     *
+     * @throw debby::error{errc::bad_value} if value associated with @a key is not
+     *        a string (in-memory backends only, other ones store raw bytes).
+     */
+    DEBBY__EXPORT void append (key_type const & key, char const * data, std::size_t len
+        , error * perr = nullptr);
+
+    void append (key_type const & key, string_view data, error * perr = nullptr)
+    {
+        append(key, data.data(), data.size(), perr);
+    }
+
     /**
      * Stores character sequence @a value with length @a len associated
      * with @a key into database.
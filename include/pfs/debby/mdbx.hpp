@@ -1,15 +1,17 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.10 Initial version.
+//      2026.10.18 Added group commit.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
 #include "error.hpp"
 #include "exports.hpp"
+#include "group_commit.hpp"
 #include "keyvalue_database.hpp"
 #include <pfs/filesystem.hpp>
 #include <cstdint>
@@ -40,6 +42,20 @@ DEBBY__EXPORT
 keyvalue_database<backend_enum::mdbx>
 make_kv (pfs::filesystem::path const & path, bool create_if_missing, error * perr = nullptr);
 
+/**
+ * Open database with group commit of concurrent `set()` and `remove()` calls (see
+ * `group_commit_options`).
+ */
+DEBBY__EXPORT
+keyvalue_database<backend_enum::mdbx>
+make_kv (pfs::filesystem::path const & path, options_type opts, bool create_if_missing
+    , group_commit_options const & gc, error * perr = nullptr);
+
+DEBBY__EXPORT
+keyvalue_database<backend_enum::mdbx>
+make_kv (pfs::filesystem::path const & path, bool create_if_missing, group_commit_options const & gc
+    , error * perr = nullptr);
+
 DEBBY__EXPORT bool wipe (pfs::filesystem::path const & path, error * perr = nullptr);
 
 } // namespace mdbx
@@ -1,10 +1,11 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.02 Initial version.
+//      2026.10.18 Added `put_many()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "error.hpp"
@@ -12,6 +13,9 @@
 #include "namespace.hpp"
 #include "keyvalue_database.hpp"
 #include "relational_database.hpp"
+#include <string>
+#include <utility>
+#include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -96,6 +100,33 @@ make_kv (ForwardIt first, ForwardIt last, std::string const & table_name, error
     return make_kv(conninfo, table_name, perr);
 }
 
+/**
+ * Stores @a values associated with @a keys by single statement (keys and values are
+ * passed as two array parameters), the last value wins for duplicate keys.
+ *
+ * @throw debby::error{errc::bad_value} if number of keys and values is different.
+ * @throw debby::error{errc::backend_error} on failure, nothing is stored in this case.
+ */
+DEBBY__EXPORT
+void put_many (keyvalue_database<backend_enum::psql> & db, std::vector<std::string> const & keys
+    , std::vector<std::string> const & values, error * perr = nullptr);
+
+inline void put_many (keyvalue_database<backend_enum::psql> & db
+    , std::vector<std::pair<std::string, std::string>> const & items, error * perr = nullptr)
+{
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    keys.reserve(items.size());
+    values.reserve(items.size());
+
+    for (auto const & item: items) {
+        keys.push_back(item.first);
+        values.push_back(item.second);
+    }
+
+    put_many(db, keys, values, perr);
+}
+
 } // namespace psql
 
 template<>
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -8,6 +8,12 @@
 //      2021.12.18 Reimplemented with new error handling.
 //      2022.03.12 Refactored.
 //      2024.10.29 V2 started.
+//      2026.10.18 Added slow-query log.
+//                 Added nested transactions (savepoints) and transaction modes.
+//                 Added `transaction_guard`.
+//                 Outermost transaction body is restarted on transaction conflict.
+//                 Added `backend_impl()`.
+//                 `transaction_guard` stays active if commit leaves transaction open.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "backend_enum.hpp"
@@ -15,14 +21,33 @@
 #include "exports.hpp"
 #include "namespace.hpp"
 #include "result.hpp"
+#include "slow_query_log.hpp"
 #include "statement.hpp"
 #include <pfs/optional.hpp>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
+/**
+ * Mode of the outermost transaction. SQLite supports `standard` (same as `deferred`),
+ * `deferred`, `immediate` and `exclusive` locking modes, PostgreSQL supports `standard`
+ * (server default isolation level), `read_committed`, `repeatable_read` and `serializable`
+ * isolation levels.
+ */
+enum class transaction_mode
+{
+      standard
+    , deferred
+    , immediate
+    , exclusive
+    , read_committed
+    , repeatable_read
+    , serializable
+};
+
 template <backend_enum Backend>
 class relational_database
 {
@@ -118,20 +143,63 @@ public:
     DEBBY__EXPORT void remove_all (error * perr = nullptr);
 
     /**
-     * Begin transaction.
+     * Enables slow-query log: queries executed longer than @a opts.threshold are recorded
+     * into bounded ring buffer. Previous records are discarded.
+     */
+    DEBBY__EXPORT void enable_slow_query_log (slow_query_options opts);
+
+    /**
+     * Disables slow-query log. Records collected are kept.
+     */
+    DEBBY__EXPORT void disable_slow_query_log ();
+
+    /**
+     * Returns slow-query records from the oldest to the newest.
+     */
+    DEBBY__EXPORT std::vector<slow_query_record> slow_queries () const;
+
+    /**
+     * Discards slow-query records.
+     */
+    DEBBY__EXPORT void clear_slow_queries ();
+
+    /**
+     * Begin transaction in `transaction_mode::standard` mode.
      */
     DEBBY__EXPORT void begin (error * perr = nullptr);
 
     /**
-     * Commit transaction.
+     * Begin transaction in @a mode. Transaction started inside another one is a nested
+     * transaction implemented by savepoint (@a mode is ignored, it is defined by the
+     * outermost transaction), so it can be committed or rolled back independently
+     * without affecting the enclosing transaction.
+     *
+     * @throw debby::error{errc::unsupported} if @a mode is not supported by the backend.
+     */
+    DEBBY__EXPORT void begin (transaction_mode mode, error * perr = nullptr);
+
+    /**
+     * Commit transaction (releases savepoint for nested transaction).
      */
     DEBBY__EXPORT void commit (error * perr = nullptr);
 
     /**
-     * Rollback transaction.
+     * Rollback transaction (rolls back to savepoint for nested transaction).
      */
     DEBBY__EXPORT void rollback (error * perr = nullptr);
 
+    /**
+     * Rolls back nested transactions and the outermost one (if @a depth is zero) until
+     * transaction nesting level becomes equal to @a depth.
+     */
+    DEBBY__EXPORT void rollback_to (int depth, error * perr = nullptr);
+
+    /**
+     * Returns transaction nesting level (zero if there is no transaction started by
+     * `begin()`).
+     */
+    DEBBY__EXPORT int transaction_depth () const noexcept;
+
     /**
      * Checks if named table exists in database.
      */
@@ -147,24 +215,82 @@ public:
     template <typename TransactionBody>
     pfs::optional<std::string> transaction (TransactionBody && func)
     {
-        error err;
-        begin(& err);
+        return transaction(transaction_mode::standard, std::forward<TransactionBody>(func));
+    }
 
-        if (err)
-            return pfs::make_optional(std::string{err.what()});
+    /**
+     * Do transaction in @a mode with body representing by @a func() (nested transaction
+     * if called inside another one, see `begin()`).
+     *
+     * @details If the outermost transaction fails with `errc::transaction_conflict`
+     *          (e.g. SQLite snapshot is outdated in WAL mode), it is rolled back and
+     *          @a func() is called again in a new transaction (up to the backend specific
+     *          number of retries), so @a func() must not have side effects outside
+     *          the database. On any other exception the transaction (with nested
+     *          transactions left by @a func()) is rolled back and the exception is rethrown.
+     */
+    template <typename TransactionBody>
+    pfs::optional<std::string> transaction (transaction_mode mode, TransactionBody && func)
+    {
+        auto depth = transaction_depth();
+        bool outermost = depth == 0;
+
+        for (int attempt = 0;; attempt++) {
+            error err;
+            begin(mode, & err);
+
+            if (err)
+                return pfs::make_optional(std::string{err.what()});
+
+            pfs::optional<std::string> failure;
+
+            try {
+                failure = func();
 
-        auto failure = func();
+                if (!failure) {
+                    commit(); // An exception should be thrown on error (inconsistency may occur)
+                    return pfs::nullopt;
+                }
+            } catch (error const & ex) {
+                if (outermost && restart_transaction(ex, attempt))
+                    continue;
+
+                error ignored;
+                rollback_to(depth, & ignored);
+                throw;
+            } catch (...) {
+                error ignored;
+                rollback_to(depth, & ignored);
+                throw;
+            }
 
-        if (failure) {
             rollback(); // An exception should be thrown on error (inconsistency may occur)
             return failure;
-        } else {
-            commit(); // An exception should be thrown on error (inconsistency may occur)
         }
+    }
+
+    /**
+     * Returns backend implementation (opaque outside the library, used by backend
+     * specific utilities).
+     */
+    impl * backend_impl () noexcept
+    {
+        return _d.get();
+    }
 
-        return pfs::nullopt;
+    impl const * backend_impl () const noexcept
+    {
+        return _d.get();
     }
 
+private:
+    /**
+     * Rolls back the outermost transaction failed with @a err if it can be restarted.
+     *
+     * @return @c true if the transaction should be restarted.
+     */
+    DEBBY__EXPORT bool restart_transaction (error const & err, int attempt);
+
 public:
     /**
      * See description for backend specific make() functions.
@@ -179,4 +305,108 @@ public:
     static bool wipe (Args &&... args);
 };
 
+/**
+ * Transaction (or nested transaction) rolled back on destruction unless committed.
+ *
+ * @code
+ * transaction_guard<backend_enum::sqlite3> tx {db, transaction_mode::immediate};
+ * ...
+ * tx.commit();
+ * @endcode
+ */
+template <backend_enum Backend>
+class transaction_guard
+{
+private:
+    relational_database<Backend> * _db {nullptr};
+    int _depth {0}; // Depth of the guarded transaction
+
+public:
+    /**
+     * @throw debby::error() if the transaction could not be started (the guard is
+     *        inactive in this case if @a perr is not null).
+     */
+    explicit transaction_guard (relational_database<Backend> & db
+        , transaction_mode mode = transaction_mode::standard, error * perr = nullptr)
+    {
+        error err;
+        db.begin(mode, & err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return;
+        }
+
+        _db = & db;
+        _depth = db.transaction_depth();
+    }
+
+    transaction_guard (transaction_guard && other) noexcept
+        : _db(other._db)
+        , _depth(other._depth)
+    {
+        other._db = nullptr;
+    }
+
+    transaction_guard (transaction_guard const &) = delete;
+    transaction_guard & operator = (transaction_guard const &) = delete;
+    transaction_guard & operator = (transaction_guard &&) = delete;
+
+    /**
+     * Rolls back the transaction (and transactions nested into it) if it is still
+     * active, errors are ignored.
+     */
+    ~transaction_guard ()
+    {
+        if (_db != nullptr) {
+            error err;
+            _db->rollback_to(_depth - 1, & err);
+        }
+    }
+
+public:
+    bool active () const noexcept
+    {
+        return _db != nullptr;
+    }
+
+    explicit operator bool () const noexcept
+    {
+        return _db != nullptr;
+    }
+
+    /**
+     * Commits the transaction. The guard stays active if the transaction is still open
+     * after failure (e.g. database is busy), so commit can be retried, otherwise the
+     * transaction is rolled back on destruction.
+     */
+    void commit (error * perr = nullptr)
+    {
+        if (_db == nullptr)
+            return;
+
+        error err;
+        _db->commit(& err);
+
+        if (!err || _db->transaction_depth() < _depth)
+            _db = nullptr;
+
+        if (err)
+            pfs::throw_or(perr, std::move(err));
+    }
+
+    /**
+     * Rolls back the transaction, the guard becomes inactive even on failure.
+     */
+    void rollback (error * perr = nullptr)
+    {
+        if (_db == nullptr)
+            return;
+
+        auto db = _db;
+        _db = nullptr;
+        db->rollback(perr);
+    }
+};
+
 DEBBY__NAMESPACE_END
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -10,17 +10,24 @@
 //      2024.10.30 Fixed API.
 //      2025.09.30 Changed get implementation.
 //                 Added support for custom types.
+//      2026.10.18 Added column handle.
+//                 Added `fetch_columns()`.
+//                 Added range-for iteration over rows.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "affinity_traits.hpp"
 #include "namespace.hpp"
 #include "backend_enum.hpp"
+#include "column_batch.hpp"
 #include "error.hpp"
 #include "exports.hpp"
 #include <pfs/endian.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/optional.hpp>
+#include <pfs/string_view.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <type_traits>
 #include <string>
 
@@ -32,6 +39,150 @@ class result
 public:
     class impl;
 
+    /**
+     * Column resolved by name once (see `column()`) and reused to read values from
+     * each row without name lookup.
+     */
+    class column_handle
+    {
+        friend class result;
+
+    private:
+        int _index {0};
+
+    private:
+        explicit column_handle (int index) noexcept : _index(index) {}
+
+    public:
+        column_handle () = default;
+
+        /**
+         * Returns column index (starting from 1) or 0 if the handle is invalid.
+         */
+        int index () const noexcept
+        {
+            return _index;
+        }
+
+        explicit operator bool () const noexcept
+        {
+            return _index > 0;
+        }
+    };
+
+    class iterator;
+
+    /**
+     * Current row of the result (see range-for iteration). Accessors do not check
+     * the column index and return default value (zero or empty view) for nulls and
+     * unsuitable values. Views returned by `text()` and `blob()` are valid until the
+     * result steps to the next row.
+     *
+     * @note Numeration of columns starts from 1.
+     */
+    class row_view
+    {
+        friend class iterator;
+
+    private:
+        result const * _r {nullptr};
+
+    private:
+        explicit row_view (result const * r) noexcept : _r(r) {}
+
+    public:
+        DEBBY__EXPORT bool is_null (int column) const noexcept;
+        DEBBY__EXPORT std::int64_t get_int64 (int column) const noexcept;
+        DEBBY__EXPORT double get_double (int column) const noexcept;
+
+        /**
+         * Returns value in text representation as stored by the backend.
+         */
+        DEBBY__EXPORT pfs::string_view text (int column) const noexcept;
+
+        /**
+         * Returns value as raw bytes (decoded from hex representation for psql `BYTEA`).
+         */
+        DEBBY__EXPORT pfs::string_view blob (int column) const noexcept;
+
+        template <typename T>
+        std::enable_if_t<std::is_integral<T>::value, T> get (int column) const noexcept
+        {
+            return static_cast<T>(get_int64(column));
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_floating_point<T>::value, T> get (int column) const noexcept
+        {
+            return static_cast<T>(get_double(column));
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_same<T, pfs::string_view>::value, T> get (int column) const noexcept
+        {
+            return blob(column);
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_same<T, std::string>::value, T> get (int column) const
+        {
+            auto v = blob(column);
+            return std::string(v.data(), v.size());
+        }
+    };
+
+    /**
+     * Input iterator over rows, incrementing steps the result to the next row.
+     */
+    class iterator
+    {
+        friend class result;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = row_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = row_view const *;
+        using reference = row_view;
+
+    private:
+        result * _r {nullptr}; // nullptr for end iterator
+
+    private:
+        explicit iterator (result * r) noexcept : _r(r) {}
+
+    public:
+        iterator () = default;
+
+        row_view operator * () const noexcept
+        {
+            return row_view{_r};
+        }
+
+        /**
+         * @throw debby::error() on stepping failure.
+         */
+        iterator & operator ++ ()
+        {
+            _r->next();
+
+            if (!_r->has_more())
+                _r = nullptr;
+
+            return *this;
+        }
+
+        bool operator == (iterator const & other) const noexcept
+        {
+            return _r == other._r;
+        }
+
+        bool operator != (iterator const & other) const noexcept
+        {
+            return _r != other._r;
+        }
+    };
+
 private:
     impl * _d {nullptr};
 
@@ -79,11 +230,56 @@ public:
      */
     DEBBY__EXPORT std::string column_name (int column) const noexcept;
 
+    /**
+     * Returns handle of the column named @a name.
+     *
+     * @throw debby::error{errc::column_not_found} if there is no such column (invalid
+     *        handle is returned in this case if @a perr is not null).
+     */
+    DEBBY__EXPORT column_handle column (std::string const & name, error * perr = nullptr) const;
+
     /**
      * Steps to next record.
      */
     DEBBY__EXPORT void next ();
 
+    /**
+     * Reads up to @a batch_size rows starting from the current one into column buffers
+     * of @a batch (memory allocated by the previous batch is reused) and steps past them.
+     *
+     * @details Column type is determined by the column type reported by the backend
+     *          (by the declared type or the first row's value for SQLite, which converts
+     *          values of other storage classes by its own rules). Blobs stored by psql are
+     *          decoded from the hex representation.
+     *
+     * @return Number of rows read (zero if there are no more rows).
+     *
+     * @throw debby::error{errc::bad_value} if a value could not be parsed.
+     * @throw debby::error{errc::sql_error} on stepping failure (SQLite).
+     */
+    DEBBY__EXPORT std::size_t fetch_columns (column_batch & batch, std::size_t batch_size
+        , error * perr = nullptr);
+
+    column_batch fetch_columns (std::size_t batch_size, error * perr = nullptr)
+    {
+        column_batch batch;
+        fetch_columns(batch, batch_size, perr);
+        return batch;
+    }
+
+    /**
+     * Range-for iteration over remaining rows: `for (auto row: res) {...}`.
+     */
+    iterator begin ()
+    {
+        return iterator{has_more() ? this : nullptr};
+    }
+
+    iterator end () noexcept
+    {
+        return iterator{};
+    }
+
     /**
      * @return Column content or @c nullopt if column contains null value.
      *
@@ -137,6 +333,15 @@ public:
         return value_type_affinity<std::decay_t<T>>::cast(*affinity_value_opt, perr);
     }
 
+    /**
+     * @return Column content or @c nullopt if column contains null value.
+     */
+    template <typename T>
+    pfs::optional<std::decay_t<T>> get (column_handle const & column, error * perr = nullptr) const
+    {
+        return this->template get<T>(column.index(), perr);
+    }
+
     /**
      * @return Column content or @a default_value if column contains null value.
      */
@@ -1,10 +1,14 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.10 Initial version.
+//      2026.10.18 Added `read_options`, `get()`, `multi_get()` and `for_each_key()`.
+//                 Added `bulk_loader`.
+//                 Added statistics, properties and perf context API.
+//                 Added `checked_increment()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -12,6 +16,15 @@
 #include "exports.hpp"
 #include "keyvalue_database.hpp"
 #include <pfs/filesystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -22,6 +35,7 @@ namespace rocksdb {
         bool optimize {true};  // IncreaseParallelism and OptimizeLevelStyleCompaction
         bool small_db {false}; // like under 1GB
         int keep_log_file_num {10};
+        bool statistics {false}; // Collect statistics (CreateDBStatistics), see `statistics()`
     };
 
     /**
@@ -41,6 +55,295 @@ namespace rocksdb {
     make_kv (pfs::filesystem::path const & path, bool create_if_missing, error * perr = nullptr);
 
     DEBBY__EXPORT bool wipe (pfs::filesystem::path const & path, error * perr = nullptr);
+
+    /**
+     * Per-call read options (RocksDB `ReadOptions` subset).
+     */
+    struct read_options
+    {
+        // Cache blocks read by the call, disable for bulk scans to keep the block
+        // cache for the hot data
+        bool fill_cache {true};
+
+        // Verify checksums of the blocks read
+        bool verify_checksums {true};
+
+        // Readahead size for iteration in bytes (0 - automatic readahead)
+        std::size_t readahead_size {0};
+    };
+
+    /**
+     * Reads value associated with @a key using @a opts (see `keyvalue_database::get()`).
+     *
+     * @throw debby::error().
+     */
+    template <typename T>
+    DEBBY__EXPORT T get (keyvalue_database<backend_enum::rocksdb> const & db
+        , std::string const & key, read_options const & opts, error * perr = nullptr);
+
+    /**
+     * Reads values associated with @a keys by batched lookups (`MultiGet`), missing keys
+     * are substituted by @a default_value.
+     *
+     * @return Values in order of @a keys.
+     *
+     * @throw debby::error().
+     */
+    template <typename T>
+    DEBBY__EXPORT std::vector<T> multi_get (keyvalue_database<backend_enum::rocksdb> const & db
+        , std::vector<std::string> const & keys, T const & default_value
+        , read_options const & opts = read_options{}, error * perr = nullptr);
+
+    /**
+     * Calls @a f for each key starting with @a prefix in key order until @a f returns
+     * @c false, using @a opts for iteration.
+     *
+     * @throw debby::error().
+     */
+    DEBBY__EXPORT void for_each_key (keyvalue_database<backend_enum::rocksdb> const & db
+        , std::string const & prefix, std::function<bool (std::string const &)> const & f
+        , read_options const & opts, error * perr = nullptr);
+
+    /**
+     * Adds @a delta to the counter associated with @a key like `keyvalue_database::increment()`,
+     * but checks the stored value before the merge (read before write).
+     *
+     * @note Value replaced by non-counter between the check and the merge is treated
+     *       as zero counter.
+     *
+     * @throw debby::error{errc::bad_value} if value associated with @a key is not
+     *        a counter.
+     */
+    DEBBY__EXPORT void checked_increment (keyvalue_database<backend_enum::rocksdb> & db
+        , std::string const & key, std::int64_t delta = 1, error * perr = nullptr);
+
+    struct bulk_load_options
+    {
+        // Input is added in strictly ascending byte-wise key order, otherwise it is
+        // sorted by the loader
+        bool sorted {false};
+
+        // Size of the input buffered in memory by chunk in bytes. Each chunk is written
+        // into its own SST file by the worker thread (unsorted chunks are sorted before).
+        std::size_t chunk_size {64 * 1024 * 1024};
+
+        // Target size of SST files produced by merging of sorted chunks (unsorted
+        // input only)
+        std::size_t target_file_size {256 * 1024 * 1024};
+
+        // Number of threads writing chunks (0 - hardware concurrency). Up to this number
+        // of chunks is kept in memory at once.
+        unsigned int threads {0};
+
+        // Directory for temporary SST files, must be on the same file system as the
+        // database so files are moved into it (default is the database directory)
+        pfs::filesystem::path work_dir;
+    };
+
+    /**
+     * Loads key-value pairs into database bypassing memtable and WAL: input is written
+     * into SST files (`SstFileWriter`) ingested into the database by `finish()`
+     * (`IngestExternalFile`).
+     *
+     * @details Sorted input is split into chunks written in parallel into non-overlapping
+     *          files. Unsorted input is sorted externally: chunks are sorted and written
+     *          in parallel as temporary runs merged into non-overlapping files by
+     *          `finish()`. For duplicate keys the value added last wins.
+     *
+     *          Values are stored the same way as by `keyvalue_database::set()`. Loaded
+     *          values replace stored ones for the same keys.
+     *
+     * @note Loader is not thread safe.
+     */
+    class bulk_loader
+    {
+    public:
+        class impl;
+
+    private:
+        std::unique_ptr<impl> _d;
+
+    public:
+        /**
+         * @throw debby::error() if temporary directory could not be created.
+         */
+        DEBBY__EXPORT bulk_loader (keyvalue_database<backend_enum::rocksdb> & db
+            , bulk_load_options const & opts = bulk_load_options{}, error * perr = nullptr);
+
+        DEBBY__EXPORT bulk_loader (bulk_loader && other) noexcept;
+        DEBBY__EXPORT bulk_loader & operator = (bulk_loader && other) noexcept;
+
+        /**
+         * Discards the input not ingested by `finish()`.
+         */
+        DEBBY__EXPORT ~bulk_loader ();
+
+        bulk_loader (bulk_loader const &) = delete;
+        bulk_loader & operator = (bulk_loader const &) = delete;
+
+    public:
+        /**
+         * Adds character sequence @a data with length @a len associated with @a key.
+         *
+         * @throw debby::error{errc::bad_value} if input declared sorted is not sorted.
+         * @throw debby::error{errc::backend_error} on SST file write failure.
+         */
+        DEBBY__EXPORT bool add (std::string const & key, char const * data, std::size_t len
+            , error * perr = nullptr);
+
+        bool add (std::string const & key, std::string const & value, error * perr = nullptr)
+        {
+            return add(key, value.data(), value.size(), perr);
+        }
+
+        bool add (std::string const & key, char const * value, error * perr = nullptr)
+        {
+            return add(key, value, std::strlen(value), perr);
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_arithmetic<T>::value, bool>
+        add (std::string const & key, T value, error * perr = nullptr)
+        {
+            char buf[sizeof(T)];
+            std::memcpy(buf, & value, sizeof(T));
+            return add(key, buf, sizeof(T), perr);
+        }
+
+        /**
+         * Writes the rest of the input and ingests all files into database. The loader
+         * can not be used after.
+         *
+         * @throw debby::error{errc::backend_error}.
+         */
+        DEBBY__EXPORT bool finish (error * perr = nullptr);
+
+        /**
+         * Number of added key-value pairs.
+         */
+        DEBBY__EXPORT std::size_t count () const noexcept;
+    };
+
+    struct histogram_stats
+    {
+        std::uint64_t count {0};
+        std::uint64_t sum {0};
+        double average {0};
+        double median {0};
+        double p95 {0};
+        double p99 {0};
+        double max {0};
+    };
+
+    struct db_statistics
+    {
+        // Frequently used tickers
+        std::uint64_t block_cache_hit {0};
+        std::uint64_t block_cache_miss {0};
+        std::uint64_t bloom_filter_useful {0}; // Reads avoided by bloom filters
+        std::uint64_t stall_micros {0};        // Time writes were stalled
+        std::uint64_t compact_read_bytes {0};
+        std::uint64_t compact_write_bytes {0};
+
+        // All tickers and histograms by RocksDB names (i.e. "rocksdb.block.cache.hit",
+        // "rocksdb.db.get.micros")
+        std::map<std::string, std::uint64_t> tickers;
+        std::map<std::string, histogram_stats> histograms;
+
+        double block_cache_hit_rate () const noexcept
+        {
+            auto total = block_cache_hit + block_cache_miss;
+            return total == 0 ? 0.0 : static_cast<double>(block_cache_hit) / static_cast<double>(total);
+        }
+    };
+
+    /**
+     * Returns statistics collected since the database was open or since
+     * `reset_statistics()`.
+     *
+     * @throw debby::error{errc::unsupported} if the database is open without
+     *        `options_type::statistics`.
+     */
+    DEBBY__EXPORT db_statistics statistics (keyvalue_database<backend_enum::rocksdb> const & db
+        , error * perr = nullptr);
+
+    DEBBY__EXPORT void reset_statistics (keyvalue_database<backend_enum::rocksdb> & db
+        , error * perr = nullptr);
+
+    /**
+     * Returns value of the property @a name of the debby column family (i.e. "rocksdb.stats",
+     * "rocksdb.levelstats").
+     *
+     * @throw debby::error{errc::key_not_found} if the property is unknown.
+     */
+    DEBBY__EXPORT std::string property (keyvalue_database<backend_enum::rocksdb> const & db
+        , std::string const & name, error * perr = nullptr);
+
+    /**
+     * Returns value of the integer property @a name of the debby column family (i.e.
+     * "rocksdb.estimate-num-keys", "rocksdb.cur-size-all-mem-tables",
+     * "rocksdb.size-all-mem-tables", "rocksdb.estimate-pending-compaction-bytes").
+     *
+     * @throw debby::error{errc::key_not_found} if the property is unknown.
+     */
+    DEBBY__EXPORT std::uint64_t int_property (keyvalue_database<backend_enum::rocksdb> const & db
+        , std::string const & name, error * perr = nullptr);
+
+    enum class perf_level
+    {
+          count        // Counters only
+        , count_time   // Counters and timers (except mutex timers)
+    };
+
+    /**
+     * Subset of RocksDB `PerfContext` counters, times are in nanoseconds.
+     */
+    struct perf_counters
+    {
+        std::uint64_t user_key_comparison_count {0};
+        std::uint64_t block_cache_hit_count {0};
+        std::uint64_t block_read_count {0};
+        std::uint64_t block_read_byte {0};
+        std::uint64_t block_read_time {0};
+        std::uint64_t get_from_memtable_count {0};
+        std::uint64_t get_from_memtable_time {0};
+        std::uint64_t get_from_output_files_time {0};
+        std::uint64_t bloom_memtable_hit_count {0};
+        std::uint64_t bloom_memtable_miss_count {0};
+        std::uint64_t bloom_sst_hit_count {0};
+        std::uint64_t bloom_sst_miss_count {0};
+        std::uint64_t internal_key_skipped_count {0};
+        std::uint64_t internal_delete_skipped_count {0};
+        std::uint64_t write_wal_time {0};
+        std::uint64_t write_memtable_time {0};
+    };
+
+    /**
+     * Samples RocksDB `PerfContext` of the calling thread for the calls made during the
+     * scope lifetime (construct the scope for the sampled calls only, the collection
+     * slows calls down, especially with timers).
+     */
+    class perf_scope
+    {
+        int _saved_level {0};
+
+    public:
+        DEBBY__EXPORT perf_scope (perf_level level = perf_level::count);
+
+        /**
+         * Restores previous perf level of the calling thread.
+         */
+        DEBBY__EXPORT ~perf_scope ();
+
+        perf_scope (perf_scope const &) = delete;
+        perf_scope & operator = (perf_scope const &) = delete;
+
+    public:
+        /**
+         * Counters accumulated by the calling thread since the scope was constructed.
+         */
+        DEBBY__EXPORT perf_counters counters () const;
+    };
 } // namespace rocksdb
 
 template<>
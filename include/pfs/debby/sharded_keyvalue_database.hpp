@@ -0,0 +1,549 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+//                 Operations fail if there are no shards.
+//                 `set_many()` writes each shard group as single batch.
+//                 `get_many()` collects values into per-shard buffers.
+//                 Failed `add_shards()` returns new databases to the caller.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "backend_enum.hpp"
+#include "error.hpp"
+#include "keyvalue_database.hpp"
+#include <pfs/i18n.hpp>
+#include <pfs/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Key-value database adapter distributing keys across several databases (shards) of
+ * the same backend, e.g. separate files or directories.
+ *
+ * @details Key is mapped to the shard by jump consistent hash (Lamping, Veach) of the
+ *          byte-order independent key hash, so the mapping is stable across platforms
+ *          and growing N shards to M moves only (M - N) / M of the keys.
+ *
+ *          Point operations lock the single shard, so writers of different shards do not
+ *          wait for each other. Multi-key operations are grouped by shard and performed
+ *          by shards in parallel. Operations of the database without shards fail with
+ *          `errc::database_not_found`.
+ *
+ * @note `add_shards()` must not be called concurrently with other operations.
+ */
+template <backend_enum Backend>
+class sharded_keyvalue_database
+{
+public:
+    using database_type = keyvalue_database<Backend>;
+    using key_type = std::string;
+    using string_view = pfs::string_view;
+
+private:
+    struct shard
+    {
+        database_type db;
+        std::mutex mtx;
+
+        explicit shard (database_type && d)
+            : db(std::move(d))
+        {}
+    };
+
+    // Key indices grouped by shard
+    using groups_type = std::vector<std::vector<std::size_t>>;
+
+private:
+    std::vector<std::unique_ptr<shard>> _shards;
+
+public:
+    sharded_keyvalue_database () = default;
+
+    explicit sharded_keyvalue_database (std::vector<database_type> && shards)
+    {
+        _shards.reserve(shards.size());
+
+        for (auto & db: shards)
+            _shards.emplace_back(new shard(std::move(db)));
+    }
+
+    sharded_keyvalue_database (sharded_keyvalue_database && other) = default;
+    sharded_keyvalue_database & operator = (sharded_keyvalue_database && other) = default;
+    sharded_keyvalue_database (sharded_keyvalue_database const &) = delete;
+    sharded_keyvalue_database & operator = (sharded_keyvalue_database const &) = delete;
+
+public:
+    /**
+     * Checks if all shards are open.
+     */
+    operator bool () const noexcept
+    {
+        if (_shards.empty())
+            return false;
+
+        for (auto const & s: _shards) {
+            if (!s->db)
+                return false;
+        }
+
+        return true;
+    }
+
+    std::size_t shard_count () const noexcept
+    {
+        return _shards.size();
+    }
+
+    /**
+     * Returns shard database with @a index (access is not synchronized).
+     */
+    database_type & shard_at (std::size_t index) noexcept
+    {
+        return _shards[index]->db;
+    }
+
+    /**
+     * Index of the shard storing @a key.
+     */
+    std::size_t shard_of (key_type const & key) const noexcept
+    {
+        return shard_index(key, _shards.size());
+    }
+
+    /**
+     * Index of the shard storing @a key among @a shard_count shards (must be non-zero).
+     */
+    static std::size_t shard_index (string_view key, std::size_t shard_count) noexcept
+    {
+        // FNV-1a with final avalanche (independent of byte order)
+        std::uint64_t h = 0xCBF29CE484222325ULL;
+
+        for (auto c: key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001B3ULL;
+        }
+
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+
+        // Jump consistent hash
+        std::int64_t b = -1;
+        std::int64_t j = 0;
+
+        while (j < static_cast<std::int64_t>(shard_count)) {
+            b = j;
+            h = h * 2862933555777941757ULL + 1;
+            j = static_cast<std::int64_t>(static_cast<double>(b + 1)
+                * (static_cast<double>(std::int64_t{1} << 31) / static_cast<double>((h >> 33) + 1)));
+        }
+
+        return static_cast<std::size_t>(b);
+    }
+
+    /**
+     * @throw debby::error()
+     */
+    void clear (error * perr = nullptr)
+    {
+        if (!check_shards(perr))
+            return;
+
+        groups_type groups(_shards.size());
+
+        fan_out(groups, true, [this] (std::size_t i, std::vector<std::size_t> const &, error * perr) {
+            _shards[i]->db.clear(perr);
+        }, perr);
+    }
+
+    /**
+     * @throw debby::error()
+     */
+    void remove (key_type const & key, error * perr = nullptr)
+    {
+        auto ps = locate(key, perr);
+
+        if (ps == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> locker{ps->mtx};
+        ps->db.remove(key, perr);
+    }
+
+    /**
+     * Removes entries associated with @a keys (by shards in parallel).
+     *
+     * @throw debby::error()
+     */
+    void remove_many (std::vector<key_type> const & keys, error * perr = nullptr)
+    {
+        if (!check_shards(perr))
+            return;
+
+        fan_out(group(keys), false, [this, & keys] (std::size_t i, std::vector<std::size_t> const & indices
+                , error * perr) {
+            std::vector<key_type> shard_keys;
+            shard_keys.reserve(indices.size());
+
+            for (auto k: indices)
+                shard_keys.push_back(keys[k]);
+
+            _shards[i]->db.remove_many(shard_keys, perr);
+        }, perr);
+    }
+
+    /**
+     * Calls @a f for each key starting with @a prefix (shard by shard) until @a f
+     * returns @c false.
+     *
+     * @throw debby::error()
+     */
+    void for_each_key (key_type const & prefix, std::function<bool (key_type const &)> const & f
+        , error * perr = nullptr) const
+    {
+        if (!check_shards(perr))
+            return;
+
+        bool stopped = false;
+
+        for (auto const & s: _shards) {
+            error err;
+            std::lock_guard<std::mutex> locker{s->mtx};
+
+            s->db.for_each_key(prefix, [& f, & stopped] (key_type const & key) {
+                stopped = !f(key);
+                return !stopped;
+            }, & err);
+
+            if (err) {
+                pfs::throw_or(perr, std::move(err));
+                return;
+            }
+
+            if (stopped)
+                return;
+        }
+    }
+
+    /**
+     * Stores @a value associated with @a key (arithmetic types, strings and types
+     * supported by `keyvalue_database`).
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    void set (key_type const & key, T const & value, error * perr = nullptr)
+    {
+        auto ps = locate(key, perr);
+
+        if (ps == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> locker{ps->mtx};
+        ps->db.set(key, value, perr);
+    }
+
+    void set (key_type const & key, char const * value, std::size_t len, error * perr = nullptr)
+    {
+        auto ps = locate(key, perr);
+
+        if (ps == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> locker{ps->mtx};
+        ps->db.set(key, value, len, perr);
+    }
+
+    /**
+     * Stores @a items (by shards in parallel). Items of each shard are written as single
+     * batch (see `keyvalue_database::write_batch()`), so each shard stores all of them or
+     * none.
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    void set_many (std::vector<std::pair<key_type, T>> const & items, error * perr = nullptr)
+    {
+        if (!check_shards(perr))
+            return;
+
+        groups_type groups(_shards.size());
+
+        for (std::size_t k = 0; k < items.size(); k++)
+            groups[shard_of(items[k].first)].push_back(k);
+
+        fan_out(groups, false, [this, & items] (std::size_t i, std::vector<std::size_t> const & indices
+                , error * perr) {
+            auto & db = _shards[i]->db;
+
+            try {
+                db.write_batch([& db, & items, & indices] {
+                    for (auto k: indices)
+                        db.set(items[k].first, items[k].second);
+                }, perr);
+            } catch (error const & ex) {
+                pfs::throw_or(perr, error{ex});
+            }
+        }, perr);
+    }
+
+    /**
+     * @throw debby::error()
+     */
+    template <typename T>
+    std::decay_t<T> get (key_type const & key, error * perr = nullptr) const
+    {
+        auto ps = locate(key, perr);
+
+        if (ps == nullptr)
+            return std::decay_t<T>{};
+
+        std::lock_guard<std::mutex> locker{ps->mtx};
+        return ps->db.template get<std::decay_t<T>>(key, perr);
+    }
+
+    template <typename T>
+    T get_or (key_type const & key, T const & default_value, error * perr = nullptr) const
+    {
+        auto ps = locate(key, perr);
+
+        if (ps == nullptr)
+            return default_value;
+
+        std::lock_guard<std::mutex> locker{ps->mtx};
+        return ps->db.template get_or<T>(key, default_value, perr);
+    }
+
+    /**
+     * Reads values associated with @a keys (by shards in parallel), missing keys are
+     * substituted by @a default_value.
+     *
+     * @return Values in order of @a keys.
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    std::vector<T> get_many (std::vector<key_type> const & keys, T const & default_value
+        , error * perr = nullptr) const
+    {
+        if (!check_shards(perr))
+            return std::vector<T>{};
+
+        auto groups = group(keys);
+
+        // Each task fills own buffer (elements of `std::vector<bool>` share memory words),
+        // buffers are scattered into the result after all tasks are finished
+        std::vector<std::vector<T>> values(groups.size());
+
+        auto success = fan_out(groups, false, [this, & keys, & default_value, & values] (std::size_t i
+                , std::vector<std::size_t> const & indices, error * perr) {
+            auto & shard_values = values[i];
+            shard_values.reserve(indices.size());
+
+            for (auto k: indices) {
+                error err;
+                auto value = _shards[i]->db.template get_or<T>(keys[k], default_value, & err);
+
+                if (err) {
+                    pfs::throw_or(perr, std::move(err));
+                    return;
+                }
+
+                shard_values.push_back(std::move(value));
+            }
+        }, perr);
+
+        if (!success)
+            return std::vector<T>{};
+
+        std::vector<T> result(keys.size(), default_value);
+
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            for (std::size_t n = 0; n < groups[i].size(); n++)
+                result[groups[i][n]] = std::move(values[i][n]);
+        }
+
+        return result;
+    }
+
+    /**
+     * Resharding: appends @a shards and moves keys which now belong to them from the
+     * existing shards (by shards in parallel).
+     *
+     * @details Values are copied as byte strings (`get<std::string>()`), which keeps
+     *          values of the persistent backends intact. In-memory backends store typed
+     *          values, so only string values can be moved there.
+     *
+     *          Keys are copied before the shard count is changed and removed from the
+     *          source shards after, so the failed copy leaves the database unchanged and
+     *          moves databases back to @a shards (with garbage of copied keys).
+     *
+     * @throw debby::error()
+     */
+    bool add_shards (std::vector<database_type> && shards, error * perr = nullptr)
+    {
+        auto old_count = _shards.size();
+        auto new_count = old_count + shards.size();
+
+        for (auto & db: shards)
+            _shards.emplace_back(new shard(std::move(db)));
+
+        // Keys to move by source shard
+        std::vector<std::vector<key_type>> moved(old_count);
+        groups_type groups(old_count);
+
+        auto success = fan_out(groups, true, [this, new_count, & moved] (std::size_t i
+                , std::vector<std::size_t> const &, error * perr) {
+            auto & src = _shards[i]->db;
+            auto & keys = moved[i];
+            error err;
+
+            src.for_each_key(key_type{}, [& keys, i, new_count] (key_type const & key) {
+                if (shard_index(key, new_count) != i)
+                    keys.push_back(key);
+
+                return true;
+            }, & err);
+
+            // Destination is one of the new shards (not locked by other tasks)
+            for (std::size_t k = 0; !err && k < keys.size(); k++) {
+                auto value = src.template get<std::string>(keys[k], & err);
+
+                if (!err) {
+                    auto & dest = *_shards[shard_index(keys[k], new_count)];
+                    std::lock_guard<std::mutex> locker{dest.mtx};
+                    dest.db.set(keys[k], value, & err);
+                }
+            }
+
+            if (err)
+                pfs::throw_or(perr, std::move(err));
+        }, perr);
+
+        if (!success) {
+            for (std::size_t n = 0; n < shards.size(); n++)
+                shards[n] = std::move(_shards[old_count + n]->db);
+
+            _shards.resize(old_count);
+            return false;
+        }
+
+        return fan_out(groups, true, [this, & moved] (std::size_t i, std::vector<std::size_t> const &
+                , error * perr) {
+            _shards[i]->db.remove_many(moved[i], perr);
+        }, perr);
+    }
+
+private:
+    bool check_shards (error * perr) const
+    {
+        if (_shards.empty()) {
+            pfs::throw_or(perr, make_error_code(errc::database_not_found), tr::_("no shards"));
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Returns shard storing @a key or @c nullptr if there are no shards.
+     */
+    shard * locate (key_type const & key, error * perr) const
+    {
+        if (!check_shards(perr))
+            return nullptr;
+
+        return _shards[shard_of(key)].get();
+    }
+
+    groups_type group (std::vector<key_type> const & keys) const
+    {
+        groups_type groups(_shards.size());
+
+        for (std::size_t k = 0; k < keys.size(); k++)
+            groups[shard_of(keys[k])].push_back(k);
+
+        return groups;
+    }
+
+    /**
+     * Calls @a f (shard index, key indices, error *) for each shard with non-empty group
+     * (or each shard if @a all is @c true) in parallel, the last one on the calling
+     * thread. @a f is called with the shard locked.
+     *
+     * @return @c false if some of the calls failed (the first failure is reported).
+     */
+    template <typename F>
+    bool fan_out (groups_type const & groups, bool all, F && f, error * perr) const
+    {
+        std::vector<std::size_t> selected;
+
+        for (std::size_t i = 0; i < groups.size(); i++) {
+            if (all || !groups[i].empty())
+                selected.push_back(i);
+        }
+
+        if (selected.empty())
+            return true;
+
+        std::vector<error> errors(selected.size());
+
+        auto call = [this, & groups, & errors, & selected, & f] (std::size_t n) {
+            auto i = selected[n];
+            std::lock_guard<std::mutex> locker{_shards[i]->mtx};
+            f(i, groups[i], & errors[n]);
+        };
+
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(selected.size() - 1);
+
+        for (std::size_t n = 0; n + 1 < selected.size(); n++)
+            tasks.push_back(std::async(std::launch::async, call, n));
+
+        call(selected.size() - 1);
+
+        for (auto & t: tasks)
+            t.get();
+
+        for (auto & err: errors) {
+            if (err) {
+                pfs::throw_or(perr, std::move(err));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+public:
+    /**
+     * Makes database of @a shard_count shards, @a make_shard (std::size_t index) returns
+     * database for the shard with index.
+     */
+    template <typename F>
+    static sharded_keyvalue_database make (std::size_t shard_count, F && make_shard)
+    {
+        std::vector<database_type> shards;
+        shards.reserve(shard_count);
+
+        for (std::size_t i = 0; i < shard_count; i++)
+            shards.push_back(make_shard(i));
+
+        return sharded_keyvalue_database {std::move(shards)};
+    }
+};
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+DEBBY__NAMESPACE_BEGIN
+
+struct slow_query_record
+{
+    // Time when the query finished
+    std::chrono::system_clock::time_point timestamp;
+
+    // SQL text of the query
+    std::string sql;
+
+    // Summary of bound parameters (truncated), empty if query has no parameters
+    std::string params;
+
+    std::chrono::microseconds elapsed {0};
+
+    // Number of rows affected by data modification statement or returned by query,
+    // -1 if unknown (e.g. rows of SQLite query are fetched lazily by result::next()).
+    std::int64_t rows {-1};
+
+    // Output of `EXPLAIN QUERY PLAN` (SQLite) or `EXPLAIN (ANALYZE, BUFFERS)`/`EXPLAIN` (PostgreSQL)
+    // if requested by options, empty otherwise.
+    std::string plan;
+};
+
+struct slow_query_options
+{
+    // Queries executed at least this time are recorded
+    std::chrono::microseconds threshold {std::chrono::milliseconds{100}};
+
+    // Maximum number of records kept (oldest records are overwritten)
+    std::size_t capacity {64};
+
+    // Capture query plan for slow queries.
+    // @note PostgreSQL: read-only queries are explained with `EXPLAIN (ANALYZE, BUFFERS)`,
+    //       i.e. executed once more; other ones with plain `EXPLAIN`.
+    bool explain {false};
+
+    // Optional sink called for each slow query (in the thread executed the query)
+    std::function<void (slow_query_record const &)> callback;
+};
+
+DEBBY__NAMESPACE_END
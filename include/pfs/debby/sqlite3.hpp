@@ -1,11 +1,13 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2021.11.24 Initial version.
 //      2024.10.29 V2 started.
+//      2026.10.18 Added key-value table layout option.
+//                 Added busy policy and lock wait statistics.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -15,6 +17,8 @@
 #include "relational_database.hpp"
 #include <pfs/filesystem.hpp>
 #include <pfs/optional.hpp>
+#include <chrono>
+#include <cstdint>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -35,12 +39,53 @@ enum preset_enum
     , CONCURRENCY_PRESET
 };
 
+// https://www.sqlite.org/withoutrowid.html
+enum kv_layout_enum
+{
+      KV_WITHOUT_ROWID // Clustered primary key, records are stored in the key b-tree itself.
+                       // Suitable for small values (the default).
+    , KV_ROWID         // Ordinary rowid table with separate unique index on key.
+                       // Suitable for large values (exceeding about 1/20 of the page size).
+};
+
+/**
+ * Handling of the locked database (SQLITE_BUSY): the lock acquisition is retried with
+ * exponential backoff (randomized in range [delay / 2, delay]) until `max_wait` elapsed.
+ */
+struct busy_policy
+{
+    // Delay before the first retry
+    std::chrono::milliseconds initial_delay {1};
+
+    // Upper limit of the delay between retries
+    std::chrono::milliseconds max_delay {50};
+
+    // Maximum wait for the lock, zero means the lock is not waited
+    std::chrono::milliseconds max_wait {1000};
+
+    // Maximum number of restarts of the whole `transaction()` body on transaction conflict
+    // (i.e. SQLITE_BUSY_SNAPSHOT when the read transaction can not be upgraded in WAL mode).
+    int max_transaction_retries {3};
+};
+
+/**
+ * Lock wait counters of the connection.
+ */
+struct busy_stats
+{
+    std::uint64_t busy_events {0};         // Number of waits for the lock
+    std::uint64_t timeouts {0};            // Waits failed after `busy_policy::max_wait`
+    std::uint64_t transaction_restarts {0};
+    std::chrono::microseconds total_wait {0};
+};
+
 struct make_options
 {
     pfs::optional<journal_mode_enum> pragma_journal_mode;
     pfs::optional<synchronous_enum> pragma_synchronous;
     pfs::optional<temp_store_enum> pragma_temp_store;
     pfs::optional<std::size_t> pragma_mmap_size;
+    pfs::optional<busy_policy> busy;
 };
 
 /**
@@ -76,6 +121,25 @@ DEBBY__EXPORT
 relational_database<backend_enum::sqlite3>
 make (pfs::filesystem::path const & path, bool create_if_missing, preset_enum preset, error * perr = nullptr);
 
+/**
+ * Replaces busy policy of the connection (must not be called concurrently with database
+ * operations).
+ */
+DEBBY__EXPORT
+void
+set_busy_policy (relational_database<backend_enum::sqlite3> & db, busy_policy const & policy);
+
+/**
+ * Returns lock wait counters of the connection.
+ */
+DEBBY__EXPORT
+busy_stats
+stats (relational_database<backend_enum::sqlite3> const & db);
+
+DEBBY__EXPORT
+void
+reset_stats (relational_database<backend_enum::sqlite3> & db);
+
 /**
  * Wipes database (e.g. drops database or removes files associated with database if possible).
  *
@@ -95,6 +159,17 @@ keyvalue_database<backend_enum::sqlite3>
 make_kv (pfs::filesystem::path const & path, std::string const & table_name, bool create_if_missing
     , preset_enum preset, error * perr = nullptr);
 
+/**
+ * Open key-value database specified by @a path with table @a table_name.
+ *
+ * @param layout Layout of the table created if it is missing. The layout of the existing table
+ *        is not changed.
+ */
+DEBBY__EXPORT
+keyvalue_database<backend_enum::sqlite3>
+make_kv (pfs::filesystem::path const & path, std::string const & table_name, bool create_if_missing
+    , preset_enum preset, kv_layout_enum layout, error * perr = nullptr);
+
 } // namespace sqlite3
 
 template<>
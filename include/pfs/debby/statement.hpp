@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -9,6 +9,7 @@
 //      2022.03.12 Refactored.
 //      2024.10.29 V2 started.
 //      2024.10.30 Fixed API.
+//      2026.10.18 Added `bind_array()` and `exec_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "namespace.hpp"
@@ -22,6 +23,7 @@
 #include <cstdint>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -123,6 +125,44 @@ public:
     DEBBY__EXPORT bool bind (int index, char const * ptr, error * perr = nullptr);
 
     DEBBY__EXPORT bool bind (char const * placeholder, char const * ptr, error * perr = nullptr);
+
+    /**
+     * Binds @a values as single array parameter (e.g. `$1::text[]` or `$2::bytea[]` in
+     * PostgreSQL), so one execution processes all of them (see `exec_batch()`).
+     *
+     * @details Supported element types are `bool`, `short`, `int`, `long`, `long long`,
+     *          `float`, `double` and `std::string`.
+     *
+     * @note Not all databases support array parameters. In this case an exception
+     *       (@c errc::unsupported) is thrown or an error is returned in @a *perr.
+     */
+    template <typename T>
+    DEBBY__EXPORT bool bind_array (int index, std::vector<T> const & values, error * perr = nullptr);
+
+    /**
+     * Binds @a columns as array parameters (starting from 1) and executes the statement,
+     * e.g. `INSERT ... SELECT * FROM unnest($1::text[], $2::bytea[])` inserts all rows in
+     * single round trip.
+     *
+     * @note Columns must have the same size.
+     */
+    template <typename ...Columns>
+    result_type exec_batch (error * perr, Columns const & ... columns)
+    {
+        error err;
+        int index = 0;
+
+        // Binds columns in order and stops on the first error
+        bool unused[] = {true, (err || bind_array(++index, columns, & err))...};
+        (void)unused;
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return result_type{};
+        }
+
+        return exec(perr);
+    }
 };
 
 DEBBY__NAMESPACE_END
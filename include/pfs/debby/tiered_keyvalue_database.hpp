@@ -0,0 +1,468 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "backend_enum.hpp"
+#include "error.hpp"
+#include "keyvalue_database.hpp"
+#include <pfs/string_view.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+enum class write_policy
+{
+      write_through // Writes are applied to both tiers synchronously
+    , write_behind  // Writes are applied to memory tier and queued for persistent tier
+};
+
+struct tiered_options
+{
+    write_policy policy {write_policy::write_through};
+
+    // Maximum number of keys with pending writes (write-behind), writers block when
+    // the queue is full
+    std::size_t queue_capacity {10000};
+
+    // Maximum delay of pending writes used to coalesce repeated writes of the same key
+    // (write-behind)
+    std::chrono::milliseconds flush_interval {100};
+};
+
+/**
+ * Key-value database adapter pairing in-memory (front) tier with persistent (back) tier.
+ *
+ * @details Reads go through the front tier, missing keys are read from the back tier
+ *          and populate the front tier. Writes are applied to the back tier first and
+ *          then to the front tier (write-through), or are applied to the front tier and
+ *          queued for the back tier (write-behind). Queued writes of the same key are
+ *          coalesced and applied in batches by the background thread, each batch is
+ *          written to the back tier by `write_batch()` (single transaction), so it is
+ *          applied or failed as a whole.
+ *
+ *          Write-through writes are serialized, so both tiers receive writes of the same
+ *          key in the same order.
+ *
+ *          Access to the back tier is serialized by the adapter. The front tier must
+ *          be thread safe (e.g. `lru_cache_mt`, `unordered_map_mt`) if the adapter is
+ *          used concurrently.
+ */
+template <backend_enum FrontBackend, backend_enum BackBackend>
+class tiered_keyvalue_database
+{
+public:
+    using front_type = keyvalue_database<FrontBackend>;
+    using back_type = keyvalue_database<BackBackend>;
+    using key_type = std::string;
+    using string_view = pfs::string_view;
+
+private:
+    using pending_op = std::function<void (back_type &, error *)>;
+
+    struct context
+    {
+        front_type front;
+        back_type back;
+        tiered_options opts;
+
+        std::mutex back_mtx; // Serializes access to the back tier and write-through writes
+
+        std::mutex mtx;      // Protects members below and front tier writes
+        std::condition_variable has_work;
+        std::condition_variable not_full;
+        std::condition_variable drained;
+        std::unordered_map<key_type, pending_op> pending;
+        std::unordered_map<key_type, pending_op> batch; // Being applied by the background thread
+        std::uint64_t version {0};    // Incremented by each write
+        std::size_t flush_requests {0};
+        bool stop {false};
+        error failure;                // First failure of the background writes
+        std::thread worker;
+
+        context (front_type && f, back_type && b, tiered_options const & o)
+            : front(std::move(f))
+            , back(std::move(b))
+            , opts(o)
+        {}
+    };
+
+private:
+    std::unique_ptr<context> _d;
+
+public:
+    tiered_keyvalue_database () = default;
+
+    tiered_keyvalue_database (front_type && front, back_type && back, tiered_options const & opts = tiered_options{})
+        : _d(new context(std::move(front), std::move(back), opts))
+    {
+        if (_d->opts.policy == write_policy::write_behind) {
+            auto d = _d.get();
+            _d->worker = std::thread([d] { run(*d); });
+        }
+    }
+
+    tiered_keyvalue_database (tiered_keyvalue_database && other) = default;
+
+    tiered_keyvalue_database & operator = (tiered_keyvalue_database && other)
+    {
+        if (this != & other) {
+            close();
+            _d = std::move(other._d);
+        }
+
+        return *this;
+    }
+
+    tiered_keyvalue_database (tiered_keyvalue_database const &) = delete;
+    tiered_keyvalue_database & operator = (tiered_keyvalue_database const &) = delete;
+
+    /**
+     * Applies pending writes and stops the background thread. Errors are ignored, call
+     * `flush()` before to check them.
+     */
+    ~tiered_keyvalue_database ()
+    {
+        close();
+    }
+
+public:
+    operator bool () const noexcept
+    {
+        return _d != nullptr && _d->front && _d->back;
+    }
+
+    front_type & front () noexcept
+    {
+        return _d->front;
+    }
+
+    back_type & back () noexcept
+    {
+        return _d->back;
+    }
+
+    /**
+     * Waits until all pending writes are applied to the back tier.
+     *
+     * @return @c false if some of the background batches failed (the first failure is
+     *         reported and reset, writes of the failed batch are lost by the back tier).
+     *
+     * @throw debby::error()
+     */
+    bool flush (error * perr = nullptr)
+    {
+        if (_d == nullptr || _d->opts.policy != write_policy::write_behind)
+            return true;
+
+        std::unique_lock<std::mutex> locker{_d->mtx};
+        wait_drained(*_d, locker);
+
+        if (_d->failure) {
+            auto err = std::move(_d->failure);
+            _d->failure = error{};
+            locker.unlock();
+            pfs::throw_or(perr, std::move(err));
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Clears both tiers (pending writes are applied before).
+     *
+     * @throw debby::error()
+     */
+    void clear (error * perr = nullptr)
+    {
+        error err;
+        flush(& err);
+
+        {
+            std::lock_guard<std::mutex> back_locker{_d->back_mtx};
+            _d->back.clear(& err);
+        }
+
+        std::lock_guard<std::mutex> locker{_d->mtx};
+        _d->front.clear();
+        _d->version++;
+
+        if (err)
+            pfs::throw_or(perr, std::move(err));
+    }
+
+    /**
+     * Removes entry associated with @a key from both tiers.
+     *
+     * @throw debby::error()
+     */
+    void remove (key_type const & key, error * perr = nullptr)
+    {
+        write(key, [key] (back_type & back, error * perr) {
+            back.remove(key, perr);
+        }, [& key] (front_type & front, error * perr) {
+            front.remove(key, perr);
+        }, perr);
+    }
+
+    void remove_many (std::vector<key_type> const & keys, error * perr = nullptr)
+    {
+        for (auto const & key: keys) {
+            error err;
+            remove(key, & err);
+
+            if (err) {
+                pfs::throw_or(perr, std::move(err));
+                return;
+            }
+        }
+    }
+
+    /**
+     * Stores @a value associated with @a key (arithmetic types, strings and types
+     * supported by `keyvalue_database`).
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    void set (key_type const & key, T const & value, error * perr = nullptr)
+    {
+        write(key, [key, value] (back_type & back, error * perr) {
+            back.set(key, value, perr);
+        }, [& key, & value] (front_type & front, error * perr) {
+            front.set(key, value, perr);
+        }, perr);
+    }
+
+    void set (key_type const & key, string_view value, error * perr = nullptr)
+    {
+        set(key, std::string(value.data(), value.size()), perr);
+    }
+
+    void set (key_type const & key, char const * value, error * perr = nullptr)
+    {
+        set(key, std::string(value), perr);
+    }
+
+    void set (key_type const & key, char const * value, std::size_t len, error * perr = nullptr)
+    {
+        set(key, std::string(value, len), perr);
+    }
+
+    /**
+     * Reads value associated with @a key from the front tier or from the back tier
+     * on miss, populating the front tier.
+     *
+     * @throw debby::error()
+     */
+    template <typename T>
+    std::decay_t<T> get (key_type const & key, error * perr = nullptr) const
+    {
+        using value_type = std::decay_t<T>;
+
+        error err;
+        auto value = _d->front.template get<value_type>(key, & err);
+
+        if (!err)
+            return value;
+
+        if (err.code() != make_error_code(errc::key_not_found) && err.code() != make_error_code(errc::bad_value)) {
+            pfs::throw_or(perr, std::move(err));
+            return value_type{};
+        }
+
+        std::uint64_t version = 0;
+
+        {
+            std::unique_lock<std::mutex> locker{_d->mtx};
+
+            // Dirty entry evicted from the front tier: make the back tier up to date
+            if (is_pending(key))
+                wait_drained(*_d, locker);
+
+            version = _d->version;
+        }
+
+        err = error{};
+
+        {
+            std::lock_guard<std::mutex> back_locker{_d->back_mtx};
+            value = _d->back.template get<value_type>(key, & err);
+        }
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return value_type{};
+        }
+
+        // Populate the front tier unless the key is written concurrently
+        std::lock_guard<std::mutex> locker{_d->mtx};
+
+        if (version == _d->version && !is_pending(key)) {
+            error populate_err;
+            _d->front.set(key, value, & populate_err);
+        }
+
+        return value;
+    }
+
+    template <typename T>
+    T get_or (key_type const & key, T const & default_value, error * perr = nullptr) const
+    {
+        error err;
+        auto result = get<T>(key, & err);
+
+        if (!err)
+            return result;
+
+        if (make_error_code(errc::key_not_found) == err.code())
+            return default_value;
+
+        pfs::throw_or(perr, std::move(err));
+        return default_value;
+    }
+
+private:
+    bool is_pending (key_type const & key) const
+    {
+        return _d->pending.count(key) > 0 || _d->batch.count(key) > 0;
+    }
+
+    template <typename BackOp, typename FrontOp>
+    void write (key_type const & key, BackOp && back_op, FrontOp && front_op, error * perr)
+    {
+        error err;
+
+        if (_d->opts.policy == write_policy::write_through) {
+            // The back tier is locked until the front tier is updated
+            std::lock_guard<std::mutex> back_locker{_d->back_mtx};
+            back_op(_d->back, & err);
+
+            if (!err) {
+                std::lock_guard<std::mutex> locker{_d->mtx};
+                front_op(_d->front, & err);
+                _d->version++;
+
+                // Front tier must not keep the previous value
+                if (err) {
+                    error ignored;
+                    _d->front.remove(key, & ignored);
+                }
+            }
+        } else {
+            std::unique_lock<std::mutex> locker{_d->mtx};
+            auto d = _d.get();
+
+            d->not_full.wait(locker, [d, & key] {
+                return d->pending.size() < d->opts.queue_capacity || d->pending.count(key) > 0 || d->stop;
+            });
+
+            front_op(d->front, & err);
+            d->version++;
+
+            if (!err) {
+                d->pending[key] = std::forward<BackOp>(back_op);
+                d->has_work.notify_one();
+            }
+        }
+
+        if (err)
+            pfs::throw_or(perr, std::move(err));
+    }
+
+    static void wait_drained (context & d, std::unique_lock<std::mutex> & locker)
+    {
+        d.flush_requests++;
+        d.has_work.notify_one();
+        d.drained.wait(locker, [& d] { return d.pending.empty() && d.batch.empty(); });
+        d.flush_requests--;
+    }
+
+    static void run (context & d)
+    {
+        std::unique_lock<std::mutex> locker{d.mtx};
+
+        for (;;) {
+            d.has_work.wait(locker, [& d] { return d.stop || !d.pending.empty(); });
+
+            if (d.pending.empty())
+                break; // Stopped
+
+            // Let repeated writes of the same keys coalesce
+            if (!d.stop && d.flush_requests == 0 && d.pending.size() < d.opts.queue_capacity) {
+                d.has_work.wait_for(locker, d.opts.flush_interval, [& d] {
+                    return d.stop || d.flush_requests > 0 || d.pending.size() >= d.opts.queue_capacity;
+                });
+            }
+
+            d.batch.swap(d.pending);
+            d.not_full.notify_all();
+            locker.unlock();
+
+            error failure;
+
+            {
+                std::lock_guard<std::mutex> back_locker{d.back_mtx};
+
+                // The first failed write fails the whole batch
+                try {
+                    d.back.write_batch([& d] {
+                        for (auto const & item: d.batch)
+                            item.second(d.back, nullptr);
+                    }, & failure);
+                } catch (error const & ex) {
+                    failure = ex;
+                }
+            }
+
+            locker.lock();
+            d.batch.clear();
+
+            if (failure && !d.failure)
+                d.failure = std::move(failure);
+
+            d.drained.notify_all();
+        }
+
+        d.drained.notify_all();
+    }
+
+    void close ()
+    {
+        if (_d == nullptr || !_d->worker.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> locker{_d->mtx};
+            _d->stop = true;
+        }
+
+        _d->has_work.notify_one();
+        _d->not_full.notify_all();
+        _d->worker.join();
+    }
+
+public:
+    template <typename ...Args>
+    static tiered_keyvalue_database make (front_type && front, back_type && back, Args &&... args)
+    {
+        return tiered_keyvalue_database {std::move(front), std::move(back), std::forward<Args>(args)...};
+    }
+};
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "namespace.hpp"
+#include "error.hpp"
+#include "exports.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+
+DEBBY__NAMESPACE_BEGIN
+
+struct write_executor_options
+{
+    // Maximum number of operations committed by single transaction
+    std::size_t max_batch_size {1024};
+
+    // Time to wait for more operations after the first operation of the batch is
+    // received, zero means the batch contains operations queued at the moment only
+    std::chrono::microseconds max_delay {500};
+};
+
+struct write_executor_stats
+{
+    std::uint64_t operations {0}; // Completed (succeeded or failed) operations
+    std::uint64_t failures {0};   // Failed operations
+    std::uint64_t batches {0};    // Committed (or failed) transactions
+};
+
+/**
+ * Asynchronous writer owning the database connection (`relational_database` or
+ * relational-backed `keyvalue_database`, SQLite only for now).
+ *
+ * @details Operations submitted by many threads are passed through the lock-free
+ *          multiple-producer single-consumer queue to the background thread which
+ *          performs them group-committed: operations queued (or received within
+ *          `write_executor_options::max_delay`) are performed in single write transaction.
+ *          The future returned by `submit()` becomes ready when the transaction
+ *          with the operation is committed. An operation failed with exception
+ *          does not affect others: the batch is performed again without it,
+ *          so operations must not have side effects outside the database. Nested
+ *          transactions started by an operation must be finished by it (the operation
+ *          fails otherwise).
+ *
+ *          Connection must not be used by other threads while the executor owns it.
+ *          Queued operations are completed before the executor is destroyed.
+ */
+template <typename Database>
+class write_executor
+{
+public:
+    using database_type = Database;
+    using operation_type = std::function<void (database_type &)>;
+
+    class impl;
+
+private:
+    std::unique_ptr<impl> _d;
+
+public:
+    /**
+     * Starts the executor taking ownership of the database connection @a db.
+     */
+    DEBBY__EXPORT explicit write_executor (database_type && db
+        , write_executor_options const & opts = write_executor_options{});
+
+    DEBBY__EXPORT write_executor (write_executor && other) noexcept;
+    DEBBY__EXPORT write_executor & operator = (write_executor && other) noexcept;
+    DEBBY__EXPORT ~write_executor ();
+
+    write_executor (write_executor const &) = delete;
+    write_executor & operator = (write_executor const &) = delete;
+
+public:
+    /**
+     * Queues operation @a op.
+     *
+     * @return Future ready when the operation is committed or failed (the future holds
+     *         exception thrown by @a op or `debby::error` on transaction failure).
+     */
+    DEBBY__EXPORT std::future<void> submit (operation_type op);
+
+    /**
+     * Waits until operations submitted before the call are completed.
+     */
+    DEBBY__EXPORT void flush ();
+
+    DEBBY__EXPORT write_executor_stats stats () const noexcept;
+};
+
+DEBBY__NAMESPACE_END
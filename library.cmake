@@ -1,5 +1,5 @@
 ################################################################################
-# Copyright (c) 2019-2022 Vladislav Trifochkin
+# Copyright (c) 2019-2026 Vladislav Trifochkin
 #
 # This file is part of `debby-lib`.
 #
@@ -8,6 +8,13 @@
 #       2024.10.27 Removed `portable_target` dependency.
 #       2024.11.12 Min CMake version is 3.15.
 #       2024.11.13 Min CMake version is 3.19 (CMakePresets).
+#       2026.10.18 Added instrumentation.
+#                  Added `lru_cache` backend.
+#                  Linked with `Threads`.
+#                  Added bloom filter.
+#                  Added RocksDB bulk loader.
+#                  Added RocksDB statistics.
+#                  Added SQLite write executor.
 ################################################################################
 cmake_minimum_required (VERSION 3.19)
 project(debby LANGUAGES CXX C)
@@ -21,17 +28,27 @@ else()
 endif()
 
 add_library(pfs::debby ALIAS debby)
-target_link_libraries(debby PUBLIC pfs::common)
+
+# Required by `tiered_keyvalue_database`
+find_package(Threads REQUIRED)
+target_link_libraries(debby PUBLIC pfs::common Threads::Threads)
 
 if (MSVC)
     target_compile_definitions(debby PRIVATE _CRT_SECURE_NO_WARNINGS)
 endif()
 
 target_sources(debby PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/src/bloom_filter.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/data_definition.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/src/error.cpp)
+    ${CMAKE_CURRENT_LIST_DIR}/src/error.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/instrumentation.cpp)
+
+if (DEBBY__ENABLE_INSTRUMENTATION)
+    target_compile_definitions(debby PUBLIC "DEBBY__INSTRUMENTATION_ENABLED=1")
+endif()
 
-if (DEBBY__ENABLE_MAP OR DEBBY__ENABLE_UNORDERED_MAP)
+if (DEBBY__ENABLE_MAP OR DEBBY__ENABLE_UNORDERED_MAP OR DEBBY__ENABLE_FLAT_HASH_MAP OR DEBBY__ENABLE_RADIX_TREE
+        OR DEBBY__ENABLE_LRU_CACHE)
     target_sources(debby PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/in_memory/keyvalue_database.cpp)
 
     if (DEBBY__ENABLE_MAP)
@@ -41,6 +58,18 @@ if (DEBBY__ENABLE_MAP OR DEBBY__ENABLE_UNORDERED_MAP)
     if (DEBBY__ENABLE_UNORDERED_MAP)
         target_compile_definitions(debby PUBLIC "DEBBY__UNORDERED_MAP_ENABLED=1")
     endif()
+
+    if (DEBBY__ENABLE_FLAT_HASH_MAP)
+        target_compile_definitions(debby PUBLIC "DEBBY__FLAT_HASH_MAP_ENABLED=1")
+    endif()
+
+    if (DEBBY__ENABLE_RADIX_TREE)
+        target_compile_definitions(debby PUBLIC "DEBBY__RADIX_TREE_ENABLED=1")
+    endif()
+
+    if (DEBBY__ENABLE_LRU_CACHE)
+        target_compile_definitions(debby PUBLIC "DEBBY__LRU_CACHE_ENABLED=1")
+    endif()
 endif()
 
 if (DEBBY__ENABLE_SQLITE3)
@@ -50,7 +79,8 @@ if (DEBBY__ENABLE_SQLITE3)
         ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/relational_database.cpp
         ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/keyvalue_database.cpp
         ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/result.cpp
-        ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/statement.cpp)
+        ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/statement.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/src/sqlite3/write_executor.cpp)
 
     target_compile_definitions(debby PUBLIC "DEBBY__SQLITE3_ENABLED=1")
 
@@ -62,7 +92,9 @@ endif()
 
 if (DEBBY__ENABLE_ROCKSDB_CXX11)
     if (TARGET rocksdb)
-        target_sources(debby PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/rocksdb/keyvalue_database.cpp)
+        target_sources(debby PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/rocksdb/keyvalue_database.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/src/rocksdb/bulk_loader.cpp
+            ${CMAKE_CURRENT_LIST_DIR}/src/rocksdb/statistics.cpp)
         target_compile_definitions(debby PUBLIC "DEBBY__ROCKSDB_ENABLED=1" "DEBBY__ROCKSDB_CXX11_ENABLED=1")
 
         target_link_libraries(debby PRIVATE rocksdb)
@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "debby/bloom_filter.hpp"
+#include "in_memory/hash.hpp"
+#include "in_memory/snapshot_file.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#   define DEBBY__BLOOM_FILTER_AVX2 1
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define DEBBY__BLOOM_FILTER_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace {
+
+// Odd multipliers selecting bit in each word of the block (from Parquet split block
+// bloom filter specification)
+alignas(32) std::uint32_t const SALT[bloom_filter::BLOCK_WORDS] = {
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU
+    , 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+char const * bloom_filter_magic () noexcept
+{
+    return "DEBBYBF";
+}
+
+inline std::size_t block_index (std::uint64_t h, std::size_t block_count) noexcept
+{
+    // Maps upper 32 bits of the hash to [0, block_count) without division
+    return static_cast<std::size_t>(((h >> 32) * static_cast<std::uint64_t>(block_count)) >> 32);
+}
+
+#if !DEBBY__BLOOM_FILTER_AVX2
+inline void make_mask (std::uint32_t key, std::uint32_t * mask) noexcept
+{
+    for (std::size_t i = 0; i < bloom_filter::BLOCK_WORDS; i++)
+        mask[i] = std::uint32_t{1} << ((key * SALT[i]) >> 27);
+}
+#endif
+
+#if DEBBY__BLOOM_FILTER_AVX2
+inline __m256i make_mask (std::uint32_t key) noexcept
+{
+    auto salt = _mm256_load_si256(reinterpret_cast<__m256i const *>(SALT));
+    auto bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)), salt), 27);
+    return _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+}
+#endif
+
+inline int popcount (std::uint32_t x) noexcept
+{
+    x = x - ((x >> 1) & 0x55555555U);
+    x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+    return static_cast<int>((((x + (x >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24);
+}
+
+} // namespace
+
+bloom_filter::bloom_filter (std::size_t expected_keys, unsigned bits_per_key)
+{
+    constexpr std::size_t block_bits = BLOCK_WORDS * 32;
+    auto bits = static_cast<std::uint64_t>((std::max)(expected_keys, std::size_t{1})) * (std::max)(bits_per_key, 1U);
+    auto blocks = static_cast<std::size_t>((bits + block_bits - 1) / block_bits);
+
+    _words.assign(blocks * BLOCK_WORDS, 0);
+}
+
+std::uint64_t bloom_filter::hash (char const * key, std::size_t size) noexcept
+{
+    return in_memory::hash_bytes(key, size);
+}
+
+void bloom_filter::insert (std::uint64_t h) noexcept
+{
+    if (_words.empty())
+        return;
+
+    auto block = _words.data() + block_index(h, block_count()) * BLOCK_WORDS;
+    auto key = static_cast<std::uint32_t>(h);
+
+#if DEBBY__BLOOM_FILTER_AVX2
+    auto p = reinterpret_cast<__m256i *>(block);
+    _mm256_storeu_si256(p, _mm256_or_si256(_mm256_loadu_si256(p), make_mask(key)));
+#else
+    std::uint32_t mask[BLOCK_WORDS];
+    make_mask(key, mask);
+
+    for (std::size_t i = 0; i < BLOCK_WORDS; i++)
+        block[i] |= mask[i];
+#endif
+
+    _count++;
+}
+
+bool bloom_filter::may_contain (std::uint64_t h) const noexcept
+{
+    // Empty (not initialized) filter passes all keys
+    if (_words.empty())
+        return true;
+
+    auto block = _words.data() + block_index(h, block_count()) * BLOCK_WORDS;
+    auto key = static_cast<std::uint32_t>(h);
+
+#if DEBBY__BLOOM_FILTER_AVX2
+    // Checks that all mask bits are set: (~block & mask) == 0
+    return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(block)), make_mask(key)) != 0;
+#elif DEBBY__BLOOM_FILTER_SSE2
+    alignas(16) std::uint32_t mask[BLOCK_WORDS];
+    make_mask(key, mask);
+
+    auto m0 = _mm_load_si128(reinterpret_cast<__m128i const *>(mask));
+    auto m1 = _mm_load_si128(reinterpret_cast<__m128i const *>(mask + 4));
+    auto b0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block));
+    auto b1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block + 4));
+    auto eq = _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(b0, m0), m0), _mm_cmpeq_epi32(_mm_and_si128(b1, m1), m1));
+
+    return _mm_movemask_epi8(eq) == 0xFFFF;
+#else
+    std::uint32_t mask[BLOCK_WORDS];
+    make_mask(key, mask);
+
+    std::uint32_t missing = 0;
+
+    for (std::size_t i = 0; i < BLOCK_WORDS; i++)
+        missing |= mask[i] & ~block[i];
+
+    return missing == 0;
+#endif
+}
+
+void bloom_filter::clear () noexcept
+{
+    std::fill(_words.begin(), _words.end(), 0);
+    _count = 0;
+}
+
+double bloom_filter::estimated_false_positive_rate () const noexcept
+{
+    if (_words.empty())
+        return 1.0;
+
+    std::uint64_t set_bits = 0;
+
+    for (auto w: _words)
+        set_bits += static_cast<std::uint64_t>(popcount(w));
+
+    // Probe checks one bit per word
+    auto fill_ratio = static_cast<double>(set_bits) / static_cast<double>(_words.size() * 32);
+    return std::pow(fill_ratio, static_cast<double>(BLOCK_WORDS));
+}
+
+bool bloom_filter::save (pfs::filesystem::path const & path, error * perr) const
+{
+    in_memory::snapshot_writer w {path, perr};
+
+    if (!w.is_open())
+        return false;
+
+    error err;
+
+    if (!_words.empty()) {
+        w.append(reinterpret_cast<char const *>(_words.data()), size_bytes(), & err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return false;
+        }
+    }
+
+    in_memory::snapshot_header h;
+    std::memset(& h, 0, sizeof(h));
+    std::memcpy(h.magic, bloom_filter_magic(), sizeof(h.magic));
+    h.version = in_memory::snapshot_header::VERSION;
+    h.flags = in_memory::native_byte_order_flags();
+    h.count = _count;
+
+    return w.commit(h, perr);
+}
+
+bloom_filter bloom_filter::load (pfs::filesystem::path const & path, error * perr)
+{
+    error err;
+    in_memory::mapped_file f {path, & err};
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return bloom_filter{};
+    }
+
+    // Type sizes are not used by the filter image
+    std::uint8_t type_sizes[sizeof(in_memory::snapshot_header::type_sizes)] = {0};
+    in_memory::snapshot_header h;
+    auto payload = in_memory::validate_snapshot(f, path, bloom_filter_magic(), type_sizes, h, perr);
+
+    if (payload == nullptr)
+        return bloom_filter{};
+
+    if (h.payload_size == 0 || h.payload_size % (BLOCK_WORDS * sizeof(std::uint32_t)) != 0) {
+        pfs::throw_or(perr, in_memory::make_snapshot_error(errc::bad_value, path, tr::_("bad bloom filter size")));
+        return bloom_filter{};
+    }
+
+    bloom_filter result;
+    result._words.resize(static_cast<std::size_t>(h.payload_size / sizeof(std::uint32_t)));
+    std::memcpy(result._words.data(), payload, static_cast<std::size_t>(h.payload_size));
+    result._count = h.count;
+
+    return result;
+}
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/column_batch.hpp"
+#include <cstddef>
+#include <cstdint>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace column_batch_builder {
+
+/**
+ * Prepares @a batch for @a column_count columns reusing memory allocated by the previous
+ * batch (names and types are assigned by the caller).
+ */
+inline void reset (column_batch & batch, int column_count, std::size_t batch_size)
+{
+    batch.row_count = 0;
+    batch.columns.resize(column_count);
+
+    for (auto & c: batch.columns) {
+        c.clear();
+        c.validity.reserve((batch_size + 7) / 8);
+    }
+}
+
+/**
+ * Reserves value buffers for column @a c of already assigned type.
+ */
+inline void start_column (column_buffer & c, std::size_t batch_size)
+{
+    switch (c.type) {
+        case column_type::int64:
+            c.int64_values.reserve(batch_size);
+            break;
+        case column_type::float64:
+            c.float64_values.reserve(batch_size);
+            break;
+        case column_type::binary:
+            c.offsets.reserve(batch_size + 1);
+            c.offsets.push_back(0);
+            break;
+    }
+}
+
+inline void set_validity (column_buffer & c, std::size_t row, bool valid)
+{
+    if (row % 8 == 0)
+        c.validity.push_back(0);
+
+    if (valid)
+        c.validity.back() |= static_cast<std::uint8_t>(1u << (row % 8));
+    else
+        c.null_count++;
+}
+
+inline void append_null (column_buffer & c, std::size_t row)
+{
+    set_validity(c, row, false);
+
+    switch (c.type) {
+        case column_type::int64:
+            c.int64_values.push_back(0);
+            break;
+        case column_type::float64:
+            c.float64_values.push_back(0);
+            break;
+        case column_type::binary:
+            c.offsets.push_back(static_cast<std::int64_t>(c.data.size()));
+            break;
+    }
+}
+
+inline void append_int64 (column_buffer & c, std::size_t row, std::int64_t value)
+{
+    set_validity(c, row, true);
+    c.int64_values.push_back(value);
+}
+
+inline void append_float64 (column_buffer & c, std::size_t row, double value)
+{
+    set_validity(c, row, true);
+    c.float64_values.push_back(value);
+}
+
+inline void append_binary (column_buffer & c, std::size_t row, char const * data, std::size_t size)
+{
+    set_validity(c, row, true);
+    c.data.append(data, size);
+    c.offsets.push_back(static_cast<std::int64_t>(c.data.size()));
+}
+
+} // namespace column_batch_builder
+
+DEBBY__NAMESPACE_END
@@ -1,10 +1,11 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2021.12.14 Initial version.
+//      2026.10.18 Added `transaction_conflict`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "debby/error.hpp"
 #include "debby/namespace.hpp"
@@ -44,6 +45,9 @@ std::string error_category::message (int ev) const
         case static_cast<int>(errc::unsupported):
             return std::string{"unsupported"};
 
+        case static_cast<int>(errc::transaction_conflict):
+            return std::string{"transaction conflict"};
+
         default: return std::string{"unknown debby error"};
     }
 };
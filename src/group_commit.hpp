@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/group_commit.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Leader/follower group commit for backends with single write transaction at a time.
+ *
+ * @details Writer is allocated on the caller's stack, the caller waits until the leader
+ *          performs it. Write failed with the backend error code other than `soft_error`
+ *          makes the transaction unusable, so the transaction is aborted and the batch
+ *          is performed again without this write.
+ */
+template <typename Txn>
+class group_commit
+{
+public:
+    struct backend_type
+    {
+        std::function<int (Txn *)> begin;
+        std::function<int (Txn)> commit;
+        std::function<void (Txn)> abort;
+        int success;    // Success code
+        int soft_error; // Write failure not affecting the transaction (e.g. key not found)
+    };
+
+private:
+    struct writer
+    {
+        int (* apply) (void *, Txn);
+        void * context;
+        int rc;
+        bool done;
+        std::condition_variable cv;
+    };
+
+private:
+    group_commit_options _opts;
+    backend_type _backend;
+
+    std::mutex _mtx;
+    std::condition_variable _leader_cv; // Leader waits for the batch to be filled
+    std::deque<writer *> _writers;
+    std::vector<writer *> _batch;       // Used by leader only
+
+public:
+    group_commit (group_commit_options const & opts, backend_type && backend)
+        : _opts(opts)
+        , _backend(std::move(backend))
+    {
+        if (_opts.max_batch_size == 0)
+            _opts.max_batch_size = 1;
+    }
+
+public:
+    /**
+     * Performs write @a f (int (Txn)) as a part of the group transaction.
+     *
+     * @return The write result code or the transaction failure code.
+     */
+    template <typename F>
+    int perform (F & f)
+    {
+        writer w;
+        w.apply = [] (void * context, Txn txn) -> int { return (*static_cast<F *>(context))(txn); };
+        w.context = & f;
+        w.rc = _backend.success;
+        w.done = false;
+
+        std::unique_lock<std::mutex> locker{_mtx};
+        _writers.push_back(& w);
+
+        if (_writers.size() == _opts.max_batch_size)
+            _leader_cv.notify_one();
+
+        while (!w.done && & w != _writers.front())
+            w.cv.wait(locker);
+
+        if (w.done)
+            return w.rc;
+
+        // Leader
+        if (_opts.max_latency.count() > 0 && _writers.size() < _opts.max_batch_size) {
+            _leader_cv.wait_for(locker, _opts.max_latency, [this] {
+                return _writers.size() >= _opts.max_batch_size;
+            });
+        }
+
+        auto count = (std::min)(_writers.size(), _opts.max_batch_size);
+        _batch.assign(_writers.begin(), _writers.begin() + count);
+
+        // Followers queued during the transaction wait for the next leader
+        locker.unlock();
+        perform_batch();
+        locker.lock();
+
+        for (std::size_t i = 0; i < count; i++) {
+            auto x = _writers.front();
+            _writers.pop_front();
+            x->done = true;
+
+            if (x != & w)
+                x->cv.notify_one();
+        }
+
+        if (!_writers.empty())
+            _writers.front()->cv.notify_one();
+
+        return w.rc;
+    }
+
+private:
+    void perform_batch ()
+    {
+        std::vector<bool> failed(_batch.size(), false);
+
+        for (;;) {
+            Txn txn {};
+            int rc = _backend.begin(& txn);
+            bool write_failed = false;
+
+            for (std::size_t i = 0; rc == _backend.success && i < _batch.size(); i++) {
+                if (failed[i])
+                    continue;
+
+                auto x = _batch[i];
+                x->rc = x->apply(x->context, txn);
+
+                if (x->rc != _backend.success && x->rc != _backend.soft_error) {
+                    failed[i] = true;
+                    write_failed = true;
+                    break;
+                }
+            }
+
+            if (rc == _backend.success && write_failed) {
+                _backend.abort(txn);
+                continue;
+            }
+
+            if (rc == _backend.success)
+                rc = _backend.commit(txn);
+
+            // Transaction failure is the failure of all writes
+            if (rc != _backend.success) {
+                for (std::size_t i = 0; i < _batch.size(); i++) {
+                    if (!failed[i])
+                        _batch[i]->rc = rc;
+                }
+            }
+
+            return;
+        }
+    }
+};
+
+DEBBY__NAMESPACE_END
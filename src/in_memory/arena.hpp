@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/namespace.hpp"
+#include "hash.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Pool arena: small chunks are carved from large blocks and recycled through per size
+ * class free lists, larger chunks are allocated individually. All memory is returned
+ * to the system heap at once by `release()` (or destructor).
+ *
+ * @note Arena is not thread safe.
+ */
+class arena
+{
+public:
+    static constexpr std::size_t ALIGNMENT = 16;
+    static constexpr std::size_t MAX_POOLED_SIZE = 512;
+    static constexpr std::size_t MIN_BLOCK_SIZE = 4096;
+
+private:
+    struct free_chunk
+    {
+        free_chunk * next;
+    };
+
+    // Header of the block or the large chunk (size is a multiple of ALIGNMENT)
+    struct alignas(ALIGNMENT) header
+    {
+        header * prev;
+        header * next;
+    };
+
+    static_assert(sizeof(header) % ALIGNMENT == 0, "bad header size");
+
+private:
+    std::size_t _block_size;
+    header * _blocks {nullptr};
+    header * _large {nullptr};
+    char * _cursor {nullptr};
+    char * _end {nullptr};
+    std::size_t _reserved {0};
+    free_chunk * _free[MAX_POOLED_SIZE / ALIGNMENT];
+
+public:
+    explicit arena (std::size_t block_size)
+        : _block_size(block_size < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : block_size)
+    {
+        std::fill(_free, _free + MAX_POOLED_SIZE / ALIGNMENT, nullptr);
+    }
+
+    arena (arena const &) = delete;
+    arena & operator = (arena const &) = delete;
+
+    ~arena ()
+    {
+        release();
+    }
+
+public:
+    /**
+     * Number of bytes requested from the system heap.
+     */
+    std::size_t reserved () const noexcept
+    {
+        return _reserved;
+    }
+
+    void * allocate (std::size_t size)
+    {
+        auto n = round_up(size);
+
+        if (n > MAX_POOLED_SIZE) {
+            auto h = static_cast<header *>(::operator new(sizeof(header) + n));
+            link(_large, h);
+            _reserved += sizeof(header) + n;
+            return h + 1;
+        }
+
+        auto & head = _free[n / ALIGNMENT - 1];
+
+        if (head != nullptr) {
+            auto p = head;
+            head = p->next;
+            return p;
+        }
+
+        if (static_cast<std::size_t>(_end - _cursor) < n)
+            add_block();
+
+        auto p = _cursor;
+        _cursor += n;
+        return p;
+    }
+
+    void deallocate (void * p, std::size_t size) noexcept
+    {
+        if (p == nullptr)
+            return;
+
+        auto n = round_up(size);
+
+        if (n > MAX_POOLED_SIZE) {
+            auto h = static_cast<header *>(p) - 1;
+            unlink(_large, h);
+            _reserved -= sizeof(header) + n;
+            ::operator delete(h);
+            return;
+        }
+
+        auto & head = _free[n / ALIGNMENT - 1];
+        auto chunk = static_cast<free_chunk *>(p);
+        chunk->next = head;
+        head = chunk;
+    }
+
+    /**
+     * Returns all memory to the system heap. Memory allocated before becomes invalid.
+     */
+    void release () noexcept
+    {
+        free_list(_blocks);
+        free_list(_large);
+        _cursor = nullptr;
+        _end = nullptr;
+        _reserved = 0;
+        std::fill(_free, _free + MAX_POOLED_SIZE / ALIGNMENT, nullptr);
+    }
+
+private:
+    static std::size_t round_up (std::size_t size) noexcept
+    {
+        return size == 0 ? ALIGNMENT : (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    static void link (header * & head, header * h) noexcept
+    {
+        h->prev = nullptr;
+        h->next = head;
+
+        if (head != nullptr)
+            head->prev = h;
+
+        head = h;
+    }
+
+    static void unlink (header * & head, header * h) noexcept
+    {
+        if (h->prev != nullptr)
+            h->prev->next = h->next;
+        else
+            head = h->next;
+
+        if (h->next != nullptr)
+            h->next->prev = h->prev;
+    }
+
+    static void free_list (header * & head) noexcept
+    {
+        while (head != nullptr) {
+            auto next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+
+    void add_block ()
+    {
+        auto h = static_cast<header *>(::operator new(sizeof(header) + _block_size));
+        link(_blocks, h);
+        _reserved += sizeof(header) + _block_size;
+
+        // The tail of the previous block is lost until release()
+        _cursor = reinterpret_cast<char *>(h + 1);
+        _end = _cursor + _block_size;
+    }
+};
+
+/**
+ * Allocator using arena if specified or the system heap otherwise.
+ */
+template <typename T>
+class arena_allocator
+{
+    template <typename U>
+    friend class arena_allocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+private:
+    arena * _arena {nullptr};
+
+public:
+    arena_allocator () noexcept = default;
+
+    explicit arena_allocator (arena * a) noexcept
+        : _arena(a)
+    {}
+
+    template <typename U>
+    arena_allocator (arena_allocator<U> const & other) noexcept
+        : _arena(other._arena)
+    {}
+
+    T * allocate (std::size_t n)
+    {
+        static_assert(alignof(T) <= arena::ALIGNMENT, "over-aligned types are not supported");
+
+        return static_cast<T *>(_arena != nullptr
+            ? _arena->allocate(n * sizeof(T))
+            : ::operator new(n * sizeof(T)));
+    }
+
+    void deallocate (T * p, std::size_t n) noexcept
+    {
+        if (_arena != nullptr)
+            _arena->deallocate(p, n * sizeof(T));
+        else
+            ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator == (arena_allocator<U> const & other) const noexcept
+    {
+        return _arena == other._arena;
+    }
+
+    template <typename U>
+    bool operator != (arena_allocator<U> const & other) const noexcept
+    {
+        return _arena != other._arena;
+    }
+};
+
+using arena_string = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+
+/**
+ * Transparent comparator of strings with any allocators.
+ */
+struct key_less
+{
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    bool operator () (A const & a, B const & b) const noexcept
+    {
+        auto n = (std::min)(a.size(), b.size());
+        auto r = n == 0 ? 0 : std::memcmp(a.data(), b.data(), n);
+        return r < 0 || (r == 0 && a.size() < b.size());
+    }
+};
+
+struct key_hash
+{
+    std::size_t operator () (arena_string const & s) const noexcept
+    {
+        return static_cast<std::size_t>(hash_bytes(s.data(), s.size()));
+    }
+};
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,344 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/namespace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Fixed size (16 bytes) string with inline storage for strings up to 15 bytes.
+ *
+ * Layout:
+ *      inline: bytes [0..14] - characters, byte [15] - size (0..15);
+ *      heap:   bytes [0..7]  - pointer, bytes [8..11] - size, byte [15] - HEAP_TAG.
+ */
+class compact_string
+{
+public:
+    static constexpr std::size_t INLINE_CAPACITY = 15;
+
+private:
+    static constexpr unsigned char HEAP_TAG = 0xFF;
+
+    alignas(8) unsigned char _b[16];
+
+public:
+    compact_string () noexcept
+    {
+        _b[INLINE_CAPACITY] = 0;
+    }
+
+    compact_string (char const * data, std::size_t size)
+    {
+        if (size <= INLINE_CAPACITY) {
+            if (size > 0)
+                std::memcpy(_b, data, size);
+
+            _b[INLINE_CAPACITY] = static_cast<unsigned char>(size);
+        } else {
+            if (size > (std::numeric_limits<std::uint32_t>::max)())
+                throw std::length_error {"compact_string: string too long"};
+
+            auto ptr = static_cast<char *>(::operator new(size));
+            auto sz = static_cast<std::uint32_t>(size);
+            std::memcpy(ptr, data, size);
+            std::memcpy(_b, & ptr, sizeof(ptr));
+            std::memcpy(_b + 8, & sz, sizeof(sz));
+            _b[INLINE_CAPACITY] = HEAP_TAG;
+        }
+    }
+
+    compact_string (compact_string && other) noexcept
+    {
+        std::memcpy(_b, other._b, sizeof(_b));
+        other._b[INLINE_CAPACITY] = 0;
+    }
+
+    compact_string & operator = (compact_string && other) noexcept
+    {
+        if (this != & other) {
+            release();
+            std::memcpy(_b, other._b, sizeof(_b));
+            other._b[INLINE_CAPACITY] = 0;
+        }
+
+        return *this;
+    }
+
+    compact_string (compact_string const &) = delete;
+    compact_string & operator = (compact_string const &) = delete;
+
+    ~compact_string ()
+    {
+        release();
+    }
+
+public:
+    bool is_inline () const noexcept
+    {
+        return _b[INLINE_CAPACITY] != HEAP_TAG;
+    }
+
+    char const * data () const noexcept
+    {
+        if (is_inline())
+            return reinterpret_cast<char const *>(_b);
+
+        char * ptr;
+        std::memcpy(& ptr, _b, sizeof(ptr));
+        return ptr;
+    }
+
+    std::size_t size () const noexcept
+    {
+        if (is_inline())
+            return _b[INLINE_CAPACITY];
+
+        std::uint32_t sz;
+        std::memcpy(& sz, _b + 8, sizeof(sz));
+        return sz;
+    }
+
+    bool equals (char const * data, std::size_t size) const noexcept
+    {
+        return this->size() == size && (size == 0 || std::memcmp(this->data(), data, size) == 0);
+    }
+
+    std::string str () const
+    {
+        return std::string(data(), size());
+    }
+
+private:
+    void release () noexcept
+    {
+        if (!is_inline()) {
+            char * ptr;
+            std::memcpy(& ptr, _b, sizeof(ptr));
+            ::operator delete(ptr);
+            _b[INLINE_CAPACITY] = 0;
+        }
+    }
+};
+
+/**
+ * Fixed size (16 bytes) tagged value: one of the arithmetic types supported by key-value
+ * database or string (inline if not longer than 14 bytes). The exact type of the stored
+ * value is preserved (e.g. `long` and `long long` are distinct).
+ *
+ * Layout:
+ *      arithmetic:    bytes [0..7]  - value;
+ *      inline string: bytes [0..13] - characters, byte [14] - size;
+ *      heap string:   bytes [0..7]  - pointer to block `[std::size_t size][characters]`;
+ *      byte [15] - type tag.
+ */
+class compact_value
+{
+public:
+    static constexpr std::size_t INLINE_CAPACITY = 14;
+
+    enum tag_enum: unsigned char
+    {
+          t_empty = 0
+        , t_bool
+        , t_char
+        , t_schar
+        , t_uchar
+        , t_short
+        , t_ushort
+        , t_int
+        , t_uint
+        , t_long
+        , t_ulong
+        , t_llong
+        , t_ullong
+        , t_float
+        , t_double
+        , t_inline_string
+        , t_heap_string
+    };
+
+    template <typename T> struct tag_of;
+
+private:
+    alignas(8) unsigned char _b[16];
+
+public:
+    compact_value () noexcept
+    {
+        _b[15] = t_empty;
+    }
+
+    compact_value (compact_value && other) noexcept
+    {
+        std::memcpy(_b, other._b, sizeof(_b));
+        other._b[15] = t_empty;
+    }
+
+    compact_value & operator = (compact_value && other) noexcept
+    {
+        if (this != & other) {
+            release();
+            std::memcpy(_b, other._b, sizeof(_b));
+            other._b[15] = t_empty;
+        }
+
+        return *this;
+    }
+
+    compact_value (compact_value const &) = delete;
+    compact_value & operator = (compact_value const &) = delete;
+
+    ~compact_value ()
+    {
+        release();
+    }
+
+public:
+    tag_enum tag () const noexcept
+    {
+        return static_cast<tag_enum>(_b[15]);
+    }
+
+    bool is_string () const noexcept
+    {
+        return tag() == t_inline_string || tag() == t_heap_string;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, void>
+    assign (T value) noexcept
+    {
+        static_assert(sizeof(T) <= 8, "unsupported arithmetic type");
+        release();
+        std::memcpy(_b, & value, sizeof(T));
+        _b[15] = tag_of<T>::value;
+    }
+
+    void assign (char const * data, std::size_t size)
+    {
+        if (size <= INLINE_CAPACITY) {
+            release();
+
+            if (size > 0)
+                std::memcpy(_b, data, size);
+
+            _b[14] = static_cast<unsigned char>(size);
+            _b[15] = t_inline_string;
+        } else {
+            // Allocate before releasing to keep the old value on failure
+            auto block = static_cast<char *>(::operator new(sizeof(std::size_t) + size));
+            std::memcpy(block, & size, sizeof(std::size_t));
+            std::memcpy(block + sizeof(std::size_t), data, size);
+
+            release();
+            std::memcpy(_b, & block, sizeof(block));
+            _b[15] = t_heap_string;
+        }
+    }
+
+    template <typename T>
+    bool holds () const noexcept
+    {
+        return tag() == tag_of<T>::value;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, T>
+    get () const noexcept
+    {
+        T value;
+        std::memcpy(& value, _b, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Size of the stored value in bytes (string length for strings).
+     */
+    std::size_t size () const noexcept
+    {
+        switch (tag()) {
+            case t_inline_string:
+                return _b[14];
+            case t_heap_string: {
+                std::size_t sz;
+                std::memcpy(& sz, heap_block(), sizeof(sz));
+                return sz;
+            }
+            default:
+                return 0;
+        }
+    }
+
+    char const * string_data () const noexcept
+    {
+        return tag() == t_inline_string
+            ? reinterpret_cast<char const *>(_b)
+            : heap_block() + sizeof(std::size_t);
+    }
+
+    std::string str () const
+    {
+        return std::string(string_data(), size());
+    }
+
+private:
+    char * heap_block () const noexcept
+    {
+        char * block;
+        std::memcpy(& block, _b, sizeof(block));
+        return block;
+    }
+
+    void release () noexcept
+    {
+        if (tag() == t_heap_string)
+            ::operator delete(heap_block());
+
+        _b[15] = t_empty;
+    }
+};
+
+template <> struct compact_value::tag_of<bool> { static constexpr tag_enum value = t_bool; };
+template <> struct compact_value::tag_of<char> { static constexpr tag_enum value = t_char; };
+template <> struct compact_value::tag_of<signed char> { static constexpr tag_enum value = t_schar; };
+template <> struct compact_value::tag_of<unsigned char> { static constexpr tag_enum value = t_uchar; };
+template <> struct compact_value::tag_of<short int> { static constexpr tag_enum value = t_short; };
+template <> struct compact_value::tag_of<unsigned short int> { static constexpr tag_enum value = t_ushort; };
+template <> struct compact_value::tag_of<int> { static constexpr tag_enum value = t_int; };
+template <> struct compact_value::tag_of<unsigned int> { static constexpr tag_enum value = t_uint; };
+template <> struct compact_value::tag_of<long int> { static constexpr tag_enum value = t_long; };
+template <> struct compact_value::tag_of<unsigned long int> { static constexpr tag_enum value = t_ulong; };
+template <> struct compact_value::tag_of<long long int> { static constexpr tag_enum value = t_llong; };
+template <> struct compact_value::tag_of<unsigned long long int> { static constexpr tag_enum value = t_ullong; };
+template <> struct compact_value::tag_of<float> { static constexpr tag_enum value = t_float; };
+template <> struct compact_value::tag_of<double> { static constexpr tag_enum value = t_double; };
+
+template <>
+inline bool compact_value::holds<std::string> () const noexcept
+{
+    return is_string();
+}
+
+static_assert(sizeof(compact_string) == 16, "unexpected size of compact_string");
+static_assert(sizeof(compact_value) == 16, "unexpected size of compact_value");
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "compact_value.hpp"
+#include "hash.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define DEBBY__FLAT_HASH_MAP_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Open-addressing hash table with `compact_string` keys (Swiss table layout).
+ *
+ * Slots are grouped by 16, each slot has a control byte: `EMPTY`, `DELETED` or
+ * 7 lower bits of the key hash (H2) if the slot is full. Lookup probes the whole
+ * group at once (with SSE2 if available) comparing H2 against control bytes and
+ * stops at the first group that contains an empty slot. The higher bits of the hash
+ * (H1) select the start group. Probing is quadratic over groups.
+ *
+ * Slots and control bytes are allocated by single block. Capacity is a power of 2,
+ * maximum load factor is 7/8.
+ */
+template <typename Value>
+class flat_hash_map
+{
+public:
+    static constexpr std::size_t GROUP_WIDTH = 16;
+
+private:
+    using ctrl_type = std::int8_t;
+
+    static constexpr ctrl_type EMPTY   = -128; // 0b10000000
+    static constexpr ctrl_type DELETED = -2;   // 0b11111110
+
+    struct slot
+    {
+        compact_string key;
+        Value value;
+    };
+
+    class group
+    {
+#if DEBBY__FLAT_HASH_MAP_SSE2
+        __m128i _ctrl;
+
+    public:
+        explicit group (ctrl_type const * p) noexcept
+            : _ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const *>(p)))
+        {}
+
+        std::uint32_t match (ctrl_type h2) const noexcept
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        // Control bytes of empty and deleted slots have the high bit set
+        std::uint32_t match_empty_or_deleted () const noexcept
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_ctrl));
+        }
+#else
+        ctrl_type _ctrl[GROUP_WIDTH];
+
+    public:
+        explicit group (ctrl_type const * p) noexcept
+        {
+            std::memcpy(_ctrl, p, GROUP_WIDTH);
+        }
+
+        std::uint32_t match (ctrl_type h2) const noexcept
+        {
+            std::uint32_t mask = 0;
+
+            for (std::size_t i = 0; i < GROUP_WIDTH; i++)
+                mask |= static_cast<std::uint32_t>(_ctrl[i] == h2) << i;
+
+            return mask;
+        }
+
+        std::uint32_t match_empty_or_deleted () const noexcept
+        {
+            std::uint32_t mask = 0;
+
+            for (std::size_t i = 0; i < GROUP_WIDTH; i++)
+                mask |= static_cast<std::uint32_t>(_ctrl[i] < 0) << i;
+
+            return mask;
+        }
+#endif
+        std::uint32_t match_empty () const noexcept
+        {
+            return match(EMPTY);
+        }
+    };
+
+private:
+    slot * _slots {nullptr};
+    ctrl_type * _ctrl {nullptr};   // `_capacity + GROUP_WIDTH` bytes, tail clones first bytes
+    std::size_t _capacity {0};     // 0 or power of 2 not less than GROUP_WIDTH
+    std::size_t _size {0};
+    std::size_t _growth_left {0};  // Number of empty slots that can be used before rehash
+
+public:
+    flat_hash_map () noexcept = default;
+
+    flat_hash_map (flat_hash_map && other) noexcept
+    {
+        steal(other);
+    }
+
+    flat_hash_map & operator = (flat_hash_map && other) noexcept
+    {
+        if (this != & other) {
+            destroy();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    flat_hash_map (flat_hash_map const &) = delete;
+    flat_hash_map & operator = (flat_hash_map const &) = delete;
+
+    ~flat_hash_map ()
+    {
+        destroy();
+    }
+
+public:
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    std::size_t capacity () const noexcept
+    {
+        return _capacity;
+    }
+
+    void clear () noexcept
+    {
+        destroy();
+    }
+
+    Value * find (char const * key, std::size_t size) noexcept
+    {
+        auto index = find_index(key, size, hash_bytes(key, size));
+        return index == npos() ? nullptr : & _slots[index].value;
+    }
+
+    Value const * find (char const * key, std::size_t size) const noexcept
+    {
+        return const_cast<flat_hash_map *>(this)->find(key, size);
+    }
+
+    /**
+     * Returns reference to the value associated with @a key, inserting the empty
+     * value if there is no such key.
+     */
+    Value & operator () (char const * key, std::size_t size)
+    {
+        auto h = hash_bytes(key, size);
+        auto index = find_index(key, size, h);
+
+        if (index != npos())
+            return _slots[index].value;
+
+        if (_capacity == 0)
+            grow();
+
+        index = find_insert_slot(h);
+
+        if (_growth_left == 0 && _ctrl[index] == EMPTY) {
+            grow();
+            index = find_insert_slot(h);
+        }
+
+        // The key constructor may throw, the table is not modified yet
+        new (& _slots[index].key) compact_string(key, size);
+        new (& _slots[index].value) Value();
+
+        if (_ctrl[index] == EMPTY)
+            _growth_left--;
+
+        set_ctrl(index, h2(h));
+        _size++;
+
+        return _slots[index].value;
+    }
+
+    bool erase (char const * key, std::size_t size) noexcept
+    {
+        auto index = find_index(key, size, hash_bytes(key, size));
+
+        if (index == npos())
+            return false;
+
+        _slots[index].~slot();
+        set_ctrl(index, DELETED);
+        _size--;
+        return true;
+    }
+
+    /**
+     * Calls @a f (compact_string const & key, Value const & value) for each element
+     * until @a f returns @c false. Order of elements is unspecified.
+     */
+    template <typename F>
+    void for_each (F && f) const
+    {
+        for (std::size_t i = 0; i < _capacity; i++) {
+            if (_ctrl[i] >= 0 && !f(_slots[i].key, _slots[i].value))
+                break;
+        }
+    }
+
+    /**
+     * Calls @a f (compact_string const & key, Value const & value) for each element
+     * which key starts with @a prefix until @a f returns @c false (full scan).
+     */
+    template <typename F>
+    void for_each_prefix (char const * prefix, std::size_t size, F && f) const
+    {
+        for_each([prefix, size, & f] (compact_string const & key, Value const & value) {
+            if (key.size() < size || (size > 0 && std::memcmp(key.data(), prefix, size) != 0))
+                return true;
+
+            return f(key, value);
+        });
+    }
+
+private:
+    static constexpr std::size_t npos () noexcept
+    {
+        return static_cast<std::size_t>(-1);
+    }
+
+    static ctrl_type h2 (std::uint64_t h) noexcept
+    {
+        return static_cast<ctrl_type>(h & 0x7F);
+    }
+
+    static std::size_t h1 (std::uint64_t h) noexcept
+    {
+        return static_cast<std::size_t>(h >> 7);
+    }
+
+    static unsigned lowest_bit (std::uint32_t mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(& index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    static std::size_t growth_limit (std::size_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    void set_ctrl (std::size_t index, ctrl_type c) noexcept
+    {
+        _ctrl[index] = c;
+
+        // Clone first bytes to the tail so the group loaded near the end wraps around
+        if (index < GROUP_WIDTH)
+            _ctrl[_capacity + index] = c;
+    }
+
+    std::size_t find_index (char const * key, std::size_t size, std::uint64_t h) const noexcept
+    {
+        if (_capacity == 0)
+            return npos();
+
+        auto mask = _capacity - 1;
+        auto pos = h1(h) & mask;
+        auto tag = h2(h);
+
+        for (std::size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            group g {_ctrl + pos};
+
+            for (auto m = g.match(tag); m != 0; m &= m - 1) {
+                auto index = (pos + lowest_bit(m)) & mask;
+
+                if (_slots[index].key.equals(key, size))
+                    return index;
+            }
+
+            if (g.match_empty() != 0)
+                return npos();
+
+            pos = (pos + step) & mask;
+        }
+    }
+
+    std::size_t find_insert_slot (std::uint64_t h) const noexcept
+    {
+        auto mask = _capacity - 1;
+        auto pos = h1(h) & mask;
+
+        for (std::size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+            group g {_ctrl + pos};
+            auto m = g.match_empty_or_deleted();
+
+            if (m != 0)
+                return (pos + lowest_bit(m)) & mask;
+
+            pos = (pos + step) & mask;
+        }
+    }
+
+    void grow ()
+    {
+        // Many tombstones: rehash in place (to the same capacity), double otherwise
+        if (_capacity != 0 && _size <= growth_limit(_capacity) / 2)
+            rehash(_capacity);
+        else
+            rehash(_capacity == 0 ? GROUP_WIDTH : _capacity * 2);
+    }
+
+    void rehash (std::size_t new_capacity)
+    {
+        auto old_slots = _slots;
+        auto old_ctrl = _ctrl;
+        auto old_capacity = _capacity;
+
+        allocate(new_capacity);
+
+        for (std::size_t i = 0; i < old_capacity; i++) {
+            if (old_ctrl[i] >= 0) {
+                auto & s = old_slots[i];
+                auto h = hash_bytes(s.key.data(), s.key.size());
+                auto index = find_insert_slot(h);
+
+                new (& _slots[index]) slot {std::move(s.key), std::move(s.value)};
+                set_ctrl(index, h2(h));
+                s.~slot();
+            }
+        }
+
+        _growth_left = growth_limit(_capacity) - _size;
+
+        if (old_slots != nullptr)
+            ::operator delete(old_slots);
+    }
+
+    void allocate (std::size_t capacity)
+    {
+        auto slots_size = capacity * sizeof(slot);
+        auto block = ::operator new(slots_size + capacity + GROUP_WIDTH);
+
+        _slots = static_cast<slot *>(block);
+        _ctrl = reinterpret_cast<ctrl_type *>(static_cast<char *>(block) + slots_size);
+        _capacity = capacity;
+        std::memset(_ctrl, static_cast<unsigned char>(EMPTY), capacity + GROUP_WIDTH);
+    }
+
+    void destroy () noexcept
+    {
+        if (_slots == nullptr)
+            return;
+
+        for (std::size_t i = 0; i < _capacity; i++) {
+            if (_ctrl[i] >= 0)
+                _slots[i].~slot();
+        }
+
+        ::operator delete(_slots);
+
+        _slots = nullptr;
+        _ctrl = nullptr;
+        _capacity = 0;
+        _size = 0;
+        _growth_left = 0;
+    }
+
+    void steal (flat_hash_map & other) noexcept
+    {
+        _slots = other._slots;
+        _ctrl = other._ctrl;
+        _capacity = other._capacity;
+        _size = other._size;
+        _growth_left = other._growth_left;
+
+        other._slots = nullptr;
+        other._ctrl = nullptr;
+        other._capacity = 0;
+        other._size = 0;
+        other._growth_left = 0;
+    }
+};
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/namespace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Hash function for byte strings (64-bit multiply-xorshift with final avalanche).
+ */
+inline std::uint64_t hash_bytes (char const * data, std::size_t size) noexcept
+{
+    constexpr std::uint64_t K = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t h = static_cast<std::uint64_t>(size) * K;
+    std::uint64_t w;
+
+    for (; size >= 8; data += 8, size -= 8) {
+        std::memcpy(& w, data, 8);
+        h = (h ^ w) * K;
+        h ^= h >> 29;
+    }
+
+    if (size > 0) {
+        w = 0;
+        std::memcpy(& w, data, size);
+        h = (h ^ w) * K;
+        h ^= h >> 29;
+    }
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
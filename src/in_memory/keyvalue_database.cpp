@@ -1,16 +1,39 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.04 Initial version.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 Added `remove_many()`.
+//                 Added instrumentation.
+//                 Added `flat_hash_map` backend.
+//                 Added `radix_tree` backend.
+//                 Added `for_each_key()`.
+//                 Added arena allocator support for `map` and `unordered_map` backends.
+//                 Added snapshot save/load for `map` and `unordered_map` backends.
+//                 Added `lru_cache` backend.
+//                 Added `increment()` and `append()`.
+//                 Both 64-bit signed types are counters for `increment()`.
+//                 Added `write_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
+#include "../instrumentation.hpp"
+#include "arena.hpp"
+#include "snapshot_file.hpp"
+#include "debby/in_memory.hpp"
 #include <pfs/assert.hpp>
+#include <pfs/i18n.hpp>
 #include <pfs/variant.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <vector>
 
 #if DEBBY__MAP_ENABLED
 #   include <map>
@@ -20,140 +43,1016 @@
 #   include <unordered_map>
 #endif
 
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+#   include "flat_hash_map.hpp"
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+#   include "radix_tree.hpp"
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+#   include "lru_cache.hpp"
+#endif
+
 DEBBY__NAMESPACE_BEGIN
 
-using unified_value_t = pfs::variant<
-      bool
-    , char
-    , signed char
-    , unsigned char
-    , short int
-    , unsigned short int
-    , int
-    , unsigned int
-    , long int
-    , unsigned long int
-    , long long int
-    , unsigned long long int
-    , float
-    , double
-    , std::string>;
+using unified_value_t = pfs::variant<
+      bool
+    , char
+    , signed char
+    , unsigned char
+    , short int
+    , unsigned short int
+    , int
+    , unsigned int
+    , long int
+    , unsigned long int
+    , long long int
+    , unsigned long long int
+    , float
+    , double
+    , in_memory::arena_string>;
+
+/**
+ * Adds @a delta to the counter stored in @a v if it holds 64-bit signed type @a T (both
+ * `long` and `long long` are counters since `std::int64_t` is one of them depending on
+ * the data model).
+ */
+template <typename T>
+inline std::enable_if_t<sizeof(T) == sizeof(std::int64_t), bool>
+increment_as (unified_value_t & v, std::int64_t delta)
+{
+    if (!pfs::holds_alternative<T>(v))
+        return false;
+
+    auto & counter = pfs::get<T>(v);
+    counter = static_cast<T>(wrapping_add(counter, delta));
+    return true;
+}
+
+template <typename T>
+inline std::enable_if_t<sizeof(T) != sizeof(std::int64_t), bool>
+increment_as (unified_value_t &, std::int64_t)
+{
+    return false;
+}
+
+/**
+ * @return @c false if @a v is not a counter.
+ */
+inline bool increment_counter (unified_value_t & v, std::int64_t delta)
+{
+    return increment_as<long int>(v, delta) || increment_as<long long int>(v, delta);
+}
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED || DEBBY__RADIX_TREE_ENABLED || DEBBY__LRU_CACHE_ENABLED
+template <typename T>
+inline std::enable_if_t<sizeof(T) == sizeof(std::int64_t), bool>
+increment_as (in_memory::compact_value & v, std::int64_t delta)
+{
+    if (!v.holds<T>())
+        return false;
+
+    v.assign(static_cast<T>(wrapping_add(v.get<T>(), delta)));
+    return true;
+}
+
+template <typename T>
+inline std::enable_if_t<sizeof(T) != sizeof(std::int64_t), bool>
+increment_as (in_memory::compact_value &, std::int64_t)
+{
+    return false;
+}
+
+inline bool is_counter (in_memory::compact_value const & v) noexcept
+{
+    return (sizeof(long int) == sizeof(std::int64_t) && v.holds<long int>())
+        || v.holds<long long int>();
+}
+
+inline bool increment_counter (in_memory::compact_value & v, std::int64_t delta)
+{
+    return increment_as<long int>(v, delta) || increment_as<long long int>(v, delta);
+}
+#endif
+
+template <typename T>
+using arena_allocator_t = in_memory::arena_allocator<std::pair<in_memory::arena_string const, T>>;
+
+#if DEBBY__MAP_ENABLED
+using map_container_t = std::map<in_memory::arena_string, unified_value_t, in_memory::key_less
+    , arena_allocator_t<unified_value_t>>;
+#endif
+
+#if DEBBY__UNORDERED_MAP_ENABLED
+using unordered_map_container_t = std::unordered_map<in_memory::arena_string, unified_value_t
+    , in_memory::key_hash, std::equal_to<in_memory::arena_string>, arena_allocator_t<unified_value_t>>;
+#endif
+
+struct lock_guard_stub
+{
+    using mutex_type = bool;
+    lock_guard_stub (bool) {}
+};
+
+using key_visitor_t = std::function<bool (std::string const &)>;
+
+template <typename K, typename P>
+inline bool starts_with (K const & key, P const & prefix) noexcept
+{
+    return key.size() >= prefix.size()
+        && (prefix.size() == 0 || std::memcmp(key.data(), prefix.data(), prefix.size()) == 0);
+}
+
+template <typename K>
+inline std::string to_std_string (K const & s)
+{
+    return std::string(s.data(), s.size());
+}
+
+template <typename Container>
+struct has_transparent_lookup: std::false_type {};
+
+/**
+ * Visits keys starting with @a prefix by full scan (unordered containers).
+ */
+template <typename Container>
+void for_each_prefix (Container const & c, std::string const & prefix, key_visitor_t const & f)
+{
+    for (auto const & item: c) {
+        if (starts_with(item.first, prefix) && !f(to_std_string(item.first)))
+            break;
+    }
+}
+
+#if DEBBY__MAP_ENABLED
+/**
+ * Visits keys starting with @a prefix in key order beginning from the lower bound.
+ */
+template <typename K, typename T, typename A>
+void for_each_prefix (std::map<K, T, in_memory::key_less, A> const & c, std::string const & prefix
+    , key_visitor_t const & f)
+{
+    for (auto pos = c.lower_bound(prefix); pos != c.end() && starts_with(pos->first, prefix); ++pos) {
+        if (!f(to_std_string(pos->first)))
+            break;
+    }
+}
+
+template <typename K, typename T, typename A>
+struct has_transparent_lookup<std::map<K, T, in_memory::key_less, A>>: std::true_type {};
+#endif
+
+template <typename Container>
+void reserve_for (Container & c, std::size_t n)
+{
+    c.reserve(n);
+}
+
+#if DEBBY__MAP_ENABLED
+template <typename K, typename T, typename A>
+void reserve_for (std::map<K, T, in_memory::key_less, A> &, std::size_t)
+{}
+#endif
+
+template <typename Container>
+auto find_key (Container & c, std::string const & key, std::true_type)
+{
+    return c.find(key);
+}
+
+// Temporary key uses the system heap, so lookups never allocate from the arena
+template <typename Container>
+auto find_key (Container & c, std::string const & key, std::false_type)
+{
+    using key_type = typename std::decay_t<Container>::key_type;
+    return c.find(key_type(key.data(), key.size(), typename key_type::allocator_type{}));
+}
+
+template <typename Container>
+auto find_key (Container & c, std::string const & key)
+{
+    return find_key(c, key, has_transparent_lookup<std::decay_t<Container>>{});
+}
+
+template <typename T>
+inline T unwrap (T const & value)
+{
+    return value;
+}
+
+inline std::string unwrap (in_memory::arena_string const & value)
+{
+    return to_std_string(value);
+}
+
+// Number of `unified_value_t` alternatives
+constexpr std::size_t UNIFIED_VALUE_COUNT = 15;
+
+template <std::size_t I>
+using unified_alternative_t = std::decay_t<decltype(pfs::get<I>(std::declval<unified_value_t const &>()))>;
+
+template <std::size_t I = 0>
+std::enable_if_t<(I == UNIFIED_VALUE_COUNT)> snapshot_type_sizes (std::uint8_t *)
+{}
+
+/**
+ * Fills sizes of the value types stored in snapshot (zero for strings).
+ */
+template <std::size_t I = 0>
+std::enable_if_t<(I < UNIFIED_VALUE_COUNT)> snapshot_type_sizes (std::uint8_t * sizes)
+{
+    using T = unified_alternative_t<I>;
+    sizes[I] = static_cast<std::uint8_t>(std::is_arithmetic<T>::value ? sizeof(T) : 0);
+    snapshot_type_sizes<I + 1>(sizes);
+}
+
+template <typename T>
+inline void encode_snapshot_value (in_memory::snapshot_writer & w, T const & value, error * perr)
+{
+    w.append_pod(value, perr);
+}
+
+inline void encode_snapshot_value (in_memory::snapshot_writer & w, in_memory::arena_string const & value
+    , error * perr)
+{
+    w.append_pod(static_cast<std::uint32_t>(value.size()), perr);
+    w.append(value.data(), value.size(), perr);
+}
+
+template <std::size_t I = 0>
+std::enable_if_t<(I == UNIFIED_VALUE_COUNT)>
+encode_snapshot_variant (in_memory::snapshot_writer &, unified_value_t const &, error *)
+{}
+
+template <std::size_t I = 0>
+std::enable_if_t<(I < UNIFIED_VALUE_COUNT)>
+encode_snapshot_variant (in_memory::snapshot_writer & w, unified_value_t const & value, error * perr)
+{
+    if (value.index() == I)
+        encode_snapshot_value(w, pfs::get<I>(value), perr);
+    else
+        encode_snapshot_variant<I + 1>(w, value, perr);
+}
+
+// Decoders return pointer past the decoded value or `nullptr` if data is corrupted
+
+template <typename T>
+char const * decode_snapshot_value (char const * p, char const * end
+    , in_memory::arena_allocator<char> const &, unified_value_t & out, T *)
+{
+    if (static_cast<std::size_t>(end - p) < sizeof(T))
+        return nullptr;
+
+    T value;
+    std::memcpy(& value, p, sizeof(T));
+    out = unified_value_t{value};
+    return p + sizeof(T);
+}
+
+inline char const * decode_snapshot_value (char const * p, char const * end
+    , in_memory::arena_allocator<char> const & alloc, unified_value_t & out, in_memory::arena_string *)
+{
+    std::uint32_t size = 0;
+
+    if (static_cast<std::size_t>(end - p) < sizeof(size))
+        return nullptr;
+
+    std::memcpy(& size, p, sizeof(size));
+    p += sizeof(size);
+
+    if (static_cast<std::size_t>(end - p) < size)
+        return nullptr;
+
+    out = unified_value_t{in_memory::arena_string(p, size, alloc)};
+    return p + size;
+}
+
+template <std::size_t I = 0>
+std::enable_if_t<(I == UNIFIED_VALUE_COUNT), char const *>
+decode_snapshot_variant (std::size_t, char const *, char const *, in_memory::arena_allocator<char> const &
+    , unified_value_t &)
+{
+    return nullptr;
+}
+
+template <std::size_t I = 0>
+std::enable_if_t<(I < UNIFIED_VALUE_COUNT), char const *>
+decode_snapshot_variant (std::size_t index, char const * p, char const * end
+    , in_memory::arena_allocator<char> const & alloc, unified_value_t & out)
+{
+    if (index != I)
+        return decode_snapshot_variant<I + 1>(index, p, end, alloc, out);
+
+    return decode_snapshot_value(p, end, alloc, out, static_cast<unified_alternative_t<I> *>(nullptr));
+}
+
+/**
+ * Key-value database implementation based on standard containers with allocators
+ * bound to the optional per-database arena.
+ */
+template <typename Container, typename Locker>
+class keyvalue_database_impl
+{
+public:
+    using key_type       = std::string;
+    using value_type     = typename Container::mapped_type;
+    using native_type    = Container;
+    using allocator_type = typename Container::allocator_type;
+    using lock_guard     = Locker;
+    using mutex_type     = typename Locker::mutex_type;
+
+protected:
+    mutable mutex_type _mtx;
+    std::unique_ptr<in_memory::arena> _arena; // Must outlive `_dbh`
+    native_type _dbh;
+
+public:
+    keyvalue_database_impl () noexcept = default;
+
+    keyvalue_database_impl (in_memory::arena_options const & opts)
+        : _arena(new in_memory::arena(opts.block_size))
+        , _dbh(allocator_type{_arena.get()})
+    {}
+
+    keyvalue_database_impl (keyvalue_database_impl && other) noexcept
+    {
+        lock_guard locker(other._mtx);
+        _dbh = std::move(other._dbh);
+        _arena = std::move(other._arena);
+    }
+
+    keyvalue_database_impl & operator = (keyvalue_database_impl && other) noexcept
+    {
+        lock_guard locker(other._mtx);
+        _dbh = std::move(other._dbh);
+        _arena = std::move(other._arena);
+        return *this;
+    }
+
+public:
+    void clear ()
+    {
+        lock_guard locker{_mtx};
+
+        if (_arena) {
+            // All nodes, keys and values live in the arena: drop them at once without
+            // walking the container (destructors do not release any other resources).
+            auto alloc = _dbh.get_allocator();
+            _arena->release();
+            new (& _dbh) native_type(alloc);
+        } else {
+            _dbh.clear();
+        }
+    }
+
+    void remove (key_type const & key, error *)
+    {
+        lock_guard locker{_mtx};
+        erase(key);
+    }
+
+    void remove_many (std::vector<key_type> const & keys, error *)
+    {
+        lock_guard locker{_mtx};
+
+        for (auto const & key: keys)
+            erase(key);
+    }
+
+    void for_each_key (key_type const & prefix, key_visitor_t const & f, error *) const
+    {
+        lock_guard locker{_mtx};
+        for_each_prefix(_dbh, prefix, f);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, void>
+    set (key_type const & key, T value, error * /*perr*/ = nullptr)
+    {
+        value_type uv(value);
+
+        lock_guard locker{_mtx};
+        slot(key) = std::move(uv);
+    }
+
+    void set (key_type const & key, char const * data, std::size_t size, error *)
+    {
+        lock_guard locker{_mtx};
+
+        // Attempt to write `null` data interpreted as delete operation for key
+        if (data == nullptr) {
+            erase(key);
+        } else {
+            slot(key) = value_type {in_memory::arena_string(data, size, string_allocator())};
+        }
+    }
+
+    template <typename T>
+    T get (std::string const & key, error * perr) const
+    {
+        using stored_type = typename std::conditional<std::is_same<T, std::string>::value
+            , in_memory::arena_string, T>::type;
+
+        lock_guard locker{_mtx};
+        auto pos = find_key(_dbh, key);
+
+        errc e = errc::success;
+
+        if (pos != _dbh.end()) {
+            if (pfs::holds_alternative<stored_type>(pos->second)) {
+                return unwrap(pfs::get<stored_type>(pos->second));
+            } else {
+                e = errc::bad_value;
+            }
+        } else {
+            e = errc::key_not_found;
+        }
+
+        pfs::throw_or(perr, error {make_error_code(e)});
+        return T{};
+    }
+
+    void increment (key_type const & key, std::int64_t delta, error * perr)
+    {
+        lock_guard locker{_mtx};
+        auto pos = find_key(_dbh, key);
+
+        if (pos == _dbh.end()) {
+            slot(key) = value_type{delta};
+        } else if (!increment_counter(pos->second, delta)) {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+        }
+    }
+
+    void append (key_type const & key, char const * data, std::size_t size, error * perr)
+    {
+        lock_guard locker{_mtx};
+        auto pos = find_key(_dbh, key);
+
+        if (pos == _dbh.end()) {
+            slot(key) = value_type {in_memory::arena_string(data, size, string_allocator())};
+        } else if (pfs::holds_alternative<in_memory::arena_string>(pos->second)) {
+            pfs::get<in_memory::arena_string>(pos->second).append(data, size);
+        } else {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+        }
+    }
+
+    /**
+     * Writes all elements into snapshot (in key order for ordered containers).
+     */
+    bool save (in_memory::snapshot_writer & w, error * perr) const
+    {
+        in_memory::snapshot_header h;
+        std::memset(& h, 0, sizeof(h));
+        std::memcpy(h.magic, in_memory::snapshot_magic(), sizeof(h.magic));
+        h.version = in_memory::snapshot_header::VERSION;
+        h.flags = in_memory::native_byte_order_flags();
+        snapshot_type_sizes(h.type_sizes);
+
+        {
+            lock_guard locker{_mtx};
+            h.count = _dbh.size();
+
+            for (auto const & item: _dbh) {
+                // Write failure
+                if (!w.is_open())
+                    return false;
+
+                auto too_long = item.first.size() > (std::numeric_limits<std::uint32_t>::max)();
+
+                if (!too_long && pfs::holds_alternative<in_memory::arena_string>(item.second)) {
+                    too_long = pfs::get<in_memory::arena_string>(item.second).size()
+                        > (std::numeric_limits<std::uint32_t>::max)();
+                }
+
+                if (too_long) {
+                    pfs::throw_or(perr, error {make_error_code(errc::bad_value)
+                        , tr::_("key or value is too long for snapshot")});
+                    return false;
+                }
+
+                w.append_pod(static_cast<std::uint8_t>(item.second.index()), perr);
+                w.append_pod(static_cast<std::uint32_t>(item.first.size()), perr);
+                w.append(item.first.data(), item.first.size(), perr);
+                encode_snapshot_variant(w, item.second, perr);
+            }
+        }
+
+        return w.commit(h, perr);
+    }
+
+    /**
+     * Bulk loads elements from validated snapshot payload @a p.
+     */
+    bool load (char const * p, in_memory::snapshot_header const & h, pfs::filesystem::path const & path
+        , error * perr)
+    {
+        auto end = p + h.payload_size;
+        auto alloc = string_allocator();
+
+        reserve_for(_dbh, static_cast<std::size_t>(h.count));
+
+        for (std::uint64_t i = 0; i < h.count && p != nullptr; i++) {
+            std::uint8_t index = 0;
+            std::uint32_t key_size = 0;
+
+            if (static_cast<std::size_t>(end - p) < sizeof(index) + sizeof(key_size)) {
+                p = nullptr;
+                break;
+            }
+
+            std::memcpy(& index, p, sizeof(index));
+            std::memcpy(& key_size, p + sizeof(index), sizeof(key_size));
+            p += sizeof(index) + sizeof(key_size);
+
+            if (static_cast<std::size_t>(end - p) < key_size) {
+                p = nullptr;
+                break;
+            }
+
+            typename native_type::key_type key(p, key_size, alloc);
+            value_type value;
+
+            p = decode_snapshot_variant(index, p + key_size, end, alloc, value);
+
+            // Records of ordered container are written in key order, so the hint
+            // makes insertion constant time
+            if (p != nullptr)
+                _dbh.emplace_hint(_dbh.end(), std::move(key), std::move(value));
+        }
+
+        if (p != end) {
+            pfs::throw_or(perr, in_memory::make_snapshot_error(errc::bad_value, path, tr::_("corrupted data")));
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    in_memory::arena_allocator<char> string_allocator () const noexcept
+    {
+        return in_memory::arena_allocator<char>{_dbh.get_allocator()};
+    }
+
+    void erase (key_type const & key)
+    {
+        auto pos = find_key(_dbh, key);
+
+        if (pos != _dbh.end())
+            _dbh.erase(pos);
+    }
+
+    value_type & slot (key_type const & key)
+    {
+        auto pos = find_key(_dbh, key);
+
+        if (pos != _dbh.end())
+            return pos->second;
+
+        return _dbh.emplace(typename native_type::key_type(key.data(), key.size(), string_allocator())
+            , value_type{}).first->second;
+    }
+};
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED || DEBBY__RADIX_TREE_ENABLED
+/**
+ * Key-value database implementation based on containers with `compact_string` keys
+ * and `compact_value` values.
+ */
+template <typename Container, typename Locker>
+class compact_keyvalue_database_impl
+{
+public:
+    using key_type    = std::string;
+    using value_type  = in_memory::compact_value;
+    using native_type = Container;
+    using lock_guard  = Locker;
+    using mutex_type  = typename Locker::mutex_type;
+
+protected:
+    mutable mutex_type _mtx;
+    native_type _dbh;
+
+public:
+    compact_keyvalue_database_impl () noexcept = default;
+
+    compact_keyvalue_database_impl (compact_keyvalue_database_impl && other) noexcept
+    {
+        lock_guard locker(other._mtx);
+        _dbh = std::move(other._dbh);
+    }
+
+    compact_keyvalue_database_impl & operator = (compact_keyvalue_database_impl && other) noexcept
+    {
+        lock_guard locker(other._mtx);
+        _dbh = std::move(other._dbh);
+        return *this;
+    }
+
+public:
+    void clear ()
+    {
+        lock_guard locker{_mtx};
+        _dbh.clear();
+    }
+
+    void remove (key_type const & key, error *)
+    {
+        lock_guard locker{_mtx};
+        _dbh.erase(key.data(), key.size());
+    }
+
+    void remove_many (std::vector<key_type> const & keys, error *)
+    {
+        lock_guard locker{_mtx};
+
+        for (auto const & key: keys)
+            _dbh.erase(key.data(), key.size());
+    }
+
+    void for_each_key (key_type const & prefix, key_visitor_t const & f, error *) const
+    {
+        lock_guard locker{_mtx};
+
+        _dbh.for_each_prefix(prefix.data(), prefix.size()
+            , [& f] (in_memory::compact_string const & key, value_type const &) {
+                return f(key.str());
+            });
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, void>
+    set (key_type const & key, T value, error * /*perr*/ = nullptr)
+    {
+        lock_guard locker{_mtx};
+        _dbh(key.data(), key.size()).assign(value);
+    }
+
+    void set (key_type const & key, char const * data, std::size_t size, error *)
+    {
+        lock_guard locker{_mtx};
+
+        // Attempt to write `null` data interpreted as delete operation for key
+        if (data == nullptr)
+            _dbh.erase(key.data(), key.size());
+        else
+            set_locked(key, data, size);
+    }
+
+    void increment (key_type const & key, std::int64_t delta, error * perr)
+    {
+        lock_guard locker{_mtx};
+        auto v = _dbh.find(key.data(), key.size());
+
+        if (v == nullptr)
+            _dbh(key.data(), key.size()).assign(delta);
+        else if (!increment_counter(*v, delta))
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+    }
+
+    void append (key_type const & key, char const * data, std::size_t size, error * perr)
+    {
+        lock_guard locker{_mtx};
+        auto v = _dbh.find(key.data(), key.size());
+
+        if (v == nullptr) {
+            set_locked(key, data, size);
+        } else if (v->is_string()) {
+            auto value = v->str();
+            value.append(data, size);
+            v->assign(value.data(), value.size());
+        } else {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+        }
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, T>
+    get (std::string const & key, error * perr) const
+    {
+        lock_guard locker{_mtx};
+        auto v = _dbh.find(key.data(), key.size());
+        auto e = v == nullptr ? errc::key_not_found : v->template holds<T>() ? errc::success : errc::bad_value;
+
+        if (e == errc::success)
+            return v->template get<T>();
+
+        pfs::throw_or(perr, error {make_error_code(e)});
+        return T{};
+    }
 
-struct lock_guard_stub
-{
-    using mutex_type = bool;
-    lock_guard_stub (bool) {}
+    template <typename T>
+    std::enable_if_t<std::is_same<T, std::string>::value, T>
+    get (std::string const & key, error * perr) const
+    {
+        lock_guard locker{_mtx};
+        auto v = _dbh.find(key.data(), key.size());
+        auto e = v == nullptr ? errc::key_not_found : v->is_string() ? errc::success : errc::bad_value;
+
+        if (e == errc::success)
+            return v->str();
+
+        pfs::throw_or(perr, error {make_error_code(e)});
+        return T{};
+    }
+
+private:
+    void set_locked (key_type const & key, char const * data, std::size_t size)
+    {
+        auto & v = _dbh(key.data(), key.size());
+
+        // Keep newly inserted entry from being left empty on allocation failure
+        try {
+            v.assign(data, size);
+        } catch (...) {
+            if (v.tag() == value_type::t_empty)
+                _dbh.erase(key.data(), key.size());
+
+            throw;
+        }
+    }
 };
 
-template <typename Container, typename Locker>
-class keyvalue_database_impl
+#endif
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+template <>
+class keyvalue_database<backend_enum::flat_hash_map_st>::impl
+    : public compact_keyvalue_database_impl<in_memory::flat_hash_map<in_memory::compact_value>, lock_guard_stub>
+{};
+
+template <>
+class keyvalue_database<backend_enum::flat_hash_map_mt>::impl
+    : public compact_keyvalue_database_impl<in_memory::flat_hash_map<in_memory::compact_value>, std::lock_guard<std::mutex>>
+{};
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+template <>
+class keyvalue_database<backend_enum::radix_tree_st>::impl
+    : public compact_keyvalue_database_impl<in_memory::radix_tree<in_memory::compact_value>, lock_guard_stub>
+{};
+
+template <>
+class keyvalue_database<backend_enum::radix_tree_mt>::impl
+    : public compact_keyvalue_database_impl<in_memory::radix_tree<in_memory::compact_value>, std::lock_guard<std::mutex>>
+{};
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+/**
+ * Memory-bounded cache implementation based on segmented LRU with `compact_value`
+ * values.
+ */
+template <typename Locker>
+class cache_keyvalue_database_impl
 {
 public:
-    using key_type    = typename Container::key_type;
-    using value_type  = typename Container::mapped_type;
-    using native_type = Container;
+    using key_type    = std::string;
+    using value_type  = in_memory::compact_value;
+    using native_type = in_memory::lru_cache<value_type>;
+    using clock_type  = native_type::clock_type;
+    using time_point  = native_type::time_point;
     using lock_guard  = Locker;
     using mutex_type  = typename Locker::mutex_type;
 
 protected:
     mutable mutex_type _mtx;
-    native_type _dbh;
+    mutable native_type _dbh; // Lookups update recency and counters
+    clock_type::duration _default_ttl {0};
 
 public:
-    keyvalue_database_impl () noexcept = default;
+    cache_keyvalue_database_impl ()
+        : cache_keyvalue_database_impl(in_memory::cache_options{})
+    {}
 
-    keyvalue_database_impl (keyvalue_database_impl && other) noexcept
+    cache_keyvalue_database_impl (in_memory::cache_options const & opts)
+        : _dbh(opts.capacity, opts.capacity / 100 * (opts.protected_percent < 100 ? opts.protected_percent : 100))
+        , _default_ttl(opts.default_ttl)
+    {}
+
+    cache_keyvalue_database_impl (cache_keyvalue_database_impl && other) noexcept
+        : _dbh(0, 0)
     {
         lock_guard locker(other._mtx);
         _dbh = std::move(other._dbh);
+        _default_ttl = other._default_ttl;
     }
 
-    keyvalue_database_impl & operator = (keyvalue_database_impl && other) noexcept
+    cache_keyvalue_database_impl & operator = (cache_keyvalue_database_impl && other) noexcept
     {
         lock_guard locker(other._mtx);
         _dbh = std::move(other._dbh);
+        _default_ttl = other._default_ttl;
         return *this;
     }
 
 public:
     void clear ()
     {
+        lock_guard locker{_mtx};
         _dbh.clear();
     }
 
     void remove (key_type const & key, error *)
     {
         lock_guard locker{_mtx};
-        _dbh.erase(key);
+        _dbh.erase(key.data(), key.size());
+    }
+
+    void remove_many (std::vector<key_type> const & keys, error *)
+    {
+        lock_guard locker{_mtx};
+
+        for (auto const & key: keys)
+            _dbh.erase(key.data(), key.size());
+    }
+
+    void for_each_key (key_type const & prefix, key_visitor_t const & f, error *) const
+    {
+        lock_guard locker{_mtx};
+
+        _dbh.for_each_prefix(prefix.data(), prefix.size(), clock_type::now()
+            , [& f] (in_memory::compact_string const & key, value_type const &) {
+                return f(key.str());
+            });
     }
 
     template <typename T>
     std::enable_if_t<std::is_arithmetic<T>::value, void>
     set (key_type const & key, T value, error * /*perr*/ = nullptr)
     {
-        value_type uv(value);
+        auto expires = expiration(_default_ttl);
 
         lock_guard locker{_mtx};
-        _dbh[key] = std::move(uv);
+        _dbh.assign(key.data(), key.size(), expires, [value] (value_type & v) { v.assign(value); });
     }
 
-    void set (key_type const & key, char const * data, std::size_t size, error * perr)
+    void set (key_type const & key, char const * data, std::size_t size, error *)
     {
+        auto expires = expiration(_default_ttl);
+
         lock_guard locker{_mtx};
 
         // Attempt to write `null` data interpreted as delete operation for key
-        if (data == nullptr) {
-            remove(key, perr);
-        } else {
-            _dbh[key] = value_type {std::string(data, size)};
-        }
+        if (data == nullptr)
+            _dbh.erase(key.data(), key.size());
+        else
+            _dbh.assign(key.data(), key.size(), expires, [data, size] (value_type & v) { v.assign(data, size); });
     }
 
     template <typename T>
-    T get (std::string const & key, error * perr) const
+    std::enable_if_t<std::is_arithmetic<T>::value, T>
+    get (std::string const & key, error * perr) const
     {
+        auto now = clock_type::now();
+
         lock_guard locker{_mtx};
-        auto pos = _dbh.find(key);
+        auto v = _dbh.find(key.data(), key.size(), now);
+        auto e = v == nullptr ? errc::key_not_found : v->template holds<T>() ? errc::success : errc::bad_value;
 
-        errc e = errc::success;
+        if (e == errc::success)
+            return v->template get<T>();
 
-        if (pos != _dbh.end()) {
-            if (pfs::holds_alternative<T>(pos->second)) {
-                return pfs::get<T>(pos->second);
-            } else {
-                e = errc::bad_value;
-            }
-        } else {
-            e = errc::key_not_found;
-        }
+        pfs::throw_or(perr, error {make_error_code(e)});
+        return T{};
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_same<T, std::string>::value, T>
+    get (std::string const & key, error * perr) const
+    {
+        auto now = clock_type::now();
+
+        lock_guard locker{_mtx};
+        auto v = _dbh.find(key.data(), key.size(), now);
+        auto e = v == nullptr ? errc::key_not_found : v->is_string() ? errc::success : errc::bad_value;
+
+        if (e == errc::success)
+            return v->str();
 
         pfs::throw_or(perr, error {make_error_code(e)});
         return T{};
     }
+
+    void increment (key_type const & key, std::int64_t delta, error * perr)
+    {
+        auto now = clock_type::now();
+        auto expires = expiration(_default_ttl);
+
+        lock_guard locker{_mtx};
+        auto v = _dbh.peek(key.data(), key.size(), now);
+
+        if (v != nullptr && !is_counter(*v)) {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+            return;
+        }
+
+        _dbh.assign(key.data(), key.size(), expires, [delta] (value_type & v) {
+            if (v.tag() == value_type::t_empty)
+                v.assign(delta);
+            else
+                increment_counter(v, delta);
+        });
+    }
+
+    void append (key_type const & key, char const * data, std::size_t size, error * perr)
+    {
+        auto now = clock_type::now();
+        auto expires = expiration(_default_ttl);
+
+        lock_guard locker{_mtx};
+        auto v = _dbh.peek(key.data(), key.size(), now);
+
+        if (v != nullptr && !v->is_string()) {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+            return;
+        }
+
+        _dbh.assign(key.data(), key.size(), expires, [data, size] (value_type & v) {
+            auto value = v.is_string() ? v.str() : std::string{};
+            value.append(data, size);
+            v.assign(value.data(), value.size());
+        });
+    }
+
+    in_memory::cache_stats stats () const
+    {
+        lock_guard locker{_mtx};
+        return _dbh.stats();
+    }
+
+    bool expire (key_type const & key, std::chrono::milliseconds ttl)
+    {
+        auto expires = expiration(ttl);
+
+        lock_guard locker{_mtx};
+        return _dbh.expire(key.data(), key.size(), expires);
+    }
+
+private:
+    template <typename Duration>
+    static time_point expiration (Duration ttl) noexcept
+    {
+        return ttl == Duration::zero() ? (time_point::max)() : clock_type::now() + ttl;
+    }
+};
+
+template <>
+class keyvalue_database<backend_enum::lru_cache_st>::impl
+    : public cache_keyvalue_database_impl<lock_guard_stub>
+{
+public:
+    using cache_keyvalue_database_impl::cache_keyvalue_database_impl;
 };
 
+template <>
+class keyvalue_database<backend_enum::lru_cache_mt>::impl
+    : public cache_keyvalue_database_impl<std::lock_guard<std::mutex>>
+{
+public:
+    using cache_keyvalue_database_impl::cache_keyvalue_database_impl;
+};
+#endif
+
 #if DEBBY__MAP_ENABLED
 template <>
 class keyvalue_database<backend_enum::map_st>::impl
-    : public keyvalue_database_impl<std::map<std::string, unified_value_t>, lock_guard_stub>
-{};
+    : public keyvalue_database_impl<map_container_t, lock_guard_stub>
+{
+public:
+    using keyvalue_database_impl::keyvalue_database_impl;
+};
 
 template <>
 class keyvalue_database<backend_enum::map_mt>::impl
-    : public keyvalue_database_impl<std::map<std::string, unified_value_t>, std::lock_guard<std::mutex>>
-{};
+    : public keyvalue_database_impl<map_container_t, std::lock_guard<std::mutex>>
+{
+public:
+    using keyvalue_database_impl::keyvalue_database_impl;
+};
 #endif
 
 #if DEBBY__UNORDERED_MAP_ENABLED
 template <>
 class keyvalue_database<backend_enum::unordered_map_st>::impl
-    : public keyvalue_database_impl<std::unordered_map<std::string, unified_value_t>, lock_guard_stub>
-{};
+    : public keyvalue_database_impl<unordered_map_container_t, lock_guard_stub>
+{
+public:
+    using keyvalue_database_impl::keyvalue_database_impl;
+};
 
 template <>
 class keyvalue_database<backend_enum::unordered_map_mt>::impl
-    : public keyvalue_database_impl<std::unordered_map<std::string, unified_value_t>, std::lock_guard<std::mutex>>
-{};
+    : public keyvalue_database_impl<unordered_map_container_t, std::lock_guard<std::mutex>>
+{
+public:
+    using keyvalue_database_impl::keyvalue_database_impl;
+};
 #endif
 
 template <backend_enum Backend>
@@ -166,14 +1065,54 @@ void keyvalue_database<Backend>::clear (error *)
 template <backend_enum Backend>
 void keyvalue_database<Backend>::remove (key_type const & key, error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_remove, 0, 0);
+
     if (_d != nullptr)
         _d->remove(key, perr);
 }
 
+template <backend_enum Backend>
+void keyvalue_database<Backend>::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    if (_d != nullptr)
+        _d->remove_many(keys, perr);
+}
+
+// Each write is atomic, no commit is required
+template <backend_enum Backend>
+void keyvalue_database<Backend>::write_batch (std::function<void ()> const & f, error *)
+{
+    f();
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const
+{
+    if (_d != nullptr)
+        _d->for_each_key(prefix, f, perr);
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::increment (key_type const & key, std::int64_t delta, error * perr)
+{
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, sizeof(delta));
+    _d->increment(key, delta, perr);
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::append (key_type const & key, char const * data, std::size_t len
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, len);
+    _d->append(key, data, len, perr);
+}
+
 template <backend_enum Backend>
 void keyvalue_database<Backend>::set (key_type const & key, char const * value, std::size_t len
     , error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, len);
     _d->set(key, value, len, perr);
 }
 
@@ -182,6 +1121,7 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, void>
 keyvalue_database<Backend>::set (key_type const & key, T value, error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, sizeof(T));
     _d->template set<T>(key, value, perr);
 }
 
@@ -190,7 +1130,10 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value || std::is_same<std::decay_t<T>, std::string>::value, std::decay_t<T>>
 keyvalue_database<Backend>::get (key_type const & key, error * perr) const
 {
-    return _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT(Backend, kv_get, 0, 0);
+    auto result = _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
 }
 
 namespace in_memory {
@@ -201,24 +1144,147 @@ keyvalue_database<Backend> make_kv (error *)
     return keyvalue_database<Backend> {typename keyvalue_database<Backend>::impl{}};
 }
 
+template <backend_enum Backend>
+keyvalue_database<Backend> make_kv (arena_options const & opts, error *)
+{
+    return keyvalue_database<Backend> {typename keyvalue_database<Backend>::impl{opts}};
+}
+
 template <backend_enum Backend>
 bool wipe (error *)
 {
     return true;
 }
 
+template <backend_enum Backend>
+keyvalue_database<Backend> make_kv (cache_options const & opts, error *)
+{
+    return keyvalue_database<Backend> {typename keyvalue_database<Backend>::impl{opts}};
+}
+
+template <backend_enum Backend>
+cache_stats stats (keyvalue_database<Backend> const & db)
+{
+    auto d = db.backend_impl();
+    return d == nullptr ? cache_stats{} : d->stats();
+}
+
+template <backend_enum Backend>
+bool expire (keyvalue_database<Backend> & db, std::string const & key, std::chrono::milliseconds ttl)
+{
+    auto d = db.backend_impl();
+    return d != nullptr && d->expire(key, ttl);
+}
+
+template <backend_enum Backend>
+bool save (keyvalue_database<Backend> const & db, pfs::filesystem::path const & path, error * perr)
+{
+    auto d = db.backend_impl();
+
+    if (d == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return false;
+    }
+
+    snapshot_writer w {path, perr};
+
+    if (!w.is_open())
+        return false;
+
+    return d->save(w, perr);
+}
+
+template <backend_enum Backend>
+static keyvalue_database<Backend> load_impl (typename keyvalue_database<Backend>::impl && d
+    , pfs::filesystem::path const & path, error * perr)
+{
+    error err;
+    mapped_file f {path, & err};
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return keyvalue_database<Backend>{};
+    }
+
+    std::uint8_t type_sizes[sizeof(snapshot_header::type_sizes)] = {0};
+    snapshot_type_sizes(type_sizes);
+
+    snapshot_header h;
+    auto payload = validate_snapshot(f, path, snapshot_magic(), type_sizes, h, perr);
+
+    if (payload == nullptr || !d.load(payload, h, path, perr))
+        return keyvalue_database<Backend>{};
+
+    return keyvalue_database<Backend> {std::move(d)};
+}
+
+template <backend_enum Backend>
+keyvalue_database<Backend> load (pfs::filesystem::path const & path, error * perr)
+{
+    return load_impl<Backend>(typename keyvalue_database<Backend>::impl{}, path, perr);
+}
+
+template <backend_enum Backend>
+keyvalue_database<Backend> load (pfs::filesystem::path const & path, arena_options const & opts, error * perr)
+{
+    return load_impl<Backend>(typename keyvalue_database<Backend>::impl{opts}, path, perr);
+}
+
 #if DEBBY__MAP_ENABLED
 template DEBBY__EXPORT keyvalue_database<backend_enum::map_st> make_kv<backend_enum::map_st> (error *);
 template DEBBY__EXPORT keyvalue_database<backend_enum::map_mt> make_kv<backend_enum::map_mt> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_st> make_kv<backend_enum::map_st> (arena_options const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_mt> make_kv<backend_enum::map_mt> (arena_options const &, error *);
 template DEBBY__EXPORT bool wipe<backend_enum::map_st> (error *);
 template DEBBY__EXPORT bool wipe<backend_enum::map_mt> (error *);
+template DEBBY__EXPORT bool save<backend_enum::map_st> (keyvalue_database<backend_enum::map_st> const &, pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT bool save<backend_enum::map_mt> (keyvalue_database<backend_enum::map_mt> const &, pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_st> load<backend_enum::map_st> (pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_st> load<backend_enum::map_st> (pfs::filesystem::path const &, arena_options const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_mt> load<backend_enum::map_mt> (pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::map_mt> load<backend_enum::map_mt> (pfs::filesystem::path const &, arena_options const &, error *);
 #endif
 
 #if DEBBY__UNORDERED_MAP_ENABLED
 template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_st> make_kv<backend_enum::unordered_map_st> (error *);
 template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_mt> make_kv<backend_enum::unordered_map_mt> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_st> make_kv<backend_enum::unordered_map_st> (arena_options const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_mt> make_kv<backend_enum::unordered_map_mt> (arena_options const &, error *);
 template DEBBY__EXPORT bool wipe<backend_enum::unordered_map_st> (error *);
 template DEBBY__EXPORT bool wipe<backend_enum::unordered_map_mt> (error *);
+template DEBBY__EXPORT bool save<backend_enum::unordered_map_st> (keyvalue_database<backend_enum::unordered_map_st> const &, pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT bool save<backend_enum::unordered_map_mt> (keyvalue_database<backend_enum::unordered_map_mt> const &, pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_st> load<backend_enum::unordered_map_st> (pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_st> load<backend_enum::unordered_map_st> (pfs::filesystem::path const &, arena_options const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_mt> load<backend_enum::unordered_map_mt> (pfs::filesystem::path const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::unordered_map_mt> load<backend_enum::unordered_map_mt> (pfs::filesystem::path const &, arena_options const &, error *);
+#endif
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+template DEBBY__EXPORT keyvalue_database<backend_enum::flat_hash_map_st> make_kv<backend_enum::flat_hash_map_st> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::flat_hash_map_mt> make_kv<backend_enum::flat_hash_map_mt> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::flat_hash_map_st> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::flat_hash_map_mt> (error *);
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+template DEBBY__EXPORT keyvalue_database<backend_enum::radix_tree_st> make_kv<backend_enum::radix_tree_st> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::radix_tree_mt> make_kv<backend_enum::radix_tree_mt> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::radix_tree_st> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::radix_tree_mt> (error *);
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+template DEBBY__EXPORT keyvalue_database<backend_enum::lru_cache_st> make_kv<backend_enum::lru_cache_st> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::lru_cache_mt> make_kv<backend_enum::lru_cache_mt> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::lru_cache_st> (error *);
+template DEBBY__EXPORT bool wipe<backend_enum::lru_cache_mt> (error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::lru_cache_st> make_kv<backend_enum::lru_cache_st> (cache_options const &, error *);
+template DEBBY__EXPORT keyvalue_database<backend_enum::lru_cache_mt> make_kv<backend_enum::lru_cache_mt> (cache_options const &, error *);
+template DEBBY__EXPORT cache_stats stats<backend_enum::lru_cache_st> (keyvalue_database<backend_enum::lru_cache_st> const &);
+template DEBBY__EXPORT cache_stats stats<backend_enum::lru_cache_mt> (keyvalue_database<backend_enum::lru_cache_mt> const &);
+template DEBBY__EXPORT bool expire<backend_enum::lru_cache_st> (keyvalue_database<backend_enum::lru_cache_st> &, std::string const &, std::chrono::milliseconds);
+template DEBBY__EXPORT bool expire<backend_enum::lru_cache_mt> (keyvalue_database<backend_enum::lru_cache_mt> &, std::string const &, std::chrono::milliseconds);
 #endif
 
 } // namespace in_memory
@@ -383,4 +1449,244 @@ DEBBY__UNORDEREDMAP_MT_GET(std::string)
 
 #endif
 
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+template class keyvalue_database<backend_enum::flat_hash_map_st>;
+template class keyvalue_database<backend_enum::flat_hash_map_mt>;
+
+#define DEBBY__FLAT_HASH_MAP_ST_SET(t) \
+    template void keyvalue_database<backend_enum::flat_hash_map_st>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__FLAT_HASH_MAP_ST_GET(t) \
+    template t keyvalue_database<backend_enum::flat_hash_map_st>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__FLAT_HASH_MAP_ST_SET(bool)
+DEBBY__FLAT_HASH_MAP_ST_SET(char)
+DEBBY__FLAT_HASH_MAP_ST_SET(signed char)
+DEBBY__FLAT_HASH_MAP_ST_SET(unsigned char)
+DEBBY__FLAT_HASH_MAP_ST_SET(short int)
+DEBBY__FLAT_HASH_MAP_ST_SET(unsigned short int)
+DEBBY__FLAT_HASH_MAP_ST_SET(int)
+DEBBY__FLAT_HASH_MAP_ST_SET(unsigned int)
+DEBBY__FLAT_HASH_MAP_ST_SET(long int)
+DEBBY__FLAT_HASH_MAP_ST_SET(unsigned long int)
+DEBBY__FLAT_HASH_MAP_ST_SET(long long int)
+DEBBY__FLAT_HASH_MAP_ST_SET(unsigned long long int)
+DEBBY__FLAT_HASH_MAP_ST_SET(float)
+DEBBY__FLAT_HASH_MAP_ST_SET(double)
+
+DEBBY__FLAT_HASH_MAP_ST_GET(bool)
+DEBBY__FLAT_HASH_MAP_ST_GET(char)
+DEBBY__FLAT_HASH_MAP_ST_GET(signed char)
+DEBBY__FLAT_HASH_MAP_ST_GET(unsigned char)
+DEBBY__FLAT_HASH_MAP_ST_GET(short int)
+DEBBY__FLAT_HASH_MAP_ST_GET(unsigned short int)
+DEBBY__FLAT_HASH_MAP_ST_GET(int)
+DEBBY__FLAT_HASH_MAP_ST_GET(unsigned int)
+DEBBY__FLAT_HASH_MAP_ST_GET(long int)
+DEBBY__FLAT_HASH_MAP_ST_GET(unsigned long int)
+DEBBY__FLAT_HASH_MAP_ST_GET(long long int)
+DEBBY__FLAT_HASH_MAP_ST_GET(unsigned long long int)
+DEBBY__FLAT_HASH_MAP_ST_GET(float)
+DEBBY__FLAT_HASH_MAP_ST_GET(double)
+DEBBY__FLAT_HASH_MAP_ST_GET(std::string)
+
+#define DEBBY__FLAT_HASH_MAP_MT_SET(t) \
+    template void keyvalue_database<backend_enum::flat_hash_map_mt>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__FLAT_HASH_MAP_MT_GET(t) \
+    template t keyvalue_database<backend_enum::flat_hash_map_mt>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__FLAT_HASH_MAP_MT_SET(bool)
+DEBBY__FLAT_HASH_MAP_MT_SET(char)
+DEBBY__FLAT_HASH_MAP_MT_SET(signed char)
+DEBBY__FLAT_HASH_MAP_MT_SET(unsigned char)
+DEBBY__FLAT_HASH_MAP_MT_SET(short int)
+DEBBY__FLAT_HASH_MAP_MT_SET(unsigned short int)
+DEBBY__FLAT_HASH_MAP_MT_SET(int)
+DEBBY__FLAT_HASH_MAP_MT_SET(unsigned int)
+DEBBY__FLAT_HASH_MAP_MT_SET(long int)
+DEBBY__FLAT_HASH_MAP_MT_SET(unsigned long int)
+DEBBY__FLAT_HASH_MAP_MT_SET(long long int)
+DEBBY__FLAT_HASH_MAP_MT_SET(unsigned long long int)
+DEBBY__FLAT_HASH_MAP_MT_SET(float)
+DEBBY__FLAT_HASH_MAP_MT_SET(double)
+
+DEBBY__FLAT_HASH_MAP_MT_GET(bool)
+DEBBY__FLAT_HASH_MAP_MT_GET(char)
+DEBBY__FLAT_HASH_MAP_MT_GET(signed char)
+DEBBY__FLAT_HASH_MAP_MT_GET(unsigned char)
+DEBBY__FLAT_HASH_MAP_MT_GET(short int)
+DEBBY__FLAT_HASH_MAP_MT_GET(unsigned short int)
+DEBBY__FLAT_HASH_MAP_MT_GET(int)
+DEBBY__FLAT_HASH_MAP_MT_GET(unsigned int)
+DEBBY__FLAT_HASH_MAP_MT_GET(long int)
+DEBBY__FLAT_HASH_MAP_MT_GET(unsigned long int)
+DEBBY__FLAT_HASH_MAP_MT_GET(long long int)
+DEBBY__FLAT_HASH_MAP_MT_GET(unsigned long long int)
+DEBBY__FLAT_HASH_MAP_MT_GET(float)
+DEBBY__FLAT_HASH_MAP_MT_GET(double)
+DEBBY__FLAT_HASH_MAP_MT_GET(std::string)
+
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+template class keyvalue_database<backend_enum::radix_tree_st>;
+template class keyvalue_database<backend_enum::radix_tree_mt>;
+
+#define DEBBY__RADIX_TREE_ST_SET(t) \
+    template void keyvalue_database<backend_enum::radix_tree_st>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__RADIX_TREE_ST_GET(t) \
+    template t keyvalue_database<backend_enum::radix_tree_st>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__RADIX_TREE_ST_SET(bool)
+DEBBY__RADIX_TREE_ST_SET(char)
+DEBBY__RADIX_TREE_ST_SET(signed char)
+DEBBY__RADIX_TREE_ST_SET(unsigned char)
+DEBBY__RADIX_TREE_ST_SET(short int)
+DEBBY__RADIX_TREE_ST_SET(unsigned short int)
+DEBBY__RADIX_TREE_ST_SET(int)
+DEBBY__RADIX_TREE_ST_SET(unsigned int)
+DEBBY__RADIX_TREE_ST_SET(long int)
+DEBBY__RADIX_TREE_ST_SET(unsigned long int)
+DEBBY__RADIX_TREE_ST_SET(long long int)
+DEBBY__RADIX_TREE_ST_SET(unsigned long long int)
+DEBBY__RADIX_TREE_ST_SET(float)
+DEBBY__RADIX_TREE_ST_SET(double)
+
+DEBBY__RADIX_TREE_ST_GET(bool)
+DEBBY__RADIX_TREE_ST_GET(char)
+DEBBY__RADIX_TREE_ST_GET(signed char)
+DEBBY__RADIX_TREE_ST_GET(unsigned char)
+DEBBY__RADIX_TREE_ST_GET(short int)
+DEBBY__RADIX_TREE_ST_GET(unsigned short int)
+DEBBY__RADIX_TREE_ST_GET(int)
+DEBBY__RADIX_TREE_ST_GET(unsigned int)
+DEBBY__RADIX_TREE_ST_GET(long int)
+DEBBY__RADIX_TREE_ST_GET(unsigned long int)
+DEBBY__RADIX_TREE_ST_GET(long long int)
+DEBBY__RADIX_TREE_ST_GET(unsigned long long int)
+DEBBY__RADIX_TREE_ST_GET(float)
+DEBBY__RADIX_TREE_ST_GET(double)
+DEBBY__RADIX_TREE_ST_GET(std::string)
+
+#define DEBBY__RADIX_TREE_MT_SET(t) \
+    template void keyvalue_database<backend_enum::radix_tree_mt>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__RADIX_TREE_MT_GET(t) \
+    template t keyvalue_database<backend_enum::radix_tree_mt>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__RADIX_TREE_MT_SET(bool)
+DEBBY__RADIX_TREE_MT_SET(char)
+DEBBY__RADIX_TREE_MT_SET(signed char)
+DEBBY__RADIX_TREE_MT_SET(unsigned char)
+DEBBY__RADIX_TREE_MT_SET(short int)
+DEBBY__RADIX_TREE_MT_SET(unsigned short int)
+DEBBY__RADIX_TREE_MT_SET(int)
+DEBBY__RADIX_TREE_MT_SET(unsigned int)
+DEBBY__RADIX_TREE_MT_SET(long int)
+DEBBY__RADIX_TREE_MT_SET(unsigned long int)
+DEBBY__RADIX_TREE_MT_SET(long long int)
+DEBBY__RADIX_TREE_MT_SET(unsigned long long int)
+DEBBY__RADIX_TREE_MT_SET(float)
+DEBBY__RADIX_TREE_MT_SET(double)
+
+DEBBY__RADIX_TREE_MT_GET(bool)
+DEBBY__RADIX_TREE_MT_GET(char)
+DEBBY__RADIX_TREE_MT_GET(signed char)
+DEBBY__RADIX_TREE_MT_GET(unsigned char)
+DEBBY__RADIX_TREE_MT_GET(short int)
+DEBBY__RADIX_TREE_MT_GET(unsigned short int)
+DEBBY__RADIX_TREE_MT_GET(int)
+DEBBY__RADIX_TREE_MT_GET(unsigned int)
+DEBBY__RADIX_TREE_MT_GET(long int)
+DEBBY__RADIX_TREE_MT_GET(unsigned long int)
+DEBBY__RADIX_TREE_MT_GET(long long int)
+DEBBY__RADIX_TREE_MT_GET(unsigned long long int)
+DEBBY__RADIX_TREE_MT_GET(float)
+DEBBY__RADIX_TREE_MT_GET(double)
+DEBBY__RADIX_TREE_MT_GET(std::string)
+
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+template class keyvalue_database<backend_enum::lru_cache_st>;
+template class keyvalue_database<backend_enum::lru_cache_mt>;
+
+#define DEBBY__LRU_CACHE_ST_SET(t) \
+    template void keyvalue_database<backend_enum::lru_cache_st>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__LRU_CACHE_ST_GET(t) \
+    template t keyvalue_database<backend_enum::lru_cache_st>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__LRU_CACHE_ST_SET(bool)
+DEBBY__LRU_CACHE_ST_SET(char)
+DEBBY__LRU_CACHE_ST_SET(signed char)
+DEBBY__LRU_CACHE_ST_SET(unsigned char)
+DEBBY__LRU_CACHE_ST_SET(short int)
+DEBBY__LRU_CACHE_ST_SET(unsigned short int)
+DEBBY__LRU_CACHE_ST_SET(int)
+DEBBY__LRU_CACHE_ST_SET(unsigned int)
+DEBBY__LRU_CACHE_ST_SET(long int)
+DEBBY__LRU_CACHE_ST_SET(unsigned long int)
+DEBBY__LRU_CACHE_ST_SET(long long int)
+DEBBY__LRU_CACHE_ST_SET(unsigned long long int)
+DEBBY__LRU_CACHE_ST_SET(float)
+DEBBY__LRU_CACHE_ST_SET(double)
+
+DEBBY__LRU_CACHE_ST_GET(bool)
+DEBBY__LRU_CACHE_ST_GET(char)
+DEBBY__LRU_CACHE_ST_GET(signed char)
+DEBBY__LRU_CACHE_ST_GET(unsigned char)
+DEBBY__LRU_CACHE_ST_GET(short int)
+DEBBY__LRU_CACHE_ST_GET(unsigned short int)
+DEBBY__LRU_CACHE_ST_GET(int)
+DEBBY__LRU_CACHE_ST_GET(unsigned int)
+DEBBY__LRU_CACHE_ST_GET(long int)
+DEBBY__LRU_CACHE_ST_GET(unsigned long int)
+DEBBY__LRU_CACHE_ST_GET(long long int)
+DEBBY__LRU_CACHE_ST_GET(unsigned long long int)
+DEBBY__LRU_CACHE_ST_GET(float)
+DEBBY__LRU_CACHE_ST_GET(double)
+DEBBY__LRU_CACHE_ST_GET(std::string)
+
+#define DEBBY__LRU_CACHE_MT_SET(t) \
+    template void keyvalue_database<backend_enum::lru_cache_mt>::set<t> (key_type const & key, t value, error * perr);
+
+#define DEBBY__LRU_CACHE_MT_GET(t) \
+    template t keyvalue_database<backend_enum::lru_cache_mt>::get<t> (key_type const & key, error * perr) const;
+
+DEBBY__LRU_CACHE_MT_SET(bool)
+DEBBY__LRU_CACHE_MT_SET(char)
+DEBBY__LRU_CACHE_MT_SET(signed char)
+DEBBY__LRU_CACHE_MT_SET(unsigned char)
+DEBBY__LRU_CACHE_MT_SET(short int)
+DEBBY__LRU_CACHE_MT_SET(unsigned short int)
+DEBBY__LRU_CACHE_MT_SET(int)
+DEBBY__LRU_CACHE_MT_SET(unsigned int)
+DEBBY__LRU_CACHE_MT_SET(long int)
+DEBBY__LRU_CACHE_MT_SET(unsigned long int)
+DEBBY__LRU_CACHE_MT_SET(long long int)
+DEBBY__LRU_CACHE_MT_SET(unsigned long long int)
+DEBBY__LRU_CACHE_MT_SET(float)
+DEBBY__LRU_CACHE_MT_SET(double)
+
+DEBBY__LRU_CACHE_MT_GET(bool)
+DEBBY__LRU_CACHE_MT_GET(char)
+DEBBY__LRU_CACHE_MT_GET(signed char)
+DEBBY__LRU_CACHE_MT_GET(unsigned char)
+DEBBY__LRU_CACHE_MT_GET(short int)
+DEBBY__LRU_CACHE_MT_GET(unsigned short int)
+DEBBY__LRU_CACHE_MT_GET(int)
+DEBBY__LRU_CACHE_MT_GET(unsigned int)
+DEBBY__LRU_CACHE_MT_GET(long int)
+DEBBY__LRU_CACHE_MT_GET(unsigned long int)
+DEBBY__LRU_CACHE_MT_GET(long long int)
+DEBBY__LRU_CACHE_MT_GET(unsigned long long int)
+DEBBY__LRU_CACHE_MT_GET(float)
+DEBBY__LRU_CACHE_MT_GET(double)
+DEBBY__LRU_CACHE_MT_GET(std::string)
+
+#endif
+
 DEBBY__NAMESPACE_END
@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+//                 Added `peek()`.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "flat_hash_map.hpp"
+#include "debby/in_memory.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Byte-bounded segmented LRU cache with `compact_string` keys.
+ *
+ * New entries are placed into the probationary segment, entries accessed again are
+ * promoted to the protected segment. When the protected segment exceeds its part of
+ * the capacity its least recently used entries are demoted back to the probationary
+ * segment. Eviction takes the least recently used probationary entry first, so
+ * entries seen once (scans) do not flush frequently used ones.
+ *
+ * Entry charge is the key size and the value size plus fixed per-entry overhead.
+ * Expired entries are removed lazily on access.
+ */
+template <typename Value>
+class lru_cache
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+private:
+    enum segment_enum: unsigned char { probation, protect };
+
+    struct entry
+    {
+        entry * prev;
+        entry * next;
+        compact_string key;
+        Value value;
+        time_point expires;
+        std::size_t charge;
+        segment_enum segment;
+    };
+
+    struct list
+    {
+        entry * head {nullptr};
+        entry * tail {nullptr};
+        std::size_t bytes {0};
+    };
+
+public:
+    // Entry node and index slot
+    static constexpr std::size_t ENTRY_OVERHEAD = sizeof(entry) + sizeof(compact_string) + sizeof(entry *) + 1;
+
+private:
+    flat_hash_map<entry *> _index;
+    list _segments[2];
+    std::size_t _capacity;
+    std::size_t _protected_capacity;
+    cache_stats _stats;
+
+public:
+    lru_cache (std::size_t capacity, std::size_t protected_capacity) noexcept
+        : _capacity(capacity)
+        , _protected_capacity(protected_capacity)
+    {}
+
+    lru_cache (lru_cache && other) noexcept
+        : _index(std::move(other._index))
+        , _capacity(other._capacity)
+        , _protected_capacity(other._protected_capacity)
+        , _stats(other._stats)
+    {
+        _segments[probation] = other._segments[probation];
+        _segments[protect] = other._segments[protect];
+        other._segments[probation] = list{};
+        other._segments[protect] = list{};
+        other._stats = cache_stats{};
+    }
+
+    lru_cache & operator = (lru_cache && other) noexcept
+    {
+        if (this != & other) {
+            clear();
+            _index = std::move(other._index);
+            _segments[probation] = other._segments[probation];
+            _segments[protect] = other._segments[protect];
+            _capacity = other._capacity;
+            _protected_capacity = other._protected_capacity;
+            _stats = other._stats;
+            other._segments[probation] = list{};
+            other._segments[protect] = list{};
+            other._stats = cache_stats{};
+        }
+
+        return *this;
+    }
+
+    lru_cache (lru_cache const &) = delete;
+    lru_cache & operator = (lru_cache const &) = delete;
+
+    ~lru_cache ()
+    {
+        clear();
+    }
+
+public:
+    cache_stats stats () const noexcept
+    {
+        auto result = _stats;
+        result.count = _index.size();
+        result.bytes = _segments[probation].bytes + _segments[protect].bytes;
+        return result;
+    }
+
+    /**
+     * Removes all entries. Counters are kept.
+     */
+    void clear () noexcept
+    {
+        for (auto & s: _segments) {
+            for (auto e = s.head; e != nullptr; ) {
+                auto next = e->next;
+                delete e;
+                e = next;
+            }
+
+            s = list{};
+        }
+
+        _index.clear();
+    }
+
+    /**
+     * Returns value associated with @a key and marks it as recently used or @c nullptr
+     * if there is no such key or entry is expired. Updates hit/miss counters.
+     */
+    Value * find (char const * key, std::size_t size, time_point now)
+    {
+        auto p = _index.find(key, size);
+
+        if (p == nullptr) {
+            _stats.misses++;
+            return nullptr;
+        }
+
+        auto e = *p;
+
+        if (e->expires <= now) {
+            remove_entry(e);
+            _stats.expirations++;
+            _stats.misses++;
+            return nullptr;
+        }
+
+        _stats.hits++;
+        touch(e);
+        return & e->value;
+    }
+
+    /**
+     * Returns value associated with @a key without updating recency and hit/miss
+     * counters or @c nullptr if there is no such key or entry is expired (expired entry
+     * is removed).
+     */
+    Value * peek (char const * key, std::size_t size, time_point now) noexcept
+    {
+        auto p = _index.find(key, size);
+
+        if (p == nullptr)
+            return nullptr;
+
+        auto e = *p;
+
+        if (e->expires <= now) {
+            remove_entry(e);
+            _stats.expirations++;
+            return nullptr;
+        }
+
+        return & e->value;
+    }
+
+    /**
+     * Assigns value to the entry associated with @a key (inserting new entry if needed)
+     * by calling @a f (Value &) and evicts entries exceeding capacity.
+     *
+     * @details Entry which charge exceeds capacity is not stored at all.
+     */
+    template <typename F>
+    void assign (char const * key, std::size_t size, time_point expires, F && f)
+    {
+        auto & slot = _index(key, size);
+        auto e = slot;
+        auto inserted = e == nullptr;
+
+        if (inserted) {
+            try {
+                e = new entry {nullptr, nullptr, compact_string(key, size), Value{}, expires, 0, probation};
+            } catch (...) {
+                _index.erase(key, size);
+                throw;
+            }
+
+            slot = e;
+            push_front(_segments[probation], e);
+        } else {
+            touch(e);
+        }
+
+        try {
+            f(e->value);
+        } catch (...) {
+            if (inserted)
+                remove_entry(e);
+
+            throw;
+        }
+
+        e->expires = expires;
+
+        auto & s = _segments[e->segment];
+        s.bytes -= e->charge;
+        e->charge = ENTRY_OVERHEAD + e->key.size() + e->value.size();
+        s.bytes += e->charge;
+
+        if (e->charge > _capacity) {
+            remove_entry(e);
+            _stats.evictions++;
+            return;
+        }
+
+        evict(e);
+    }
+
+    bool erase (char const * key, std::size_t size) noexcept
+    {
+        auto p = _index.find(key, size);
+
+        if (p == nullptr)
+            return false;
+
+        remove_entry(*p);
+        return true;
+    }
+
+    /**
+     * Sets expiration time for entry associated with @a key.
+     *
+     * @return @c false if there is no such key.
+     */
+    bool expire (char const * key, std::size_t size, time_point expires) noexcept
+    {
+        auto p = _index.find(key, size);
+
+        if (p == nullptr)
+            return false;
+
+        (*p)->expires = expires;
+        return true;
+    }
+
+    /**
+     * Calls @a f (compact_string const & key, Value const & value) for each not expired
+     * entry which key starts with @a prefix until @a f returns @c false. Protected
+     * entries are visited first, from the most recently used.
+     */
+    template <typename F>
+    void for_each_prefix (char const * prefix, std::size_t size, time_point now, F && f) const
+    {
+        for (auto seg: {protect, probation}) {
+            for (auto e = _segments[seg].head; e != nullptr; e = e->next) {
+                if (e->expires <= now || e->key.size() < size
+                        || (size > 0 && std::memcmp(e->key.data(), prefix, size) != 0)) {
+                    continue;
+                }
+
+                if (!f(e->key, e->value))
+                    return;
+            }
+        }
+    }
+
+private:
+    static void push_front (list & s, entry * e) noexcept
+    {
+        e->prev = nullptr;
+        e->next = s.head;
+
+        if (s.head != nullptr)
+            s.head->prev = e;
+        else
+            s.tail = e;
+
+        s.head = e;
+        s.bytes += e->charge;
+    }
+
+    static void unlink (list & s, entry * e) noexcept
+    {
+        if (e->prev != nullptr)
+            e->prev->next = e->next;
+        else
+            s.head = e->next;
+
+        if (e->next != nullptr)
+            e->next->prev = e->prev;
+        else
+            s.tail = e->prev;
+
+        s.bytes -= e->charge;
+    }
+
+    void move_to (segment_enum seg, entry * e) noexcept
+    {
+        unlink(_segments[e->segment], e);
+        e->segment = seg;
+        push_front(_segments[seg], e);
+    }
+
+    // Marks entry as recently used, promoting probationary entry to protected segment
+    void touch (entry * e) noexcept
+    {
+        move_to(protect, e);
+
+        auto & s = _segments[protect];
+
+        while (s.bytes > _protected_capacity && s.tail != e)
+            move_to(probation, s.tail);
+    }
+
+    // Evicts least recently used entries (except @a keep) while capacity is exceeded
+    void evict (entry * keep) noexcept
+    {
+        while (_segments[probation].bytes + _segments[protect].bytes > _capacity) {
+            auto victim = _segments[probation].tail;
+
+            if (victim == nullptr || victim == keep)
+                victim = _segments[protect].tail;
+
+            if (victim == nullptr || victim == keep)
+                break;
+
+            remove_entry(victim);
+            _stats.evictions++;
+        }
+    }
+
+    void remove_entry (entry * e) noexcept
+    {
+        unlink(_segments[e->segment], e);
+        _index.erase(e->key.data(), e->key.size());
+        delete e;
+    }
+};
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,876 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "compact_value.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define DEBBY__RADIX_TREE_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Adaptive radix tree (ART) with `compact_string` keys.
+ *
+ * Inner nodes grow and shrink between four layouts (4, 16, 48 and 256 children)
+ * depending on the number of children. Common key fragments are stored once as
+ * node prefix (path compression) and single-key subtrees are replaced by the leaf
+ * itself (lazy expansion), so leaves keep full keys. The key that ends exactly at
+ * the inner node is stored as the node's terminal leaf.
+ *
+ * Keys are ordered byte-wise (as by `std::memcmp`, shorter key goes first).
+ */
+template <typename Value>
+class radix_tree
+{
+private:
+    struct leaf
+    {
+        compact_string key;
+        Value value;
+
+        leaf (char const * k, std::size_t size)
+            : key(k, size)
+        {}
+    };
+
+    enum node_type: unsigned char { NODE4, NODE16, NODE48, NODE256 };
+
+    struct node
+    {
+        node_type type;
+        std::uint16_t count {0}; // Number of children
+        compact_string prefix;
+        leaf * terminal {nullptr};
+
+        explicit node (node_type t) noexcept : type(t) {}
+    };
+
+    struct node4: node
+    {
+        unsigned char keys[4];
+        void * children[4];
+
+        node4 () noexcept : node(NODE4) {}
+    };
+
+    struct node16: node
+    {
+        unsigned char keys[16];
+        void * children[16];
+
+        node16 () noexcept : node(NODE16) {}
+    };
+
+    struct node48: node
+    {
+        unsigned char index[256]; // Child position + 1, 0 if no child
+        void * children[48];
+
+        node48 () noexcept : node(NODE48)
+        {
+            std::memset(index, 0, sizeof(index));
+        }
+    };
+
+    struct node256: node
+    {
+        void * children[256];
+
+        node256 () noexcept : node(NODE256)
+        {
+            std::fill(children, children + 256, nullptr);
+        }
+    };
+
+private:
+    // Tagged pointer: leaf if the lowest bit is set, inner node otherwise
+    void * _root {nullptr};
+    std::size_t _size {0};
+
+public:
+    radix_tree () noexcept = default;
+
+    radix_tree (radix_tree && other) noexcept
+        : _root(other._root)
+        , _size(other._size)
+    {
+        other._root = nullptr;
+        other._size = 0;
+    }
+
+    radix_tree & operator = (radix_tree && other) noexcept
+    {
+        if (this != & other) {
+            clear();
+            std::swap(_root, other._root);
+            std::swap(_size, other._size);
+        }
+
+        return *this;
+    }
+
+    radix_tree (radix_tree const &) = delete;
+    radix_tree & operator = (radix_tree const &) = delete;
+
+    ~radix_tree ()
+    {
+        clear();
+    }
+
+public:
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+
+    bool empty () const noexcept
+    {
+        return _size == 0;
+    }
+
+    void clear () noexcept
+    {
+        destroy(_root);
+        _root = nullptr;
+        _size = 0;
+    }
+
+    Value * find (char const * key, std::size_t size) noexcept
+    {
+        void * p = _root;
+        std::size_t depth = 0;
+
+        while (p != nullptr) {
+            if (is_leaf(p)) {
+                auto l = as_leaf(p);
+                return l->key.equals(key, size) ? & l->value : nullptr;
+            }
+
+            auto n = as_node(p);
+            auto plen = n->prefix.size();
+
+            if (depth + plen > size || (plen > 0 && std::memcmp(n->prefix.data(), key + depth, plen) != 0))
+                return nullptr;
+
+            depth += plen;
+
+            if (depth == size)
+                return n->terminal != nullptr ? & n->terminal->value : nullptr;
+
+            auto child = find_child(n, byte_at(key, depth));
+
+            if (child == nullptr)
+                return nullptr;
+
+            p = *child;
+            depth++;
+        }
+
+        return nullptr;
+    }
+
+    Value const * find (char const * key, std::size_t size) const noexcept
+    {
+        return const_cast<radix_tree *>(this)->find(key, size);
+    }
+
+    /**
+     * Returns reference to the value associated with @a key, inserting the empty
+     * value if there is no such key.
+     */
+    Value & operator () (char const * key, std::size_t size)
+    {
+        void ** ref = & _root;
+        std::size_t depth = 0;
+
+        for (;;) {
+            void * p = *ref;
+
+            if (p == nullptr) {
+                auto l = new leaf(key, size);
+                *ref = tag(l);
+                _size++;
+                return l->value;
+            }
+
+            if (is_leaf(p)) {
+                auto l = as_leaf(p);
+
+                if (l->key.equals(key, size))
+                    return l->value;
+
+                // Replace leaf by the node with common prefix holding both leaves
+                auto lkey = l->key.data();
+                auto limit = (std::min)(l->key.size(), size);
+                auto split = depth;
+
+                while (split < limit && lkey[split] == key[split])
+                    split++;
+
+                std::unique_ptr<leaf> nl {new leaf(key, size)};
+                auto n = make_node4(key + depth, split - depth);
+
+                attach(n, l, split);
+                attach(n, nl.get(), split);
+                *ref = n;
+                _size++;
+                return nl.release()->value;
+            }
+
+            auto n = as_node(p);
+            auto plen = n->prefix.size();
+            auto pdata = n->prefix.data();
+            std::size_t m = 0;
+
+            while (m < plen && depth + m < size && pdata[m] == key[depth + m])
+                m++;
+
+            if (m < plen) {
+                // Key diverges inside the prefix: split the prefix
+                std::unique_ptr<leaf> nl {new leaf(key, size)};
+                std::unique_ptr<node4> nn {make_node4(pdata, m)};
+                compact_string rest {pdata + m + 1, plen - m - 1};
+                auto b = static_cast<unsigned char>(pdata[m]);
+
+                n->prefix = std::move(rest);
+                insert_sorted(nn->keys, nn->children, nn->count, b, n);
+
+                if (depth + m == size)
+                    nn->terminal = nl.get();
+                else
+                    insert_sorted(nn->keys, nn->children, nn->count, byte_at(key, depth + m), tag(nl.get()));
+
+                *ref = nn.release();
+                _size++;
+                return nl.release()->value;
+            }
+
+            depth += plen;
+
+            if (depth == size) {
+                if (n->terminal == nullptr) {
+                    n->terminal = new leaf(key, size);
+                    _size++;
+                }
+
+                return n->terminal->value;
+            }
+
+            auto c = byte_at(key, depth);
+            auto child = find_child(n, c);
+
+            if (child == nullptr) {
+                std::unique_ptr<leaf> nl {new leaf(key, size)};
+                add_child(ref, n, c, tag(nl.get()));
+                _size++;
+                return nl.release()->value;
+            }
+
+            ref = child;
+            depth++;
+        }
+    }
+
+    bool erase (char const * key, std::size_t size) noexcept
+    {
+        void ** ref = & _root;
+        void ** parent_ref = nullptr;
+        unsigned char parent_byte = 0;
+        std::size_t depth = 0;
+
+        while (*ref != nullptr) {
+            void * p = *ref;
+
+            if (is_leaf(p)) {
+                auto l = as_leaf(p);
+
+                if (!l->key.equals(key, size))
+                    return false;
+
+                if (parent_ref == nullptr) {
+                    *ref = nullptr;
+                } else {
+                    remove_child(parent_ref, as_node(*parent_ref), parent_byte);
+                    collapse(parent_ref);
+                }
+
+                delete l;
+                _size--;
+                return true;
+            }
+
+            auto n = as_node(p);
+            auto plen = n->prefix.size();
+
+            if (depth + plen > size || (plen > 0 && std::memcmp(n->prefix.data(), key + depth, plen) != 0))
+                return false;
+
+            depth += plen;
+
+            if (depth == size) {
+                if (n->terminal == nullptr)
+                    return false;
+
+                delete n->terminal;
+                n->terminal = nullptr;
+                _size--;
+                collapse(ref);
+                return true;
+            }
+
+            auto c = byte_at(key, depth);
+            auto child = find_child(n, c);
+
+            if (child == nullptr)
+                return false;
+
+            parent_ref = ref;
+            parent_byte = c;
+            ref = child;
+            depth++;
+        }
+
+        return false;
+    }
+
+    /**
+     * Calls @a f (compact_string const & key, Value const & value) in key order for each
+     * element until @a f returns @c false.
+     */
+    template <typename F>
+    void for_each (F && f) const
+    {
+        visit(_root, f);
+    }
+
+    /**
+     * Calls @a f (compact_string const & key, Value const & value) in key order for each
+     * element which key starts with @a prefix until @a f returns @c false.
+     */
+    template <typename F>
+    void for_each_prefix (char const * prefix, std::size_t size, F && f) const
+    {
+        void * p = _root;
+        std::size_t depth = 0;
+
+        while (p != nullptr) {
+            if (is_leaf(p)) {
+                auto l = as_leaf(p);
+
+                if (l->key.size() >= size && (size == 0 || std::memcmp(l->key.data(), prefix, size) == 0))
+                    f(l->key, l->value);
+
+                return;
+            }
+
+            auto n = as_node(p);
+            auto plen = n->prefix.size();
+            auto cmp_len = (std::min)(plen, size - depth);
+
+            if (cmp_len > 0 && std::memcmp(n->prefix.data(), prefix + depth, cmp_len) != 0)
+                return;
+
+            // All keys of the subtree start with prefix
+            if (depth + plen >= size) {
+                visit(p, f);
+                return;
+            }
+
+            depth += plen;
+
+            auto child = find_child(n, byte_at(prefix, depth));
+
+            if (child == nullptr)
+                return;
+
+            p = *child;
+            depth++;
+        }
+    }
+
+private:
+    static bool is_leaf (void const * p) noexcept
+    {
+        return (reinterpret_cast<std::uintptr_t>(p) & 1) != 0;
+    }
+
+    static leaf * as_leaf (void * p) noexcept
+    {
+        return reinterpret_cast<leaf *>(reinterpret_cast<std::uintptr_t>(p) & ~std::uintptr_t{1});
+    }
+
+    static node * as_node (void * p) noexcept
+    {
+        return static_cast<node *>(p);
+    }
+
+    static void * tag (leaf * l) noexcept
+    {
+        return reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(l) | 1);
+    }
+
+    static unsigned char byte_at (char const * s, std::size_t i) noexcept
+    {
+        return static_cast<unsigned char>(s[i]);
+    }
+
+    static node4 * make_node4 (char const * prefix, std::size_t size)
+    {
+        std::unique_ptr<node4> n {new node4};
+        n->prefix = compact_string {prefix, size};
+        return n.release();
+    }
+
+    static void destroy_node (node * n) noexcept
+    {
+        switch (n->type) {
+            case NODE4: delete static_cast<node4 *>(n); break;
+            case NODE16: delete static_cast<node16 *>(n); break;
+            case NODE48: delete static_cast<node48 *>(n); break;
+            case NODE256: delete static_cast<node256 *>(n); break;
+        }
+    }
+
+    static void destroy (void * p) noexcept
+    {
+        if (p == nullptr)
+            return;
+
+        if (is_leaf(p)) {
+            delete as_leaf(p);
+            return;
+        }
+
+        auto n = as_node(p);
+        delete n->terminal;
+
+        switch (n->type) {
+            case NODE4: {
+                auto nn = static_cast<node4 *>(n);
+                std::for_each(nn->children, nn->children + nn->count, destroy);
+                break;
+            }
+            case NODE16: {
+                auto nn = static_cast<node16 *>(n);
+                std::for_each(nn->children, nn->children + nn->count, destroy);
+                break;
+            }
+            case NODE48: {
+                auto nn = static_cast<node48 *>(n);
+                std::for_each(nn->children, nn->children + nn->count, destroy);
+                break;
+            }
+            case NODE256: {
+                auto nn = static_cast<node256 *>(n);
+                std::for_each(nn->children, nn->children + 256, destroy);
+                break;
+            }
+        }
+
+        destroy_node(n);
+    }
+
+    template <typename F>
+    static bool visit (void * p, F & f)
+    {
+        if (p == nullptr)
+            return true;
+
+        if (is_leaf(p)) {
+            auto l = as_leaf(p);
+            return f(l->key, l->value);
+        }
+
+        auto n = as_node(p);
+
+        // Key ending at this node precedes all longer keys
+        if (n->terminal != nullptr && !f(n->terminal->key, n->terminal->value))
+            return false;
+
+        switch (n->type) {
+            case NODE4: {
+                auto nn = static_cast<node4 *>(n);
+
+                for (std::size_t i = 0; i < nn->count; i++) {
+                    if (!visit(nn->children[i], f))
+                        return false;
+                }
+
+                break;
+            }
+            case NODE16: {
+                auto nn = static_cast<node16 *>(n);
+
+                for (std::size_t i = 0; i < nn->count; i++) {
+                    if (!visit(nn->children[i], f))
+                        return false;
+                }
+
+                break;
+            }
+            case NODE48: {
+                auto nn = static_cast<node48 *>(n);
+
+                for (std::size_t c = 0; c < 256; c++) {
+                    if (nn->index[c] != 0 && !visit(nn->children[nn->index[c] - 1], f))
+                        return false;
+                }
+
+                break;
+            }
+            case NODE256: {
+                auto nn = static_cast<node256 *>(n);
+
+                for (std::size_t c = 0; c < 256; c++) {
+                    if (nn->children[c] != nullptr && !visit(nn->children[c], f))
+                        return false;
+                }
+
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    static void ** find_child (node * n, unsigned char c) noexcept
+    {
+        switch (n->type) {
+            case NODE4: {
+                auto nn = static_cast<node4 *>(n);
+
+                for (std::size_t i = 0; i < nn->count; i++) {
+                    if (nn->keys[i] == c)
+                        return & nn->children[i];
+                }
+
+                return nullptr;
+            }
+            case NODE16: {
+                auto nn = static_cast<node16 *>(n);
+#if DEBBY__RADIX_TREE_SSE2
+                auto cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(c))
+                    , _mm_loadu_si128(reinterpret_cast<__m128i const *>(nn->keys)));
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(cmp)) & ((1u << nn->count) - 1);
+
+                if (mask == 0)
+                    return nullptr;
+
+                std::size_t i = 0;
+
+                while ((mask & 1) == 0) {
+                    mask >>= 1;
+                    i++;
+                }
+
+                return & nn->children[i];
+#else
+                for (std::size_t i = 0; i < nn->count; i++) {
+                    if (nn->keys[i] == c)
+                        return & nn->children[i];
+                }
+
+                return nullptr;
+#endif
+            }
+            case NODE48: {
+                auto nn = static_cast<node48 *>(n);
+                return nn->index[c] != 0 ? & nn->children[nn->index[c] - 1] : nullptr;
+            }
+            case NODE256: {
+                auto nn = static_cast<node256 *>(n);
+                return nn->children[c] != nullptr ? & nn->children[c] : nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * Adds leaf @a l to the new node (split point at @a depth).
+     */
+    static void attach (node4 * n, leaf * l, std::size_t depth) noexcept
+    {
+        if (l->key.size() == depth)
+            n->terminal = l;
+        else
+            insert_sorted(n->keys, n->children, n->count, byte_at(l->key.data(), depth), tag(l));
+    }
+
+    static void insert_sorted (unsigned char * keys, void ** children, std::uint16_t & count
+        , unsigned char c, void * child) noexcept
+    {
+        std::size_t pos = 0;
+
+        while (pos < count && keys[pos] < c)
+            pos++;
+
+        std::memmove(keys + pos + 1, keys + pos, count - pos);
+        std::memmove(children + pos + 1, children + pos, (count - pos) * sizeof(void *));
+        keys[pos] = c;
+        children[pos] = child;
+        count++;
+    }
+
+    static void erase_sorted (unsigned char * keys, void ** children, std::uint16_t & count
+        , unsigned char c) noexcept
+    {
+        std::size_t pos = 0;
+
+        while (pos < count && keys[pos] != c)
+            pos++;
+
+        std::memmove(keys + pos, keys + pos + 1, count - pos - 1);
+        std::memmove(children + pos, children + pos + 1, (count - pos - 1) * sizeof(void *));
+        count--;
+    }
+
+    static void move_header (node * dst, node * src) noexcept
+    {
+        dst->count = src->count;
+        dst->prefix = std::move(src->prefix);
+        dst->terminal = src->terminal;
+        src->terminal = nullptr;
+    }
+
+    /**
+     * Adds @a child to node @a n referenced by @a ref, replacing node by the larger one if full.
+     */
+    static void add_child (void ** ref, node * n, unsigned char c, void * child)
+    {
+        switch (n->type) {
+            case NODE4: {
+                auto nn = static_cast<node4 *>(n);
+
+                if (nn->count < 4) {
+                    insert_sorted(nn->keys, nn->children, nn->count, c, child);
+                } else {
+                    auto bigger = new node16;
+                    move_header(bigger, nn);
+                    std::memcpy(bigger->keys, nn->keys, 4);
+                    std::memcpy(bigger->children, nn->children, 4 * sizeof(void *));
+                    insert_sorted(bigger->keys, bigger->children, bigger->count, c, child);
+                    *ref = bigger;
+                    delete nn;
+                }
+
+                break;
+            }
+            case NODE16: {
+                auto nn = static_cast<node16 *>(n);
+
+                if (nn->count < 16) {
+                    insert_sorted(nn->keys, nn->children, nn->count, c, child);
+                } else {
+                    auto bigger = new node48;
+                    move_header(bigger, nn);
+
+                    for (std::size_t i = 0; i < 16; i++) {
+                        bigger->children[i] = nn->children[i];
+                        bigger->index[nn->keys[i]] = static_cast<unsigned char>(i + 1);
+                    }
+
+                    bigger->children[bigger->count] = child;
+                    bigger->index[c] = static_cast<unsigned char>(++bigger->count);
+                    *ref = bigger;
+                    delete nn;
+                }
+
+                break;
+            }
+            case NODE48: {
+                auto nn = static_cast<node48 *>(n);
+
+                if (nn->count < 48) {
+                    nn->children[nn->count] = child;
+                    nn->index[c] = static_cast<unsigned char>(++nn->count);
+                } else {
+                    auto bigger = new node256;
+                    move_header(bigger, nn);
+
+                    for (std::size_t i = 0; i < 256; i++) {
+                        if (nn->index[i] != 0)
+                            bigger->children[i] = nn->children[nn->index[i] - 1];
+                    }
+
+                    bigger->children[c] = child;
+                    bigger->count++;
+                    *ref = bigger;
+                    delete nn;
+                }
+
+                break;
+            }
+            case NODE256: {
+                auto nn = static_cast<node256 *>(n);
+                nn->children[c] = child;
+                nn->count++;
+                break;
+            }
+        }
+    }
+
+    /**
+     * Removes child @a c from node @a n referenced by @a ref, replacing node by the smaller
+     * one if it becomes sparse (if allocation fails the node is kept as is).
+     */
+    static void remove_child (void ** ref, node * n, unsigned char c) noexcept
+    {
+        switch (n->type) {
+            case NODE4: {
+                auto nn = static_cast<node4 *>(n);
+                erase_sorted(nn->keys, nn->children, nn->count, c);
+                break;
+            }
+            case NODE16: {
+                auto nn = static_cast<node16 *>(n);
+                erase_sorted(nn->keys, nn->children, nn->count, c);
+
+                if (nn->count <= 3) {
+                    auto smaller = new (std::nothrow) node4;
+
+                    if (smaller != nullptr) {
+                        move_header(smaller, nn);
+                        std::memcpy(smaller->keys, nn->keys, nn->count);
+                        std::memcpy(smaller->children, nn->children, nn->count * sizeof(void *));
+                        *ref = smaller;
+                        delete nn;
+                    }
+                }
+
+                break;
+            }
+            case NODE48: {
+                auto nn = static_cast<node48 *>(n);
+                auto pos = nn->index[c] - 1;
+                auto last = nn->count - 1;
+
+                nn->index[c] = 0;
+
+                // Keep children compact: move the last child to the released position
+                if (pos != last) {
+                    nn->children[pos] = nn->children[last];
+
+                    for (std::size_t i = 0; i < 256; i++) {
+                        if (nn->index[i] == last + 1) {
+                            nn->index[i] = static_cast<unsigned char>(pos + 1);
+                            break;
+                        }
+                    }
+                }
+
+                nn->count--;
+
+                if (nn->count <= 12) {
+                    auto smaller = new (std::nothrow) node16;
+
+                    if (smaller != nullptr) {
+                        move_header(smaller, nn);
+                        smaller->count = 0;
+
+                        for (std::size_t i = 0; i < 256; i++) {
+                            if (nn->index[i] != 0) {
+                                smaller->keys[smaller->count] = static_cast<unsigned char>(i);
+                                smaller->children[smaller->count] = nn->children[nn->index[i] - 1];
+                                smaller->count++;
+                            }
+                        }
+
+                        *ref = smaller;
+                        delete nn;
+                    }
+                }
+
+                break;
+            }
+            case NODE256: {
+                auto nn = static_cast<node256 *>(n);
+                nn->children[c] = nullptr;
+                nn->count--;
+
+                if (nn->count <= 40) {
+                    auto smaller = new (std::nothrow) node48;
+
+                    if (smaller != nullptr) {
+                        move_header(smaller, nn);
+                        smaller->count = 0;
+
+                        for (std::size_t i = 0; i < 256; i++) {
+                            if (nn->children[i] != nullptr) {
+                                smaller->children[smaller->count] = nn->children[i];
+                                smaller->index[i] = static_cast<unsigned char>(++smaller->count);
+                            }
+                        }
+
+                        *ref = smaller;
+                        delete nn;
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    /**
+     * Replaces node referenced by @a ref with its only entry (terminal leaf or child).
+     */
+    static void collapse (void ** ref) noexcept
+    {
+        auto n = as_node(*ref);
+
+        if (n->count == 0) {
+            *ref = n->terminal != nullptr ? tag(n->terminal) : nullptr;
+            n->terminal = nullptr;
+            destroy_node(n);
+            return;
+        }
+
+        if (n->count > 1 || n->terminal != nullptr || n->type != NODE4)
+            return;
+
+        auto nn = static_cast<node4 *>(n);
+        auto child = nn->children[0];
+
+        if (!is_leaf(child)) {
+            // Merge prefixes: node prefix + child byte + child prefix
+            auto cn = as_node(child);
+
+            try {
+                std::string merged;
+                merged.reserve(n->prefix.size() + 1 + cn->prefix.size());
+                merged.append(n->prefix.data(), n->prefix.size());
+                merged += static_cast<char>(nn->keys[0]);
+                merged.append(cn->prefix.data(), cn->prefix.size());
+                cn->prefix = compact_string {merged.data(), merged.size()};
+            } catch (...) {
+                return;
+            }
+        }
+
+        *ref = child;
+        destroy_node(n);
+    }
+};
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,484 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+//                 Parameterized `validate_snapshot()` by signature (used by bloom filter).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/error.hpp"
+#include "debby/namespace.hpp"
+#include "hash.hpp"
+#include <pfs/filesystem.hpp>
+#include <pfs/i18n.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace in_memory {
+
+/**
+ * Snapshot image layout (native byte order, see `snapshot_header::flags`):
+ *
+ *   header | record 0 | record 1 | ... | record N-1
+ *
+ * record: | type (1 byte) | key size (4 bytes) | key | value |
+ * value:  arithmetic types - `type_sizes[type]` bytes,
+ *         string - | size (4 bytes) | bytes |
+ *
+ * Payload checksum is calculated by pieces of `CHUNK_SIZE` bytes independently of
+ * record boundaries, so it can be verified before parsing.
+ */
+struct snapshot_header
+{
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t BIG_ENDIAN_FLAG = 0x01;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    char magic[8];               // "DEBBYKV\0"
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint8_t type_sizes[16]; // Sizes of value types (0 for strings)
+    std::uint64_t count;
+    std::uint64_t payload_size;
+    std::uint64_t checksum;
+};
+
+static_assert(std::is_trivially_copyable<snapshot_header>::value, "snapshot header must be trivially copyable");
+static_assert(sizeof(snapshot_header) == 56, "unexpected snapshot header size");
+
+inline char const * snapshot_magic () noexcept
+{
+    return "DEBBYKV";
+}
+
+inline std::uint32_t native_byte_order_flags () noexcept
+{
+    std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(& first, & probe, 1);
+    return first == 1 ? 0 : snapshot_header::BIG_ENDIAN_FLAG;
+}
+
+inline std::uint64_t update_checksum (std::uint64_t checksum, char const * data, std::size_t size) noexcept
+{
+    auto h = hash_bytes(data, size);
+    return (checksum ^ h) * 0x9E3779B97F4A7C15ULL + (checksum >> 31);
+}
+
+inline error make_snapshot_error (errc e, pfs::filesystem::path const & path, std::string const & what)
+{
+    return error {make_error_code(e), tr::f_("snapshot {}: {}", pfs::utf8_encode_path(path), what)};
+}
+
+/**
+ * Buffered snapshot writer. Writes into temporary file which atomically replaces the
+ * target file on `commit()`.
+ */
+class snapshot_writer
+{
+    pfs::filesystem::path _path;
+    pfs::filesystem::path _tmp_path;
+    std::string _buffer;
+    std::uint64_t _checksum {0};
+    std::uint64_t _payload_size {0};
+
+#if defined(_WIN32)
+    HANDLE _h {INVALID_HANDLE_VALUE};
+#else
+    int _fd {-1};
+#endif
+
+public:
+    snapshot_writer (pfs::filesystem::path const & path, error * perr)
+        : _path(path)
+        , _tmp_path(path)
+    {
+        _tmp_path += PFS__LITERAL_PATH(".tmp");
+        _buffer.reserve(snapshot_header::CHUNK_SIZE);
+
+#if defined(_WIN32)
+        _h = ::CreateFileW(_tmp_path.native().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS
+            , FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (_h == INVALID_HANDLE_VALUE) {
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _tmp_path
+                , tr::f_("create file failure: error code {}", ::GetLastError())));
+            return;
+        }
+#else
+        _fd = ::open(_tmp_path.native().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (_fd < 0) {
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _tmp_path
+                , tr::f_("create file failure: {}", std::strerror(errno))));
+            return;
+        }
+#endif
+
+        // Reserve space for header, it will be written on commit
+        snapshot_header h;
+        std::memset(& h, 0, sizeof(h));
+        write_raw(reinterpret_cast<char const *>(& h), sizeof(h), 0, perr);
+    }
+
+    snapshot_writer (snapshot_writer const &) = delete;
+    snapshot_writer & operator = (snapshot_writer const &) = delete;
+
+    ~snapshot_writer ()
+    {
+        discard();
+    }
+
+public:
+    bool is_open () const noexcept
+    {
+#if defined(_WIN32)
+        return _h != INVALID_HANDLE_VALUE;
+#else
+        return _fd >= 0;
+#endif
+    }
+
+    void append (char const * data, std::size_t size, error * perr)
+    {
+        while (size > 0) {
+            std::size_t room = snapshot_header::CHUNK_SIZE - _buffer.size();
+            auto n = size < room ? size : room;
+            _buffer.append(data, n);
+            data += n;
+            size -= n;
+
+            if (_buffer.size() == snapshot_header::CHUNK_SIZE && !flush(perr))
+                return;
+        }
+    }
+
+    template <typename T>
+    void append_pod (T const & value, error * perr)
+    {
+        append(reinterpret_cast<char const *>(& value), sizeof(T), perr);
+    }
+
+    /**
+     * Flushes buffered data, writes header and replaces target file.
+     */
+    bool commit (snapshot_header h, error * perr)
+    {
+        if (!is_open() || !flush(perr))
+            return false;
+
+        h.payload_size = _payload_size;
+        h.checksum = _checksum;
+
+        if (!write_raw(reinterpret_cast<char const *>(& h), sizeof(h), 0, perr))
+            return false;
+
+#if defined(_WIN32)
+        auto success = ::FlushFileBuffers(_h) != 0;
+#else
+        auto success = ::fsync(_fd) == 0;
+#endif
+
+        if (!success) {
+            discard();
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _tmp_path, tr::_("sync failure")));
+            return false;
+        }
+
+        close();
+
+        std::error_code ec;
+        pfs::filesystem::rename(_tmp_path, _path, ec);
+
+        if (ec) {
+            std::error_code ec2;
+            pfs::filesystem::remove(_tmp_path, ec2);
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _path, ec.message()));
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    bool flush (error * perr)
+    {
+        if (_buffer.empty())
+            return true;
+
+        _checksum = update_checksum(_checksum, _buffer.data(), _buffer.size());
+
+        if (!write_raw(_buffer.data(), _buffer.size(), sizeof(snapshot_header) + _payload_size, perr))
+            return false;
+
+        _payload_size += _buffer.size();
+        _buffer.clear();
+        return true;
+    }
+
+    bool write_raw (char const * data, std::size_t size, std::uint64_t offset, error * perr)
+    {
+        if (!is_open())
+            return false;
+
+        while (size > 0) {
+#if defined(_WIN32)
+            OVERLAPPED ov {};
+            ov.Offset = static_cast<DWORD>(offset);
+            ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD n = 0;
+            auto chunk = static_cast<DWORD>((std::min)(size, std::size_t{1} << 30));
+
+            if (!::WriteFile(_h, data, chunk, & n, & ov)) {
+                discard();
+                pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _tmp_path
+                    , tr::f_("write failure: error code {}", ::GetLastError())));
+                return false;
+            }
+#else
+            auto n = ::pwrite(_fd, data, size, static_cast<off_t>(offset));
+
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                auto e = errno;
+                discard();
+                pfs::throw_or(perr, make_snapshot_error(errc::backend_error, _tmp_path
+                    , tr::f_("write failure: {}", std::strerror(e))));
+                return false;
+            }
+#endif
+            data += n;
+            size -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+
+        return true;
+    }
+
+    // Closes and removes incomplete temporary file, subsequent writes are ignored
+    void discard () noexcept
+    {
+        if (is_open()) {
+            close();
+            std::error_code ec;
+            pfs::filesystem::remove(_tmp_path, ec);
+        }
+    }
+
+    void close () noexcept
+    {
+#if defined(_WIN32)
+        ::CloseHandle(_h);
+        _h = INVALID_HANDLE_VALUE;
+#else
+        ::close(_fd);
+        _fd = -1;
+#endif
+    }
+};
+
+/**
+ * Read-only memory mapped snapshot file.
+ */
+class mapped_file
+{
+    char const * _data {nullptr};
+    std::size_t _size {0};
+
+#if defined(_WIN32)
+    HANDLE _h {INVALID_HANDLE_VALUE};
+    HANDLE _mapping {nullptr};
+#endif
+
+public:
+    mapped_file (pfs::filesystem::path const & path, error * perr)
+    {
+#if defined(_WIN32)
+        _h = ::CreateFileW(path.native().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr
+            , OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (_h == INVALID_HANDLE_VALUE) {
+            pfs::throw_or(perr, make_snapshot_error(errc::database_not_found, path
+                , tr::f_("open failure: error code {}", ::GetLastError())));
+            return;
+        }
+
+        LARGE_INTEGER size;
+
+        if (!::GetFileSizeEx(_h, & size)) {
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, path
+                , tr::f_("file size failure: error code {}", ::GetLastError())));
+            return;
+        }
+
+        _size = static_cast<std::size_t>(size.QuadPart);
+
+        if (_size == 0)
+            return;
+
+        _mapping = ::CreateFileMappingW(_h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (_mapping != nullptr)
+            _data = static_cast<char const *>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (_data == nullptr) {
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, path
+                , tr::f_("map failure: error code {}", ::GetLastError())));
+        }
+#else
+        auto fd = ::open(path.native().c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            pfs::throw_or(perr, make_snapshot_error(errno == ENOENT ? errc::database_not_found : errc::backend_error
+                , path, tr::f_("open failure: {}", std::strerror(errno))));
+            return;
+        }
+
+        struct stat st;
+
+        if (::fstat(fd, & st) != 0) {
+            pfs::throw_or(perr, make_snapshot_error(errc::backend_error, path
+                , tr::f_("file size failure: {}", std::strerror(errno))));
+            ::close(fd);
+            return;
+        }
+
+        _size = static_cast<std::size_t>(st.st_size);
+
+        if (_size > 0) {
+            auto p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (p == MAP_FAILED) {
+                pfs::throw_or(perr, make_snapshot_error(errc::backend_error, path
+                    , tr::f_("map failure: {}", std::strerror(errno))));
+                _size = 0;
+            } else {
+                _data = static_cast<char const *>(p);
+
+                // Image is read once from the beginning to the end
+                ::madvise(p, _size, MADV_SEQUENTIAL);
+            }
+        }
+
+        // Mapping remains valid after the descriptor is closed
+        ::close(fd);
+#endif
+    }
+
+    mapped_file (mapped_file const &) = delete;
+    mapped_file & operator = (mapped_file const &) = delete;
+
+    ~mapped_file ()
+    {
+#if defined(_WIN32)
+        if (_data != nullptr)
+            ::UnmapViewOfFile(_data);
+
+        if (_mapping != nullptr)
+            ::CloseHandle(_mapping);
+
+        if (_h != INVALID_HANDLE_VALUE)
+            ::CloseHandle(_h);
+#else
+        if (_data != nullptr)
+            ::munmap(const_cast<char *>(_data), _size);
+#endif
+    }
+
+public:
+    char const * data () const noexcept
+    {
+        return _data;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _size;
+    }
+};
+
+/**
+ * Validates snapshot header (expected signature @a magic and value type sizes) and
+ * payload checksum.
+ *
+ * @return Pointer to the payload or @c nullptr on error.
+ */
+inline char const * validate_snapshot (mapped_file const & f, pfs::filesystem::path const & path
+    , char const * magic, std::uint8_t const * type_sizes, snapshot_header & h, error * perr)
+{
+    if (f.size() < sizeof(snapshot_header)) {
+        pfs::throw_or(perr, make_snapshot_error(errc::bad_value, path, tr::_("file is too small")));
+        return nullptr;
+    }
+
+    std::memcpy(& h, f.data(), sizeof(h));
+
+    if (std::memcmp(h.magic, magic, sizeof(h.magic)) != 0) {
+        pfs::throw_or(perr, make_snapshot_error(errc::bad_value, path, tr::_("bad signature")));
+        return nullptr;
+    }
+
+    if (h.version != snapshot_header::VERSION) {
+        pfs::throw_or(perr, make_snapshot_error(errc::unsupported, path
+            , tr::f_("unsupported version: {}", h.version)));
+        return nullptr;
+    }
+
+    if (h.flags != native_byte_order_flags() || std::memcmp(h.type_sizes, type_sizes, sizeof(h.type_sizes)) != 0) {
+        pfs::throw_or(perr, make_snapshot_error(errc::unsupported, path
+            , tr::_("snapshot was made on platform with different byte order or type sizes")));
+        return nullptr;
+    }
+
+    if (h.payload_size != f.size() - sizeof(snapshot_header)) {
+        pfs::throw_or(perr, make_snapshot_error(errc::bad_value, path, tr::_("truncated file")));
+        return nullptr;
+    }
+
+    auto payload = f.data() + sizeof(snapshot_header);
+    auto size = static_cast<std::size_t>(h.payload_size);
+    std::uint64_t checksum = 0;
+
+    for (std::size_t offset = 0; offset < size; offset += snapshot_header::CHUNK_SIZE) {
+        std::size_t n = size - offset;
+        checksum = update_checksum(checksum, payload + offset, n < snapshot_header::CHUNK_SIZE
+            ? n : snapshot_header::CHUNK_SIZE);
+    }
+
+    if (checksum != h.checksum) {
+        pfs::throw_or(perr, make_snapshot_error(errc::bad_value, path, tr::_("checksum mismatch")));
+        return nullptr;
+    }
+
+    return payload;
+}
+
+} // namespace in_memory
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,611 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "instrumentation.hpp"
+#include <pfs/fmt.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+#   include <atomic>
+#   include <memory>
+#   include <mutex>
+#   include <unordered_map>
+#   include <utility>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace instrumentation {
+
+static int msb_index (std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanReverse64(& index, value);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+
+    while (value >>= 1)
+        index++;
+
+    return index;
+#endif
+}
+
+std::size_t histogram::bucket_index (std::uint64_t value) noexcept
+{
+    constexpr std::uint64_t sub_bucket_count = std::uint64_t{1} << SUB_BUCKET_BITS;
+
+    if (value < sub_bucket_count)
+        return static_cast<std::size_t>(value);
+
+    auto msb = msb_index(value);
+    auto shift = msb - SUB_BUCKET_BITS;
+    auto sub_bucket = (value >> shift) & (sub_bucket_count - 1);
+
+    return (static_cast<std::size_t>(msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS)
+        + static_cast<std::size_t>(sub_bucket);
+}
+
+std::uint64_t histogram::bucket_upper_bound (std::size_t index) noexcept
+{
+    constexpr std::size_t sub_bucket_count = std::size_t{1} << SUB_BUCKET_BITS;
+
+    if (index < sub_bucket_count)
+        return index;
+
+    auto shift = static_cast<int>(index >> SUB_BUCKET_BITS) - 1;
+    auto sub_bucket = static_cast<std::uint64_t>(index & (sub_bucket_count - 1));
+    auto lower = (sub_bucket_count + sub_bucket) << shift;
+
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+std::uint64_t histogram::percentile (double q) const noexcept
+{
+    if (count == 0)
+        return 0;
+
+    q = (std::min)((std::max)(q, 0.0), 1.0);
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count)));
+
+    if (rank == 0)
+        rank = 1;
+
+    std::uint64_t accumulated = 0;
+
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        accumulated += buckets[i];
+
+        if (accumulated >= rank)
+            return bucket_upper_bound(i);
+    }
+
+    return 0;
+}
+
+std::string normalize_sql (std::string const & sql)
+{
+    std::string result;
+    result.reserve(sql.size());
+
+    auto is_ident_char = [] (char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+
+    // Appends placeholder collapsing lists like `?, ?, ?` into single `?`
+    auto append_placeholder = [& result] () {
+        auto n = result.size();
+
+        while (n > 0 && result[n - 1] == ' ')
+            n--;
+
+        if (n > 0 && result[n - 1] == ',') {
+            auto m = n - 1;
+
+            while (m > 0 && result[m - 1] == ' ')
+                m--;
+
+            if (m > 0 && result[m - 1] == '?') {
+                result.resize(m);
+                return;
+            }
+        }
+
+        result += '?';
+    };
+
+    bool pending_space = false;
+    std::size_t i = 0;
+    auto size = sql.size();
+
+    while (i < size) {
+        char c = sql[i];
+
+        // Whitespaces
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = true;
+            i++;
+            continue;
+        }
+
+        // Line comment
+        if (c == '-' && i + 1 < size && sql[i + 1] == '-') {
+            while (i < size && sql[i] != '\n')
+                i++;
+
+            pending_space = true;
+            continue;
+        }
+
+        // Block comment
+        if (c == '/' && i + 1 < size && sql[i + 1] == '*') {
+            auto pos = sql.find("*/", i + 2);
+            i = pos == std::string::npos ? size : pos + 2;
+            pending_space = true;
+            continue;
+        }
+
+        if (pending_space && !result.empty())
+            result += ' ';
+
+        pending_space = false;
+
+        // String literal
+        if (c == '\'') {
+            i++;
+
+            while (i < size) {
+                if (sql[i] == '\'') {
+                    if (i + 1 < size && sql[i + 1] == '\'') {
+                        i += 2;
+                        continue;
+                    }
+
+                    break;
+                }
+
+                i++;
+            }
+
+            i++;
+            append_placeholder();
+            continue;
+        }
+
+        // Quoted identifier (kept as is)
+        if (c == '"' || c == '`') {
+            auto pos = sql.find(c, i + 1);
+            auto last = pos == std::string::npos ? size : pos + 1;
+            result.append(sql, i, last - i);
+            i = last;
+            continue;
+        }
+
+        // Numbered placeholder (`$1`, `?1`, `:name`, `@name`)
+        if (c == '$' || c == '?' || ((c == ':' || c == '@') && i + 1 < size && is_ident_char(sql[i + 1]))) {
+            i++;
+
+            while (i < size && is_ident_char(sql[i]))
+                i++;
+
+            append_placeholder();
+            continue;
+        }
+
+        // Numeric literal
+        if (std::isdigit(static_cast<unsigned char>(c)) && (result.empty() || !is_ident_char(result.back()))) {
+            while (i < size && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '.'))
+                i++;
+
+            append_placeholder();
+            continue;
+        }
+
+        result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        i++;
+    }
+
+    return result;
+}
+
+static std::uint64_t hash_normalized (std::string const & normalized_sql) noexcept
+{
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (auto c: normalized_sql) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    // Zero is reserved for "no statement"
+    return hash == 0 ? 1 : hash;
+}
+
+std::uint64_t fingerprint (std::string const & sql)
+{
+    return hash_normalized(normalize_sql(sql));
+}
+
+char const * to_string (backend_enum backend) noexcept
+{
+    switch (backend) {
+        case backend_enum::sqlite3: return "sqlite3";
+        case backend_enum::psql: return "psql";
+        case backend_enum::map_st: return "map_st";
+        case backend_enum::map_mt: return "map_mt";
+        case backend_enum::unordered_map_st: return "unordered_map_st";
+        case backend_enum::unordered_map_mt: return "unordered_map_mt";
+        case backend_enum::lmdb: return "lmdb";
+        case backend_enum::mdbx: return "mdbx";
+        case backend_enum::rocksdb: return "rocksdb";
+        case backend_enum::flat_hash_map_st: return "flat_hash_map_st";
+        case backend_enum::flat_hash_map_mt: return "flat_hash_map_mt";
+        case backend_enum::radix_tree_st: return "radix_tree_st";
+        case backend_enum::radix_tree_mt: return "radix_tree_mt";
+        case backend_enum::lru_cache_st: return "lru_cache_st";
+        case backend_enum::lru_cache_mt: return "lru_cache_mt";
+    }
+
+    return "unknown";
+}
+
+char const * to_string (operation_enum op) noexcept
+{
+    switch (op) {
+        case operation_enum::kv_set: return "kv_set";
+        case operation_enum::kv_get: return "kv_get";
+        case operation_enum::kv_remove: return "kv_remove";
+        case operation_enum::stmt_exec: return "stmt_exec";
+        case operation_enum::result_next: return "result_next";
+    }
+
+    return "unknown";
+}
+
+std::string to_prometheus (std::vector<metric> const & metrics)
+{
+    std::string result;
+
+    result += "# TYPE debby_operation_duration_seconds summary\n";
+
+    for (auto const & m: metrics) {
+        auto labels = fmt::format("backend=\"{}\",operation=\"{}\",fingerprint=\"{:016x}\""
+            , to_string(m.backend), to_string(m.operation), m.fingerprint);
+
+        for (double q: {0.5, 0.9, 0.99, 0.999}) {
+            result += fmt::format("debby_operation_duration_seconds{{{},quantile=\"{}\"}} {}\n"
+                , labels, q, m.latency.percentile(q) * 1e-9);
+        }
+
+        result += fmt::format("debby_operation_duration_seconds_sum{{{}}} {}\n", labels, m.latency.sum * 1e-9);
+        result += fmt::format("debby_operation_duration_seconds_count{{{}}} {}\n", labels, m.latency.count);
+    }
+
+    result += "# TYPE debby_operation_bytes_total counter\n";
+
+    for (auto const & m: metrics) {
+        result += fmt::format("debby_operation_bytes_total{{backend=\"{}\",operation=\"{}\",fingerprint=\"{:016x}\"}} {}\n"
+            , to_string(m.backend), to_string(m.operation), m.fingerprint, m.bytes);
+    }
+
+    return result;
+}
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+
+namespace {
+
+struct metric_key
+{
+    backend_enum backend;
+    operation_enum operation;
+    std::uint64_t fingerprint;
+
+    bool operator == (metric_key const & other) const noexcept
+    {
+        return backend == other.backend && operation == other.operation
+            && fingerprint == other.fingerprint;
+    }
+
+    bool operator < (metric_key const & other) const noexcept
+    {
+        if (backend != other.backend)
+            return backend < other.backend;
+
+        if (operation != other.operation)
+            return operation < other.operation;
+
+        return fingerprint < other.fingerprint;
+    }
+};
+
+struct metric_key_hash
+{
+    std::size_t operator () (metric_key const & key) const noexcept
+    {
+        auto h = key.fingerprint ^ ((static_cast<std::uint64_t>(key.backend) << 8)
+            | static_cast<std::uint64_t>(key.operation));
+        h *= 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
+// Written by owner thread only, read by snapshot().
+struct counters
+{
+    std::atomic<std::uint64_t> sum;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> buckets[histogram::BUCKET_COUNT];
+
+    counters () noexcept
+    {
+        sum.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+
+        for (auto & b: buckets)
+            b.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Single writer: plain load/store is enough, no locked read-modify-write needed
+inline void increment (std::atomic<std::uint64_t> & a, std::uint64_t n) noexcept
+{
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct totals
+{
+    std::uint64_t bytes {0};
+    histogram latency;
+
+    void add (counters const & c) noexcept
+    {
+        latency.sum += c.sum.load(std::memory_order_relaxed);
+        bytes += c.bytes.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < histogram::BUCKET_COUNT; i++) {
+            auto n = c.buckets[i].load(std::memory_order_relaxed);
+            latency.buckets[i] += n;
+            latency.count += n;
+        }
+    }
+
+    void add (totals const & t) noexcept
+    {
+        latency.sum += t.latency.sum;
+        latency.count += t.latency.count;
+        bytes += t.bytes;
+
+        for (std::size_t i = 0; i < histogram::BUCKET_COUNT; i++)
+            latency.buckets[i] += t.latency.buckets[i];
+    }
+
+    void subtract (totals const & t) noexcept
+    {
+        latency.sum -= t.latency.sum;
+        latency.count -= t.latency.count;
+        bytes -= t.bytes;
+
+        for (std::size_t i = 0; i < histogram::BUCKET_COUNT; i++)
+            latency.buckets[i] -= t.latency.buckets[i];
+    }
+};
+
+using totals_map = std::unordered_map<metric_key, totals, metric_key_hash>;
+
+class thread_slot;
+
+class registry
+{
+public:
+    std::mutex mtx;
+    std::vector<thread_slot *> slots;
+    totals_map retired;  // Totals of finished threads
+    totals_map baseline; // Totals at the moment of last reset()
+    std::unordered_map<std::uint64_t, std::string> sql;
+
+public:
+    static registry & instance ()
+    {
+        // Intentionally leaked: must outlive thread_local slots
+        static registry * r = new registry;
+        return *r;
+    }
+
+    totals_map collect ();
+};
+
+class thread_slot
+{
+public:
+    // Guards `entries` structure (not counters): owner appends, snapshot iterates.
+    std::mutex mtx;
+    std::vector<std::pair<metric_key, std::unique_ptr<counters>>> entries;
+
+private:
+    // Accessed by owner thread only
+    std::unordered_map<metric_key, counters *, metric_key_hash> _index;
+
+public:
+    thread_slot ()
+    {
+        auto & r = registry::instance();
+        std::lock_guard<std::mutex> locker{r.mtx};
+        r.slots.push_back(this);
+    }
+
+    ~thread_slot ()
+    {
+        auto & r = registry::instance();
+        std::lock_guard<std::mutex> locker{r.mtx};
+
+        for (auto const & x: entries)
+            r.retired[x.first].add(*x.second);
+
+        r.slots.erase(std::remove(r.slots.begin(), r.slots.end(), this), r.slots.end());
+    }
+
+    counters & at (metric_key const & key)
+    {
+        auto pos = _index.find(key);
+
+        if (pos != _index.end())
+            return *pos->second;
+
+        std::unique_ptr<counters> c {new counters};
+        auto ptr = c.get();
+
+        {
+            std::lock_guard<std::mutex> locker{mtx};
+            entries.emplace_back(key, std::move(c));
+        }
+
+        _index.emplace(key, ptr);
+        return *ptr;
+    }
+};
+
+// Must be called with `mtx` locked
+totals_map registry::collect ()
+{
+    totals_map result = retired;
+
+    for (auto slot: slots) {
+        std::lock_guard<std::mutex> locker{slot->mtx};
+
+        for (auto const & x: slot->entries)
+            result[x.first].add(*x.second);
+    }
+
+    return result;
+}
+
+thread_slot & local_slot ()
+{
+    static thread_local thread_slot slot;
+    return slot;
+}
+
+} // namespace
+
+void record (backend_enum backend, operation_enum op, std::uint64_t fingerprint
+    , std::uint64_t elapsed_ns, std::uint64_t bytes) noexcept
+{
+    try {
+        auto & c = local_slot().at(metric_key{backend, op, fingerprint});
+        increment(c.sum, elapsed_ns);
+        increment(c.bytes, bytes);
+        increment(c.buckets[histogram::bucket_index(elapsed_ns)], 1);
+    } catch (...) {
+        // Metrics are lost on allocation failure
+    }
+}
+
+std::uint64_t register_sql (char const * sql)
+{
+    if (sql == nullptr)
+        return 0;
+
+    auto normalized = normalize_sql(sql);
+    auto fp = hash_normalized(normalized);
+
+    auto & r = registry::instance();
+    std::lock_guard<std::mutex> locker{r.mtx};
+
+    if (r.sql.find(fp) == r.sql.end())
+        r.sql.emplace(fp, std::move(normalized));
+
+    return fp;
+}
+
+bool enabled () noexcept
+{
+    return true;
+}
+
+std::vector<metric> snapshot ()
+{
+    std::vector<metric> result;
+    auto & r = registry::instance();
+    std::lock_guard<std::mutex> locker{r.mtx};
+
+    auto collected = r.collect();
+
+    for (auto & x: collected) {
+        auto pos = r.baseline.find(x.first);
+
+        if (pos != r.baseline.end())
+            x.second.subtract(pos->second);
+
+        if (x.second.latency.count == 0)
+            continue;
+
+        metric m;
+        m.backend = x.first.backend;
+        m.operation = x.first.operation;
+        m.fingerprint = x.first.fingerprint;
+        m.bytes = x.second.bytes;
+        m.latency = x.second.latency;
+
+        if (m.fingerprint != 0) {
+            auto sql_pos = r.sql.find(m.fingerprint);
+
+            if (sql_pos != r.sql.end())
+                m.sql = sql_pos->second;
+        }
+
+        result.push_back(std::move(m));
+    }
+
+    std::sort(result.begin(), result.end(), [] (metric const & a, metric const & b) {
+        return metric_key{a.backend, a.operation, a.fingerprint}
+            < metric_key{b.backend, b.operation, b.fingerprint};
+    });
+
+    return result;
+}
+
+void reset ()
+{
+    auto & r = registry::instance();
+    std::lock_guard<std::mutex> locker{r.mtx};
+    r.baseline = r.collect();
+}
+
+#else
+
+bool enabled () noexcept
+{
+    return false;
+}
+
+std::vector<metric> snapshot ()
+{
+    return std::vector<metric>{};
+}
+
+void reset ()
+{}
+
+#endif // DEBBY__INSTRUMENTATION_ENABLED
+
+} // namespace instrumentation
+
+DEBBY__NAMESPACE_END
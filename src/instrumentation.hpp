@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/instrumentation.hpp"
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+#   include <chrono>
+#   include <string>
+#   include <type_traits>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace instrumentation {
+
+/**
+ * Records single operation into the calling thread buckets.
+ */
+void record (backend_enum backend, operation_enum op, std::uint64_t fingerprint
+    , std::uint64_t elapsed_ns, std::uint64_t bytes) noexcept;
+
+/**
+ * Calculates fingerprint of @a sql and remembers normalized SQL for snapshots.
+ */
+std::uint64_t register_sql (char const * sql);
+
+class scoped_timer
+{
+    using clock_type = std::chrono::steady_clock;
+
+    backend_enum _backend;
+    operation_enum _op;
+    std::uint64_t _fingerprint;
+    std::uint64_t _bytes;
+    clock_type::time_point _start;
+
+public:
+    scoped_timer (backend_enum backend, operation_enum op, std::uint64_t fingerprint, std::uint64_t bytes) noexcept
+        : _backend(backend)
+        , _op(op)
+        , _fingerprint(fingerprint)
+        , _bytes(bytes)
+        , _start(clock_type::now())
+    {}
+
+    ~scoped_timer ()
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _start);
+        record(_backend, _op, _fingerprint, static_cast<std::uint64_t>(elapsed.count()), _bytes);
+    }
+
+    scoped_timer (scoped_timer const &) = delete;
+    scoped_timer & operator = (scoped_timer const &) = delete;
+
+    void set_bytes (std::uint64_t bytes) noexcept
+    {
+        _bytes = bytes;
+    }
+};
+
+template <typename T>
+inline std::enable_if_t<std::is_arithmetic<T>::value, std::uint64_t>
+bytes_of (T const &) noexcept
+{
+    return sizeof(T);
+}
+
+inline std::uint64_t bytes_of (std::string const & value) noexcept
+{
+    return value.size();
+}
+
+} // namespace instrumentation
+
+DEBBY__NAMESPACE_END
+
+#   define DEBBY__INSTRUMENT(backend, op, fingerprint, bytes) \
+        instrumentation::scoped_timer debby__instrument_timer {backend, instrumentation::operation_enum::op, fingerprint, bytes}
+
+#   define DEBBY__INSTRUMENT_BYTES(bytes) debby__instrument_timer.set_bytes(bytes)
+#else
+#   define DEBBY__INSTRUMENT(backend, op, fingerprint, bytes)
+#   define DEBBY__INSTRUMENT_BYTES(bytes)
+#endif
@@ -1,11 +1,12 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2023.02.07 Initial version.
 //      2024.11.04 V2 started.
+//      2026.10.18 Added helpers for `increment()` and `append()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "fixed_packer.hpp"
@@ -13,6 +14,9 @@
 #include "debby/namespace.hpp"
 #include "debby/keyvalue_database.hpp"
 #include <pfs/i18n.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -33,6 +37,43 @@ inline error make_key_not_found_error (std::string const & key)
     };
 }
 
+inline error make_unsuitable_update_error (std::string const & key)
+{
+    return error {
+          make_error_code(errc::bad_value)
+        , tr::f_("stored value is unsuitable for update by key: {}", key)
+    };
+}
+
+/**
+ * Adds @a delta to @a counter wrapping around on overflow.
+ */
+inline std::int64_t wrapping_add (std::int64_t counter, std::int64_t delta) noexcept
+{
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(counter) + static_cast<std::uint64_t>(delta));
+}
+
+/**
+ * Adds @a delta to the counter packed into @a value by backends storing raw bytes
+ * (empty @a value is zero counter).
+ *
+ * @return @c false if @a value is not a packed counter.
+ */
+inline bool increment_packed (std::string & value, std::int64_t delta)
+{
+    fixed_packer<std::int64_t> p;
+    p.value = 0;
+
+    if (value.size() == sizeof(std::int64_t))
+        std::memcpy(p.bytes, value.data(), sizeof(std::int64_t));
+    else if (!value.empty())
+        return false;
+
+    p.value = wrapping_add(p.value, delta);
+    value.assign(p.bytes, sizeof(std::int64_t));
+    return true;
+}
+
 template <backend_enum Backend>
 keyvalue_database<Backend>::keyvalue_database ()
 {}
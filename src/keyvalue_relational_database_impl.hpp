@@ -1,17 +1,27 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.20 Initial version.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 Remove statement prepared once.
+//                 Added `remove_many()`.
+//                 Added instrumentation.
+//                 Added `for_each_key()`.
+//                 Added `increment()` and `append()`.
+//                 Added `write_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "debby/keyvalue_database.hpp"
 #include "debby/relational_database.hpp"
 #include "fixed_packer.hpp"
+#include "keyvalue_database_common.hpp"
+#include "instrumentation.hpp"
 #include <pfs/i18n.hpp>
+#include <functional>
+#include <vector>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -22,25 +32,52 @@ private:
     static char const * REMOVE_SQL;
     static char const * PUT_SQL;
     static char const * GET_SQL;
+    static char const * FOR_EACH_KEY_SQL;
+    static char const * INIT_SQL; // Inserts initial value if there is no such key
+    static char const * LOCK_SQL; // Selects value locking the row until the end of transaction
 
 private:
     std::string _table_name;
+    statement<Backend> _remove_stmt;
     statement<Backend> _put_stmt;
     mutable statement<Backend> _get_stmt;
+    mutable statement<Backend> _for_each_key_stmt;
+    statement<Backend> _init_stmt;
+    statement<Backend> _lock_stmt;
 
 public:
     impl (relational_database<Backend> && db, std::string && table_name)
         : relational_database<Backend>(std::move(db))
         , _table_name(std::move(table_name))
     {
+        {
+            std::string sql = fmt::format(REMOVE_SQL, _table_name);
+            _remove_stmt = this->prepare_cached(sql);
+        }
+
         {
             std::string sql = fmt::format(PUT_SQL, _table_name);
-            _put_stmt = this->prepare(sql);
+            _put_stmt = this->prepare_cached(sql);
         }
 
         {
             std::string sql = fmt::format(GET_SQL, _table_name);
-            _get_stmt = this->prepare(sql);
+            _get_stmt = this->prepare_cached(sql);
+        }
+
+        {
+            std::string sql = fmt::format(FOR_EACH_KEY_SQL, _table_name);
+            _for_each_key_stmt = this->prepare_cached(sql);
+        }
+
+        {
+            std::string sql = fmt::format(INIT_SQL, _table_name);
+            _init_stmt = this->prepare_cached(sql);
+        }
+
+        {
+            std::string sql = fmt::format(LOCK_SQL, _table_name);
+            _lock_stmt = this->prepare_cached(sql);
         }
     }
 
@@ -56,28 +93,70 @@ public:
     void remove (typename keyvalue_database::key_type const & key, error * perr)
     {
         error err;
-        std::string sql = fmt::format(REMOVE_SQL, _table_name);
-
-        auto stmt = this->prepare(sql, & err);
+        _remove_stmt.reset(& err);
 
         if (!err) {
-            stmt.bind(1, key.c_str(), key.size(), & err);
+            _remove_stmt.bind(1, key.c_str(), key.size(), & err);
 
             if (!err)
-                stmt.exec(& err);
+                _remove_stmt.exec(& err);
+        }
+
+        if (err)
+            pfs::throw_or(perr, std::move(err));
+    }
+
+    /**
+     * Removes values for @a keys (backend specific).
+     */
+    void remove_many (std::vector<typename keyvalue_database::key_type> const & keys, error * perr);
+
+    /**
+     * Visits keys starting with @a prefix in key order (statement selects keys from the lower bound).
+     */
+    void for_each_key (typename keyvalue_database::key_type const & prefix
+        , std::function<bool (typename keyvalue_database::key_type const &)> const & f, error * perr) const
+    {
+        error err;
+        _for_each_key_stmt.reset(& err);
+
+        if (!err) {
+            _for_each_key_stmt.bind(1, prefix.c_str(), prefix.size(), & err);
 
-            if (err) {
-                pfs::throw_or(perr, std::move(err));
-                return;
+            if (!err) {
+                auto res = _for_each_key_stmt.exec(& err);
+
+                while (!err && res.has_more()) {
+                    auto key = res.template get<std::string>(1, & err);
+
+                    if (err || !key)
+                        break;
+
+                    if (key->compare(0, prefix.size(), prefix) != 0 || !f(*key))
+                        break;
+
+                    res.next();
+                }
             }
         }
+
+        if (err)
+            pfs::throw_or(perr, std::move(err));
     }
 
     bool put (typename keyvalue_database::key_type const & key, char const * data, std::size_t len, error * perr)
     {
         // Attempt to write `null` data interpreted as delete operation for key
-        if (data == nullptr)
-            remove(key, perr);
+        if (data == nullptr) {
+            error err;
+            remove(key, & err);
+
+            if (!err)
+                return true;
+
+            pfs::throw_or(perr, std::move(err));
+            return false;
+        }
 
         error err;
         _put_stmt.reset(& err);
@@ -97,6 +176,72 @@ public:
         return false;
     }
 
+    /**
+     * Reads value for @a key (inserted as @a initial if there is no such key), modifies it
+     * by @a f (std::string &) and writes it back inside single write transaction.
+     *
+     * @details The row is inserted (or locked by the backend) before read, so concurrent
+     *          updates of the same key are serialized. @a f returns @c false if the stored
+     *          value is unsuitable for the update.
+     */
+    template <typename F>
+    void update (typename keyvalue_database::key_type const & key, std::string const & initial, F && f
+        , error * perr)
+    {
+        error err;
+        this->begin(& err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return;
+        }
+
+        _init_stmt.reset(& err);
+
+        if (!err) {
+            _init_stmt.bind(1, key.c_str(), key.size(), & err)
+                && _init_stmt.bind(2, initial.data(), initial.size(), & err);
+
+            if (!err)
+                _init_stmt.exec(& err);
+        }
+
+        std::string value;
+
+        if (!err) {
+            _lock_stmt.reset(& err);
+
+            if (!err)
+                _lock_stmt.bind(1, key.c_str(), key.size(), & err);
+
+            if (!err) {
+                auto res = _lock_stmt.exec(& err);
+
+                if (!err && res.has_more()) {
+                    auto opt = res.template get<std::string>(1, & err);
+
+                    if (opt)
+                        value = std::move(*opt);
+                }
+            }
+        }
+
+        if (!err && !f(value))
+            err = make_unsuitable_update_error(key);
+
+        if (!err)
+            put(key, value.data(), value.size(), & err);
+
+        if (!err)
+            this->commit(& err);
+
+        if (err) {
+            error ignored;
+            this->rollback(& ignored);
+            pfs::throw_or(perr, std::move(err));
+        }
+    }
+
     template <typename T>
     T get (std::string const & key, error * perr) const
     {
@@ -142,13 +287,82 @@ void keyvalue_database<Backend>::clear (error * perr)
 template <backend_enum Backend>
 void keyvalue_database<Backend>::remove (key_type const & key, error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_remove, 0, 0);
     _d->remove(key, perr);
 }
 
+template <backend_enum Backend>
+void keyvalue_database<Backend>::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    _d->remove_many(keys, perr);
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::write_batch (std::function<void ()> const & f, error * perr)
+{
+    auto depth = _d->transaction_depth();
+    error err;
+    _d->begin(& err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    try {
+        f();
+    } catch (...) {
+        error ignored;
+        _d->rollback_to(depth, & ignored);
+        throw;
+    }
+
+    _d->commit(& err);
+
+    if (err) {
+        error ignored;
+        _d->rollback_to(depth, & ignored);
+        pfs::throw_or(perr, std::move(err));
+    }
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const
+{
+    _d->for_each_key(prefix, f, perr);
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::increment (key_type const & key, std::int64_t delta, error * perr)
+{
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, sizeof(delta));
+
+    std::string initial;
+    increment_packed(initial, 0);
+
+    _d->update(key, initial, [delta] (std::string & value) {
+        return increment_packed(value, delta);
+    }, perr);
+}
+
+template <backend_enum Backend>
+void keyvalue_database<Backend>::append (key_type const & key, char const * data, std::size_t len
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, len);
+
+    _d->update(key, std::string{}, [data, len] (std::string & value) {
+        value.append(data, len);
+        return true;
+    }, perr);
+}
+
 template <backend_enum Backend>
 void keyvalue_database<Backend>::set (key_type const & key, char const * value, std::size_t len
     , error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, len);
     _d->put(key, value, len, perr);
 }
 
@@ -157,6 +371,7 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, void>
 keyvalue_database<Backend>::set (key_type const & key, T value, error * perr)
 {
+    DEBBY__INSTRUMENT(Backend, kv_set, 0, sizeof(T));
     char buf[sizeof(fixed_packer<T>)];
     auto p = new (buf) fixed_packer<T>{};
     p->value = value;
@@ -168,7 +383,10 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value || std::is_same<std::decay_t<T>, std::string>::value, std::decay_t<T>>
 keyvalue_database<Backend>::get (key_type const & key, error * perr) const
 {
-    return _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT(Backend, kv_get, 0, 0);
+    auto result = _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
 }
 
 DEBBY__NAMESPACE_END
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2025 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -7,14 +7,28 @@
 //      2023.02.06 Initial version.
 //      2024.11.10 V2 started.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 Added `remove_many()`.
+//                 Added instrumentation.
+//                 Added `for_each_key()`.
+//                 Added `increment()` and `append()`.
+//                 Added group commit.
+//                 Added `write_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
+#include "../group_commit.hpp"
+#include "../instrumentation.hpp"
 #include "debby/keyvalue_database.hpp"
 #include "debby/mdbx.hpp"
 #include <pfs/filesystem.hpp>
 #include <pfs/i18n.hpp>
 #include <mdbx.h>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace fs = pfs::filesystem;
 
@@ -72,6 +86,9 @@ private:
     MDBX_env * _env {nullptr};
     MDBX_dbi _dbh {0};
     fs::path _path;
+    std::unique_ptr<group_commit<MDBX_txn *>> _group_commit; // Group commit of `put()` and `remove()`
+    MDBX_txn * _batch_txn {nullptr}; // Write transaction of `write_batch()`
+    std::atomic<std::thread::id> _batch_owner {std::thread::id{}}; // Thread owning `_batch_txn`
 
 public:
     impl () = default;
@@ -81,6 +98,7 @@ public:
         std::swap(_env, other._env);
         std::swap(_dbh, other._dbh);
         _path = std::move(other._path);
+        _group_commit = std::move(other._group_commit);
     }
 
     impl (fs::path const & path, mdbx::options_type opts, bool create_if_missing, error * perr)
@@ -176,12 +194,33 @@ public:
         : impl(path, mdbx::options_type{}, create_if_missing, perr)
     {}
 
+    impl (fs::path const & path, mdbx::options_type opts, bool create_if_missing
+        , group_commit_options const & gc, error * perr)
+        : impl(path, opts, create_if_missing, perr)
+    {
+        if (_env == nullptr)
+            return;
+
+        auto env = _env;
+
+        group_commit<MDBX_txn *>::backend_type backend {
+              [env] (MDBX_txn ** txn) { return mdbx_txn_begin(env, nullptr, MDBX_TXN_READWRITE, txn); }
+            , [] (MDBX_txn * txn) { return mdbx_txn_commit(txn); } // Transaction is freed on failure too
+            , [] (MDBX_txn * txn) { mdbx_txn_abort(txn); }
+            , MDBX_SUCCESS
+            , MDBX_NOTFOUND
+        };
+
+        _group_commit.reset(new group_commit<MDBX_txn *>(gc, std::move(backend)));
+    }
+
     impl & operator = (impl && other) noexcept
     {
         this->~impl();
         std::swap(_env, other._env);
         std::swap(_dbh, other._dbh);
         _path = std::move(other._path);
+        _group_commit = std::move(other._group_commit);
         return *this;
     }
 
@@ -201,9 +240,18 @@ public:
     }
 
 private:
+    bool in_batch () const noexcept
+    {
+        return _batch_owner.load() == std::this_thread::get_id();
+    }
+
     template <typename F>
     int perform_transaction (F && f, MDBX_txn_flags_t flags)
     {
+        // Thread owning write transaction can not start another one
+        if (in_batch())
+            return f(_batch_txn);
+
         MDBX_txn * txn = nullptr;
         int rc = MDBX_SUCCESS;
 
@@ -234,7 +282,69 @@ private:
         return rc;
     }
 
+    /**
+     * Performs write @a f in own transaction or as a part of the group transaction.
+     */
+    template <typename F>
+    int perform_write (F && f)
+    {
+        if (in_batch())
+            return f(_batch_txn);
+
+        if (_group_commit != nullptr)
+            return _group_commit->perform(f);
+
+        return perform_transaction(std::forward<F>(f), MDBX_TXN_READWRITE);
+    }
+
+    void end_batch () noexcept
+    {
+        _batch_owner = std::thread::id{};
+        _batch_txn = nullptr;
+    }
+
 public:
+    /**
+     * Performs @a f inside single write transaction (nested batch is a part of the outer one).
+     */
+    void write_batch (std::function<void ()> const & f, error * perr)
+    {
+        if (in_batch()) {
+            f();
+            return;
+        }
+
+        MDBX_txn * txn = nullptr;
+        auto rc = mdbx_txn_begin(_env, nullptr, MDBX_TXN_READWRITE, & txn);
+
+        if (rc != MDBX_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("write batch failure: {}", mdbx_strerror(rc)));
+            return;
+        }
+
+        _batch_txn = txn;
+        _batch_owner = std::this_thread::get_id();
+
+        try {
+            f();
+        } catch (...) {
+            end_batch();
+            mdbx_txn_abort(txn);
+            throw;
+        }
+
+        end_batch();
+
+        // Transaction is freed on failure too
+        rc = mdbx_txn_commit(txn);
+
+        if (rc != MDBX_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("write batch commit failure: {}", mdbx_strerror(rc)));
+        }
+    }
+
     void clear (error * perr = nullptr)
     {
         auto rc = perform_transaction([this] (MDBX_txn * txn) -> int {
@@ -252,13 +362,13 @@ public:
     */
     void remove (keyvalue_database_t::key_type const & key, error * perr)
     {
-        auto rc = perform_transaction([this, & key] (MDBX_txn * txn) -> int {
+        auto rc = perform_write([this, & key] (MDBX_txn * txn) -> int {
             MDBX_val k;
             k.iov_base = iov_base_cast(key.c_str());
             k.iov_len  = key.size();
 
             return mdbx_del(txn, _dbh, & k, nullptr);
-        }, MDBX_TXN_READWRITE);
+        });
 
         if (rc != MDBX_SUCCESS) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -267,6 +377,32 @@ public:
         }
     }
 
+    /**
+    * Removes values for @a keys in single transaction. Missing keys are ignored.
+    */
+    void remove_many (std::vector<keyvalue_database_t::key_type> const & keys, error * perr)
+    {
+        auto rc = perform_transaction([this, & keys] (MDBX_txn * txn) -> int {
+            for (auto const & key: keys) {
+                MDBX_val k;
+                k.iov_base = iov_base_cast(key.c_str());
+                k.iov_len = key.size();
+
+                auto rc = mdbx_del(txn, _dbh, & k, nullptr);
+
+                if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND)
+                    return rc;
+            }
+
+            return MDBX_SUCCESS;
+        }, MDBX_TXN_READWRITE);
+
+        if (rc != MDBX_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("remove failure: {}", mdbx_strerror(rc)));
+        }
+    }
+
     /**
     * Writes @c data into database by @a key.
     *
@@ -293,7 +429,7 @@ public:
             return true;
         }
 
-        auto rc = perform_transaction([this, & key, & data, & size] (MDBX_txn * txn) -> int {
+        auto rc = perform_write([this, & key, & data, & size] (MDBX_txn * txn) -> int {
             MDBX_val k;
             k.iov_base = iov_base_cast(key.c_str());
             k.iov_len  = key.size();
@@ -303,7 +439,7 @@ public:
             val.iov_len  = size;
 
             return mdbx_put(txn, _dbh, & k, & val, MDBX_UPSERT);
-        }, MDBX_TXN_READWRITE);
+        });
 
         if (rc != MDBX_SUCCESS) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -315,6 +451,89 @@ public:
         return true;
     }
 
+    /**
+     * Visits keys starting with @a prefix in key order inside read-only transaction.
+     */
+    void for_each_key (keyvalue_database_t::key_type const & prefix
+        , std::function<bool (keyvalue_database_t::key_type const &)> const & f, error * perr)
+    {
+        auto rc = perform_transaction([this, & prefix, & f] (MDBX_txn * txn) -> int {
+            MDBX_cursor * cursor = nullptr;
+            auto rc = mdbx_cursor_open(txn, _dbh, & cursor);
+
+            if (rc != MDBX_SUCCESS)
+                return rc;
+
+            MDBX_val k;
+            MDBX_val val;
+            k.iov_base = iov_base_cast(prefix.c_str());
+            k.iov_len = prefix.size();
+
+            rc = mdbx_cursor_get(cursor, & k, & val, prefix.empty() ? MDBX_FIRST : MDBX_SET_RANGE);
+
+            while (rc == MDBX_SUCCESS) {
+                if (k.iov_len < prefix.size()
+                        || std::memcmp(k.iov_base, prefix.data(), prefix.size()) != 0) {
+                    break;
+                }
+
+                if (!f(std::string(static_cast<char const *>(k.iov_base), k.iov_len)))
+                    break;
+
+                rc = mdbx_cursor_get(cursor, & k, & val, MDBX_NEXT);
+            }
+
+            mdbx_cursor_close(cursor);
+            return rc == MDBX_NOTFOUND ? MDBX_SUCCESS : rc;
+        }, MDBX_TXN_RDONLY);
+
+        if (rc != MDBX_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("keys iteration failure: {}", mdbx_strerror(rc)));
+        }
+    }
+
+    /**
+     * Reads value for @a key, modifies it by @a f (std::string &) and writes it back
+     * inside single write transaction (missing key is passed as empty value). @a f returns
+     * @c false if the stored value is unsuitable for the update.
+     */
+    template <typename F>
+    void update (keyvalue_database_t::key_type const & key, F && f, error * perr)
+    {
+        auto rc = perform_transaction([this, & key, & f] (MDBX_txn * txn) -> int {
+            MDBX_val k;
+            MDBX_val val;
+            k.iov_base = iov_base_cast(key.c_str());
+            k.iov_len = key.size();
+
+            std::string value;
+            auto rc = mdbx_get(txn, _dbh, & k, & val);
+
+            if (rc == MDBX_SUCCESS)
+                value.assign(static_cast<char const *>(val.iov_base), val.iov_len);
+            else if (rc != MDBX_NOTFOUND)
+                return rc;
+
+            if (!f(value))
+                return UNSUITABLE_VALUE_ERROR;
+
+            val.iov_base = iov_base_cast(value.c_str());
+            val.iov_len = value.size();
+
+            return mdbx_put(txn, _dbh, & k, & val, MDBX_UPSERT);
+        }, MDBX_TXN_READWRITE);
+
+        if (rc != MDBX_SUCCESS) {
+            if (rc == UNSUITABLE_VALUE_ERROR) {
+                pfs::throw_or(perr, make_unsuitable_update_error(key));
+            } else {
+                pfs::throw_or(perr, make_error_code(errc::backend_error)
+                    , tr::f_("update failure for key: {}: {}", key, mdbx_strerror(rc)));
+            }
+        }
+    }
+
     template <typename T>
     T get (std::string const & key, error * perr)
     {
@@ -373,13 +592,56 @@ void keyvalue_database_t::clear (error * perr)
 template <>
 void keyvalue_database_t::remove (key_type const & key, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_remove, 0, 0);
     _d->remove(key, perr);
 }
 
+template <>
+void keyvalue_database_t::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    _d->remove_many(keys, perr);
+}
+
+template <>
+void keyvalue_database_t::write_batch (std::function<void ()> const & f, error * perr)
+{
+    _d->write_batch(f, perr);
+}
+
+template <>
+void keyvalue_database_t::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const
+{
+    _d->for_each_key(prefix, f, perr);
+}
+
+template <>
+void keyvalue_database_t::increment (key_type const & key, std::int64_t delta, error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_set, 0, sizeof(delta));
+
+    _d->update(key, [delta] (std::string & value) {
+        return increment_packed(value, delta);
+    }, perr);
+}
+
+template <>
+void keyvalue_database_t::append (key_type const & key, char const * data, std::size_t len
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_set, 0, len);
+
+    _d->update(key, [data, len] (std::string & value) {
+        value.append(data, len);
+        return true;
+    }, perr);
+}
+
 template <>
 void keyvalue_database_t::set (key_type const & key, char const * value, std::size_t len
     , error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_set, 0, len);
     _d->put(key, value, len, perr);
 }
 
@@ -388,6 +650,7 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, void>
 keyvalue_database_t::set (key_type const & key, T value, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_set, 0, sizeof(T));
     char buf[sizeof(fixed_packer<T>)];
     auto p = new (buf) fixed_packer<T>{};
     p->value = value;
@@ -399,7 +662,10 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value || std::is_same<std::decay_t<T>, std::string>::value, std::decay_t<T>>
 keyvalue_database_t::get (key_type const & key, error * perr) const
 {
-    return _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT(backend_enum::mdbx, kv_get, 0, 0);
+    auto result = _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
 }
 
 namespace mdbx {
@@ -416,6 +682,20 @@ make_kv (fs::path const & path, bool create_if_missing, error * perr)
     return keyvalue_database_t{keyvalue_database_t::impl{path, create_if_missing, perr}};
 }
 
+keyvalue_database_t
+make_kv (fs::path const & path, options_type opts, bool create_if_missing
+    , group_commit_options const & gc, error * perr)
+{
+    return keyvalue_database_t{keyvalue_database_t::impl{path, opts, create_if_missing, gc, perr}};
+}
+
+keyvalue_database_t
+make_kv (fs::path const & path, bool create_if_missing, group_commit_options const & gc
+    , error * perr)
+{
+    return keyvalue_database_t{keyvalue_database_t::impl{path, options_type{}, create_if_missing, gc, perr}};
+}
+
 bool wipe (fs::path const & path, error * perr)
 {
     std::error_code ec1;
@@ -1,19 +1,33 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2025 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2023.07.13 Initial version.
 //      2024.11.04 V2 started.
+//      2026.10.18 Added `remove_many()`.
+//                 Added instrumentation.
+//                 Added `for_each_key()`.
+//                 Added `increment()` and `append()`.
+//                 Added group commit.
+//                 Added `write_batch()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
+#include "../group_commit.hpp"
+#include "../instrumentation.hpp"
 #include "debby/keyvalue_database.hpp"
 #include "debby/lmdb.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/i18n.hpp>
 #include <lmdb.h>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace fs = pfs::filesystem;
 
@@ -72,6 +86,9 @@ private:
     MDB_env * _env {nullptr};
     MDB_dbi _dbh {0};
     fs::path _path;
+    std::unique_ptr<group_commit<MDB_txn *>> _group_commit; // Group commit of `put()` and `remove()`
+    MDB_txn * _batch_txn {nullptr}; // Write transaction of `write_batch()`
+    std::atomic<std::thread::id> _batch_owner {std::thread::id{}}; // Thread owning `_batch_txn`
 
 public:
     impl () = default;
@@ -81,6 +98,7 @@ public:
         std::swap(_env, other._env);
         std::swap(_dbh, other._dbh);
         _path = std::move(other._path);
+        _group_commit = std::move(other._group_commit);
     }
 
     impl (fs::path const & path, lmdb::options_type opts, bool create_if_missing, error * perr)
@@ -166,12 +184,33 @@ public:
         : impl(path, lmdb::options_type{}, create_if_missing, perr)
     {}
 
+    impl (fs::path const & path, lmdb::options_type opts, bool create_if_missing
+        , group_commit_options const & gc, error * perr)
+        : impl(path, opts, create_if_missing, perr)
+    {
+        if (_env == nullptr)
+            return;
+
+        auto env = _env;
+
+        group_commit<MDB_txn *>::backend_type backend {
+              [env] (MDB_txn ** txn) { return mdb_txn_begin(env, nullptr, 0, txn); }
+            , [] (MDB_txn * txn) { return mdb_txn_commit(txn); } // Transaction is freed on failure too
+            , [] (MDB_txn * txn) { mdb_txn_abort(txn); }
+            , MDB_SUCCESS
+            , MDB_NOTFOUND
+        };
+
+        _group_commit.reset(new group_commit<MDB_txn *>(gc, std::move(backend)));
+    }
+
     impl & operator = (impl && other) noexcept
     {
         this->~impl();
         std::swap(_env, other._env);
         std::swap(_dbh, other._dbh);
         _path = std::move(other._path);
+        _group_commit = std::move(other._group_commit);
         return *this;
     }
 
@@ -191,9 +230,18 @@ public:
     }
 
 private:
+    bool in_batch () const noexcept
+    {
+        return _batch_owner.load() == std::this_thread::get_id();
+    }
+
     template <typename F>
     int perform_transaction (F && f, unsigned int flags)
     {
+        // Thread owning write transaction can not start another one
+        if (in_batch())
+            return f(_batch_txn);
+
         MDB_txn * txn = nullptr;
         int rc = MDB_SUCCESS;
 
@@ -224,7 +272,69 @@ private:
         return rc;
     }
 
+    /**
+     * Performs write @a f in own transaction or as a part of the group transaction.
+     */
+    template <typename F>
+    int perform_write (F && f)
+    {
+        if (in_batch())
+            return f(_batch_txn);
+
+        if (_group_commit != nullptr)
+            return _group_commit->perform(f);
+
+        return perform_transaction(std::forward<F>(f), 0);
+    }
+
+    void end_batch () noexcept
+    {
+        _batch_owner = std::thread::id{};
+        _batch_txn = nullptr;
+    }
+
 public:
+    /**
+     * Performs @a f inside single write transaction (nested batch is a part of the outer one).
+     */
+    void write_batch (std::function<void ()> const & f, error * perr)
+    {
+        if (in_batch()) {
+            f();
+            return;
+        }
+
+        MDB_txn * txn = nullptr;
+        auto rc = mdb_txn_begin(_env, nullptr, 0, & txn);
+
+        if (rc != MDB_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("write batch failure: {}", mdb_strerror(rc)));
+            return;
+        }
+
+        _batch_txn = txn;
+        _batch_owner = std::this_thread::get_id();
+
+        try {
+            f();
+        } catch (...) {
+            end_batch();
+            mdb_txn_abort(txn);
+            throw;
+        }
+
+        end_batch();
+
+        // Transaction is freed on failure too
+        rc = mdb_txn_commit(txn);
+
+        if (rc != MDB_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("write batch commit failure: {}", mdb_strerror(rc)));
+        }
+    }
+
     void clear (error * perr = nullptr)
     {
         auto rc = perform_transaction([this] (MDB_txn * txn) -> int {
@@ -242,13 +352,13 @@ public:
      */
     void remove (keyvalue_database_t::key_type const & key, error * perr)
     {
-        auto rc = perform_transaction([this, & key] (MDB_txn * txn) -> int {
+        auto rc = perform_write([this, & key] (MDB_txn * txn) -> int {
             MDB_val k;
             k.mv_data = mv_data_cast(key.c_str());
             k.mv_size = key.size();
 
             return mdb_del(txn, _dbh, & k, nullptr);
-        }, 0);
+        });
 
         if (rc != MDB_SUCCESS) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -257,6 +367,32 @@ public:
         }
     }
 
+    /**
+     * Removes values for @a keys in single transaction. Missing keys are ignored.
+     */
+    void remove_many (std::vector<keyvalue_database_t::key_type> const & keys, error * perr)
+    {
+        auto rc = perform_transaction([this, & keys] (MDB_txn * txn) -> int {
+            for (auto const & key: keys) {
+                MDB_val k;
+                k.mv_data = mv_data_cast(key.c_str());
+                k.mv_size = key.size();
+
+                auto rc = mdb_del(txn, _dbh, & k, nullptr);
+
+                if (rc != MDB_SUCCESS && rc != MDB_NOTFOUND)
+                    return rc;
+            }
+
+            return MDB_SUCCESS;
+        }, 0);
+
+        if (rc != MDB_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("remove failure: {}", mdb_strerror(rc)));
+        }
+    }
+
     /**
      * Writes @c data into database by @a key.
      *
@@ -283,7 +419,7 @@ public:
             return true;
         }
 
-        auto rc = perform_transaction([this, & key, & data, & size] (MDB_txn * txn) -> int {
+        auto rc = perform_write([this, & key, & data, & size] (MDB_txn * txn) -> int {
             MDB_val ky;
             ky.mv_data = mv_data_cast(key.c_str());
             ky.mv_size  = key.size();
@@ -293,7 +429,7 @@ public:
             val.mv_size = size;
 
             return mdb_put(txn, _dbh, & ky, & val, 0);
-        }, 0);
+        });
 
         if (rc != MDB_SUCCESS) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -304,6 +440,89 @@ public:
         return true;
     }
 
+    /**
+     * Visits keys starting with @a prefix in key order inside read-only transaction.
+     */
+    void for_each_key (keyvalue_database_t::key_type const & prefix
+        , std::function<bool (keyvalue_database_t::key_type const &)> const & f, error * perr)
+    {
+        auto rc = perform_transaction([this, & prefix, & f] (MDB_txn * txn) -> int {
+            MDB_cursor * cursor = nullptr;
+            auto rc = mdb_cursor_open(txn, _dbh, & cursor);
+
+            if (rc != MDB_SUCCESS)
+                return rc;
+
+            MDB_val k;
+            MDB_val val;
+            k.mv_data = mv_data_cast(prefix.c_str());
+            k.mv_size = prefix.size();
+
+            rc = mdb_cursor_get(cursor, & k, & val, prefix.empty() ? MDB_FIRST : MDB_SET_RANGE);
+
+            while (rc == MDB_SUCCESS) {
+                if (k.mv_size < prefix.size()
+                        || std::memcmp(k.mv_data, prefix.data(), prefix.size()) != 0) {
+                    break;
+                }
+
+                if (!f(std::string(static_cast<char const *>(k.mv_data), k.mv_size)))
+                    break;
+
+                rc = mdb_cursor_get(cursor, & k, & val, MDB_NEXT);
+            }
+
+            mdb_cursor_close(cursor);
+            return rc == MDB_NOTFOUND ? MDB_SUCCESS : rc;
+        }, MDB_RDONLY);
+
+        if (rc != MDB_SUCCESS) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("keys iteration failure: {}", mdb_strerror(rc)));
+        }
+    }
+
+    /**
+     * Reads value for @a key, modifies it by @a f (std::string &) and writes it back
+     * inside single write transaction (missing key is passed as empty value). @a f returns
+     * @c false if the stored value is unsuitable for the update.
+     */
+    template <typename F>
+    void update (keyvalue_database_t::key_type const & key, F && f, error * perr)
+    {
+        auto rc = perform_transaction([this, & key, & f] (MDB_txn * txn) -> int {
+            MDB_val k;
+            MDB_val val;
+            k.mv_data = mv_data_cast(key.c_str());
+            k.mv_size = key.size();
+
+            std::string value;
+            auto rc = mdb_get(txn, _dbh, & k, & val);
+
+            if (rc == MDB_SUCCESS)
+                value.assign(static_cast<char const *>(val.mv_data), val.mv_size);
+            else if (rc != MDB_NOTFOUND)
+                return rc;
+
+            if (!f(value))
+                return UNSUITABLE_VALUE_ERROR;
+
+            val.mv_data = mv_data_cast(value.c_str());
+            val.mv_size = value.size();
+
+            return mdb_put(txn, _dbh, & k, & val, 0);
+        }, 0);
+
+        if (rc != MDB_SUCCESS) {
+            if (rc == UNSUITABLE_VALUE_ERROR) {
+                pfs::throw_or(perr, make_unsuitable_update_error(key));
+            } else {
+                pfs::throw_or(perr, make_error_code(errc::backend_error)
+                    , tr::f_("update failure for key: {}: {}", key, mdb_strerror(rc)));
+            }
+        }
+    }
+
     template <typename T>
     T get (std::string const & key, error * perr)
     {
@@ -363,13 +582,56 @@ void keyvalue_database_t::clear (error * perr)
 template <>
 void keyvalue_database_t::remove (key_type const & key, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_remove, 0, 0);
     _d->remove(key, perr);
 }
 
+template <>
+void keyvalue_database_t::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    _d->remove_many(keys, perr);
+}
+
+template <>
+void keyvalue_database_t::write_batch (std::function<void ()> const & f, error * perr)
+{
+    _d->write_batch(f, perr);
+}
+
+template <>
+void keyvalue_database_t::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const
+{
+    _d->for_each_key(prefix, f, perr);
+}
+
+template <>
+void keyvalue_database_t::increment (key_type const & key, std::int64_t delta, error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_set, 0, sizeof(delta));
+
+    _d->update(key, [delta] (std::string & value) {
+        return increment_packed(value, delta);
+    }, perr);
+}
+
+template <>
+void keyvalue_database_t::append (key_type const & key, char const * data, std::size_t len
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_set, 0, len);
+
+    _d->update(key, [data, len] (std::string & value) {
+        value.append(data, len);
+        return true;
+    }, perr);
+}
+
 template <>
 void keyvalue_database_t::set (key_type const & key, char const * value, std::size_t len
     , error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_set, 0, len);
     _d->put(key, value, len, perr);
 }
 
@@ -378,6 +640,7 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, void>
 keyvalue_database_t::set (key_type const & key, T value, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_set, 0, sizeof(T));
     char buf[sizeof(fixed_packer<T>)];
     auto p = new (buf) fixed_packer<T>{};
     p->value = value;
@@ -389,7 +652,10 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value || std::is_same<std::decay_t<T>, std::string>::value, std::decay_t<T>>
 keyvalue_database_t::get (key_type const & key, error * perr) const
 {
-    return _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT(backend_enum::lmdb, kv_get, 0, 0);
+    auto result = _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
 }
 
 namespace lmdb {
@@ -406,6 +672,20 @@ make_kv (fs::path const & path, bool create_if_missing, error * perr)
     return keyvalue_database_t{keyvalue_database_t::impl{path, create_if_missing, perr}};
 }
 
+keyvalue_database_t
+make_kv (fs::path const & path, options_type opts, bool create_if_missing
+    , group_commit_options const & gc, error * perr)
+{
+    return keyvalue_database_t{keyvalue_database_t::impl{path, opts, create_if_missing, gc, perr}};
+}
+
+keyvalue_database_t
+make_kv (fs::path const & path, bool create_if_missing, group_commit_options const & gc
+    , error * perr)
+{
+    return keyvalue_database_t{keyvalue_database_t::impl{path, options_type{}, create_if_missing, gc, perr}};
+}
+
 bool wipe (fs::path const & path, error * perr)
 {
     std::error_code ec1;
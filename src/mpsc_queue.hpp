@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/namespace.hpp"
+#include <atomic>
+
+DEBBY__NAMESPACE_BEGIN
+
+struct mpsc_node
+{
+    std::atomic<mpsc_node *> next {nullptr};
+};
+
+/**
+ * Intrusive unbounded multiple-producer single-consumer queue (D. Vyukov's algorithm).
+ *
+ * @details `push()` is wait-free (single exchange), `pop()` is lock-free but returns
+ *          @c nullptr while a producer has not finished linking its node, so the consumer
+ *          should track the number of pushed nodes to distinguish it from empty queue.
+ *          Nodes are owned by the caller.
+ */
+class mpsc_queue
+{
+private:
+    std::atomic<mpsc_node *> _head; // Producers side
+    mpsc_node * _tail;              // Consumer side
+    mpsc_node _stub;
+
+public:
+    mpsc_queue ()
+        : _head(& _stub)
+        , _tail(& _stub)
+    {}
+
+    mpsc_queue (mpsc_queue const &) = delete;
+    mpsc_queue & operator = (mpsc_queue const &) = delete;
+
+public:
+    void push (mpsc_node * n) noexcept
+    {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = _head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    mpsc_node * pop () noexcept
+    {
+        auto tail = _tail;
+        auto next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == & _stub) {
+            if (next == nullptr)
+                return nullptr;
+
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+
+        // Producer is linking the node
+        if (tail != _head.load(std::memory_order_acquire))
+            return nullptr;
+
+        // The last node is returned, stub takes its place
+        push(& _stub);
+        next = tail->next.load(std::memory_order_acquire);
+
+        if (next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+};
+
+DEBBY__NAMESPACE_END
@@ -1,11 +1,18 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.20 Initial version.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 UPSERT updates value only.
+//                 Added `remove_many()`.
+//                 Added `for_each_key()`.
+//                 Added `increment()` and `append()`.
+//                 Added `put_many()`.
+//                 `remove_many()` binds keys as array parameter.
+//                 Key column uses "C" collation.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
 #include "../keyvalue_relational_database_impl.hpp"
@@ -19,8 +26,30 @@ DEBBY__NAMESPACE_BEGIN
 using keyvalue_database_t = keyvalue_database<backend_enum::psql>;
 
 template<> char const * keyvalue_database_t::impl::REMOVE_SQL = R"(DELETE FROM "{}" WHERE key=$1)";
-template<> char const * keyvalue_database_t::impl::PUT_SQL = R"(INSERT INTO "{}" (key, value) VALUES ($1, $2) ON CONFLICT (key) DO UPDATE SET key=$1, value=$2)";
+template<> char const * keyvalue_database_t::impl::PUT_SQL = R"(INSERT INTO "{}" (key, value) VALUES ($1, $2) ON CONFLICT (key) DO UPDATE SET value=EXCLUDED.value)";
 template<> char const * keyvalue_database_t::impl::GET_SQL = R"(SELECT value FROM "{}" WHERE key=$1)";
+// `key COLLATE "C"` matches the key column collation (or the "C" index of tables created
+// before), so the range predicate and ordering are served by the index.
+template<> char const * keyvalue_database_t::impl::FOR_EACH_KEY_SQL = R"(SELECT key FROM "{}" WHERE key COLLATE "C" >= $1 AND left(key, char_length($1)) = $1 ORDER BY key COLLATE "C")";
+template<> char const * keyvalue_database_t::impl::INIT_SQL = R"(INSERT INTO "{}" (key, value) VALUES ($1, $2) ON CONFLICT (key) DO NOTHING)";
+template<> char const * keyvalue_database_t::impl::LOCK_SQL = R"(SELECT value FROM "{}" WHERE key=$1 FOR UPDATE)";
+
+template <>
+void keyvalue_database_t::impl::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    if (keys.empty())
+        return;
+
+    error err;
+    auto stmt = this->prepare_cached(fmt::format(R"(DELETE FROM "{}" WHERE key = ANY($1::text[]))"
+        , _table_name), & err);
+
+    if (!err)
+        stmt.exec_batch(& err, keys);
+
+    if (err)
+        pfs::throw_or(perr, std::move(err));
+}
 
 template keyvalue_database_t::keyvalue_database ();
 template keyvalue_database_t::keyvalue_database (impl && d) noexcept;
@@ -30,6 +59,13 @@ template keyvalue_database_t & keyvalue_database_t::operator = (keyvalue_databas
 
 template void keyvalue_database_t::clear (error * perr);
 template void keyvalue_database_t::remove (key_type const & key, error * perr);
+template void keyvalue_database_t::remove_many (std::vector<key_type> const & keys, error * perr);
+template void keyvalue_database_t::write_batch (std::function<void ()> const & f, error * perr);
+template void keyvalue_database_t::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const;
+template void keyvalue_database_t::increment (key_type const & key, std::int64_t delta, error * perr);
+template void keyvalue_database_t::append (key_type const & key, char const * data, std::size_t len
+    , error * perr);
 template void keyvalue_database_t::set (key_type const & key, char const * value
     , std::size_t len, error * perr);
 
@@ -72,6 +108,37 @@ DEBBY__PSQL_GET(std::string)
 
 namespace psql {
 
+void put_many (keyvalue_database_t & db, std::vector<std::string> const & keys
+    , std::vector<std::string> const & values, error * perr)
+{
+    if (keys.size() != values.size()) {
+        pfs::throw_or(perr, make_error_code(errc::bad_value)
+            , tr::_("number of keys and values must be equal"));
+        return;
+    }
+
+    if (keys.empty())
+        return;
+
+    auto d = db.backend_impl();
+
+    // ON CONFLICT DO UPDATE can not affect the same row twice, so duplicate keys are
+    // reduced to the last value. Ordering by key also makes the lock order stable.
+    std::string sql = fmt::format(R"(INSERT INTO "{}" (key, value))"
+        R"( SELECT DISTINCT ON (k) k, v FROM unnest($1::text[], $2::bytea[]) WITH ORDINALITY AS u(k, v, n))"
+        R"( ORDER BY k, n DESC)"
+        R"( ON CONFLICT (key) DO UPDATE SET value=EXCLUDED.value)", d->table_name());
+
+    error err;
+    auto stmt = d->prepare_cached(sql, & err);
+
+    if (!err)
+        stmt.exec_batch(& err, keys, values);
+
+    if (err)
+        pfs::throw_or(perr, std::move(err));
+}
+
 keyvalue_database_t
 make_kv (std::string const & conninfo, std::string const & table_name, error * perr)
 {
@@ -83,11 +150,27 @@ make_kv (std::string const & conninfo, std::string const & table_name, error * p
         return keyvalue_database_t{};
     }
 
+    // PRIMARY KEY implies uniqueness, so no extra UNIQUE constraint (and index) is needed.
+    // "C" collation lets the primary key index serve byte-wise ordered prefix scans
+    // (`for_each_key()`) regardless of the database collation.
     std::string sql = fmt::format("CREATE TABLE IF NOT EXISTS \"{}\""
-        " (key TEXT NOT NULL UNIQUE, value BYTEA, PRIMARY KEY(key))", table_name);
+        " (key TEXT COLLATE \"C\" NOT NULL PRIMARY KEY, value BYTEA)", table_name);
 
     db.query(sql, & err);
 
+    // Tables created with the database collation get a separate "C" collation index
+    if (!err) {
+        sql = fmt::format("DO $$ BEGIN"
+            " IF EXISTS (SELECT 1 FROM pg_attribute a JOIN pg_collation c ON c.oid = a.attcollation"
+            " WHERE a.attrelid = '\"{0}\"'::regclass AND a.attname = 'key'"
+            " AND c.collname NOT IN ('C', 'POSIX')) THEN"
+            " CREATE INDEX IF NOT EXISTS \"{0}_key_c\" ON \"{0}\" (key COLLATE \"C\");"
+            " END IF;"
+            " END $$", table_name);
+
+        db.query(sql, & err);
+    }
+
     if (err) {
         pfs::throw_or(perr, std::move(err));
         return keyvalue_database_t{};
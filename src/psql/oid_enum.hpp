@@ -1,10 +1,11 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2024 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2023.11.26 Initial version.
+//      2026.10.18 Added array types.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "debby/namespace.hpp"
@@ -26,8 +27,38 @@ enum class oid_enum: unsigned int // See Oid definition
     , text    =  25 // TEXTOID
     , float32 = 700 // FLOAT4OID
     , float64 = 701 // FLOAT8OID
+    , varchar = 1043 // VARCHAROID
+
+    , boolean_array = 1000 // BOOLARRAYOID
+    , blob_array    = 1001 // BYTEAARRAYOID
+    , int16_array   = 1005 // INT2ARRAYOID
+    , int32_array   = 1007 // INT4ARRAYOID
+    , text_array    = 1009 // TEXTARRAYOID
+    , varchar_array = 1015 // VARCHARARRAYOID
+    , int64_array   = 1016 // INT8ARRAYOID
+    , float32_array = 1021 // FLOAT4ARRAYOID
+    , float64_array = 1022 // FLOAT8ARRAYOID
 };
 
+/**
+ * Returns element type of the array @a type or @a type itself if it is not an array one.
+ */
+inline oid_enum element_type (oid_enum type) noexcept
+{
+    switch (type) {
+        case oid_enum::boolean_array: return oid_enum::boolean;
+        case oid_enum::blob_array: return oid_enum::blob;
+        case oid_enum::int16_array: return oid_enum::int16;
+        case oid_enum::int32_array: return oid_enum::int32;
+        case oid_enum::text_array: return oid_enum::text;
+        case oid_enum::varchar_array: return oid_enum::varchar;
+        case oid_enum::int64_array: return oid_enum::int64;
+        case oid_enum::float32_array: return oid_enum::float32;
+        case oid_enum::float64_array: return oid_enum::float64;
+        default: return type;
+    }
+}
+
 } // namespace psql
 
 DEBBY__NAMESPACE_END
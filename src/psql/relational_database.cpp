@@ -1,11 +1,13 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2024 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2023.11.25 Initial version.
 //      2024.11.02 V2 started.
+//      2026.10.18 Added slow-query log.
+//                 Added nested transactions (savepoints) and transaction modes.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../relational_database_common.hpp"
 #include "relational_database_impl.hpp"
@@ -23,6 +25,17 @@ template database_t::~relational_database ();
 template database_t & database_t::operator = (relational_database && other) noexcept;
 
 template std::size_t database_t::rows_count (std::string const & table_name, error * perr);
+template void database_t::enable_slow_query_log (slow_query_options opts);
+template void database_t::disable_slow_query_log ();
+template std::vector<slow_query_record> database_t::slow_queries () const;
+template void database_t::clear_slow_queries ();
+template void database_t::begin (error * perr);
+template void database_t::begin (transaction_mode mode, error * perr);
+template void database_t::commit (error * perr);
+template void database_t::rollback (error * perr);
+template void database_t::rollback_to (int depth, error * perr);
+template int database_t::transaction_depth () const noexcept;
+template bool database_t::restart_transaction (error const & err, int attempt);
 
 template <>
 void database_t::query (std::string const & sql, error * perr)
@@ -36,24 +49,6 @@ database_t::result_type database_t::exec (std::string const & sql, error * perr)
     return _d->exec(sql, perr);
 }
 
-template <>
-void database_t::begin (error * perr)
-{
-    query("BEGIN", perr);
-}
-
-template <>
-void database_t::commit (error * perr)
-{
-    query("COMMIT", perr);
-}
-
-template <>
-void database_t::rollback (error * perr)
-{
-    query("ROLLBACK", perr);
-}
-
 template <>
 database_t::statement_type database_t::prepare (std::string const & sql, error * perr)
 {
@@ -1,17 +1,28 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.14 Initial version (moved from relational_database.cpp).
+//      2026.10.18 Prepared statements cache tracked on the client side.
+//                 Fixed execution of non-cached (unnamed) statements.
+//                 Added instrumentation.
+//                 Added slow-query log.
+//                 Parameter types are shared by cached statements.
+//                 Added transaction depth tracking.
+//                 Added transaction restart hooks.
 ////////////////////////////////////////////////////////////////////////////////
 #include "debby/relational_database.hpp"
 #include "result_impl.hpp"
 #include "statement_impl.hpp"
 #include "utils.hpp"
+#include "../slow_query_log.hpp"
+#include <pfs/fmt.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/string_view.hpp>
+#include <memory>
+#include <unordered_map>
 
 extern "C" {
 #include <libpq-fe.h>
@@ -27,9 +38,26 @@ class database_t::impl
 public:
     using native_type = struct pg_conn *;
 
+    struct cache_entry
+    {
+        std::string name;
+        std::shared_ptr<psql::param_types> param_types;
+    };
+
+    using cache_type = std::unordered_map<std::string, cache_entry>;
+
 private:
     native_type _dbh {nullptr};
 
+    // Prepared statements cache: SQL -> statement name and parameter types. Statement
+    // names are generated since the server truncates them to NAMEDATALEN - 1 bytes.
+    cache_type _cache;
+
+    int _transaction_depth {0}; // Zero or number of nested transactions started by `begin()`
+
+    // Allocated separately to keep address stable for statements
+    std::unique_ptr<slow_query_log> _slow_log {new slow_query_log};
+
 public:
     impl (native_type dbh) : _dbh(dbh)
     {}
@@ -38,6 +66,10 @@ public:
     {
         _dbh = d._dbh;
         d._dbh = nullptr;
+        _cache = std::move(d._cache);
+        _transaction_depth = d._transaction_depth;
+        d._transaction_depth = 0;
+        _slow_log = std::move(d._slow_log);
     }
 
     ~impl ()
@@ -49,8 +81,57 @@ public:
     }
 
 public:
+    static char const * begin_sql (transaction_mode mode) noexcept
+    {
+        switch (mode) {
+            case transaction_mode::standard:
+                return "BEGIN";
+            case transaction_mode::read_committed:
+                return "BEGIN ISOLATION LEVEL READ COMMITTED";
+            case transaction_mode::repeatable_read:
+                return "BEGIN ISOLATION LEVEL REPEATABLE READ";
+            case transaction_mode::serializable:
+                return "BEGIN ISOLATION LEVEL SERIALIZABLE";
+            default:
+                break;
+        }
+
+        return nullptr;
+    }
+
+    int & transaction_depth () noexcept
+    {
+        return _transaction_depth;
+    }
+
+    bool in_transaction () const noexcept
+    {
+        if (_dbh == nullptr)
+            return false;
+
+        auto status = PQtransactionStatus(_dbh);
+        return status == PQTRANS_INTRANS || status == PQTRANS_INERROR;
+    }
+
+    // Transaction conflicts are not reported by the backend yet
+    int max_transaction_retries () const noexcept
+    {
+        return 0;
+    }
+
+    void on_transaction_restart () noexcept
+    {}
+
+    slow_query_log & slow_log () const noexcept
+    {
+        return *_slow_log;
+    }
+
     database_t::result_type exec (std::string const & sql, error * perr)
     {
+        bool logged = _slow_log->enabled();
+        auto start = logged ? slow_query_log::clock_type::now() : slow_query_log::clock_type::time_point{};
+
         PGresult * res = PQexec(_dbh, sql.c_str());
 
         if (res == nullptr) {
@@ -76,6 +157,21 @@ public:
             return database_t::result_type{};
         }
 
+        std::chrono::microseconds elapsed;
+
+        if (logged && _slow_log->is_slow(start, elapsed)) {
+            slow_query_record rec;
+            rec.timestamp = std::chrono::system_clock::now();
+            rec.sql = sql;
+            rec.elapsed = elapsed;
+            rec.rows = psql::rows_touched(res);
+
+            if (_slow_log->explain())
+                rec.plan = psql::explain(_dbh, sql, 0, nullptr, nullptr, nullptr);
+
+            _slow_log->push(std::move(rec));
+        }
+
         result_type::impl d{res};
         return database_t::result_type{std::move(d)};
     }
@@ -91,28 +187,25 @@ public:
         if (_dbh == nullptr)
             return database_t::statement_type{};
 
-        auto res = PQdescribePrepared(_dbh, sql.c_str());
-
-        if (res) {
-            ExecStatusType status = PQresultStatus(res);
+        if (cached) {
+            auto pos = _cache.find(sql);
 
-            if (status == PGRES_COMMAND_OK) {
-                statement_t::impl d{_dbh, sql};
+            // Found in cache
+            if (pos != _cache.end()) {
+                statement_t::impl d{_dbh, pos->second.name, sql, _slow_log.get()
+                    , pos->second.param_types};
+#if DEBBY__INSTRUMENTATION_ENABLED
+                d.fingerprint = instrumentation::register_sql(sql.c_str());
+#endif
                 return database_t::statement_type {std::move(d)};
             }
-        }/*  else {
-            pfs::throw_or(perr, error {
-                  errc::backend_error
-                , tr::f_("check prepared statement existence failure: {}: {}"
-                    , sql, psql::build_errstr(_dbh))
-            });
+        }
 
-            return database_t::statement_type{};
-        } */
+        // Non-cached statement is prepared as unnamed one, it is replaced by
+        // the next unnamed statement.
+        std::string name = cached ? fmt::format("debby_stmt_{}", _cache.size() + 1) : std::string{};
 
-        PGresult * sth = cached
-            ? PQprepare(_dbh, sql.c_str(), sql.c_str(), 0, nullptr)
-            : PQprepare(_dbh, "", sql.c_str(), 0, nullptr);;
+        PGresult * sth = PQprepare(_dbh, name.c_str(), sql.c_str(), 0, nullptr);
 
         if (sth == nullptr) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -133,7 +226,15 @@ public:
             return database_t::statement_type{};
         }
 
-        statement_t::impl d{_dbh, sql};
+        auto param_types = std::make_shared<psql::param_types>();
+
+        if (cached)
+            _cache.emplace(sql, cache_entry{name, param_types});
+
+        statement_t::impl d{_dbh, std::move(name), sql, _slow_log.get(), std::move(param_types)};
+#if DEBBY__INSTRUMENTATION_ENABLED
+        d.fingerprint = instrumentation::register_sql(sql.c_str());
+#endif
         return database_t::statement_type{std::move(d)};
     }
 };
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2025 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -7,13 +7,20 @@
 //      2023.11.25 Initial version.
 //      2024.11.02 V2 started.
 //      2025.09.30 Changed get implementation.
+//      2026.10.18 Added instrumentation.
+//                 Added `column()`.
+//                 Added `fetch_columns()`.
+//                 Added row view.
 ////////////////////////////////////////////////////////////////////////////////
+#include "../column_batch_builder.hpp"
+#include "../instrumentation.hpp"
 #include "oid_enum.hpp"
 #include "result_impl.hpp"
 #include <pfs/endian.hpp>
 #include <pfs/i18n.hpp>
 #include <pfs/integer.hpp>
 #include <pfs/real.hpp>
+#include <algorithm>
 //
 DEBBY__NAMESPACE_BEGIN
 
@@ -101,9 +108,25 @@ std::string result_t::column_name (int column) const noexcept
     return cname == nullptr ? std::string{} : std::string{cname};
 }
 
+template <>
+result_t::column_handle result_t::column (std::string const & name, error * perr) const
+{
+    auto index = _d->column_index(name);
+
+    if (index < 0) {
+        pfs::throw_or(perr, make_error_code(errc::column_not_found)
+            , tr::f_("bad column name: {}", name));
+        return column_handle{};
+    }
+
+    return column_handle{index + 1};
+}
+
 template <>
 void result_t::next ()
 {
+    DEBBY__INSTRUMENT(backend_enum::psql, result_next, _d->fingerprint, 0);
+
     if (_d->row_index < _d->row_count) {
         ++_d->row_index;
     } else {
@@ -418,4 +441,240 @@ pfs::optional<std::string> result_t::get<std::string> (std::string const & colum
     return _d->get_string(column, perr);
 }
 
+static column_type batch_column_type (psql::oid_enum t)
+{
+    switch (t) {
+        case psql::oid_enum::boolean:
+        case psql::oid_enum::int16:
+        case psql::oid_enum::int32:
+        case psql::oid_enum::int64:
+            return column_type::int64;
+
+        case psql::oid_enum::float32:
+        case psql::oid_enum::float64:
+            return column_type::float64;
+
+        default:
+            return column_type::binary;
+    }
+}
+
+template <>
+std::size_t result_t::fetch_columns (column_batch & batch, std::size_t batch_size, error * perr)
+{
+    namespace builder = column_batch_builder;
+
+    auto sth = _d->sth;
+    auto first_row = _d->row_index;
+    auto n = static_cast<int>((std::min)(batch_size, static_cast<std::size_t>(_d->row_count - first_row)));
+
+    builder::reset(batch, _d->column_count, static_cast<std::size_t>(n));
+
+    // Column-major: the type is dispatched once per column
+    for (int column = 0; column < _d->column_count; column++) {
+        auto & c = batch.columns[column];
+        auto oid = static_cast<psql::oid_enum>(PQftype(sth, column));
+
+        c.name = PQfname(sth, column);
+        c.type = batch_column_type(oid);
+        builder::start_column(c, static_cast<std::size_t>(n));
+
+        for (int i = 0; i < n; i++) {
+            auto row = first_row + i;
+
+            if (PQgetisnull(sth, row, column) != 0) {
+                builder::append_null(c, i);
+                continue;
+            }
+
+            auto raw_data = PQgetvalue(sth, row, column);
+            auto size = PQgetlength(sth, row, column);
+
+            switch (c.type) {
+                case column_type::int64: {
+                    if (oid == psql::oid_enum::boolean) {
+                        builder::append_int64(c, i, raw_data[0] == 't' ? 1 : 0);
+                        break;
+                    }
+
+                    std::error_code ec;
+                    auto x = pfs::to_integer<std::int64_t>(raw_data, raw_data + size, ec);
+
+                    if (ec) {
+                        pfs::throw_or(perr, make_error_code(errc::bad_value)
+                            , tr::f_("parse integer stored at column {} failure: {}", column + 1, ec.message()));
+                        return 0;
+                    }
+
+                    builder::append_int64(c, i, x);
+                    break;
+                }
+
+                case column_type::float64: {
+                    auto opt = pfs::to_real<double>(raw_data, raw_data + size, '.');
+
+                    if (!opt) {
+                        pfs::throw_or(perr, make_error_code(errc::bad_value)
+                            , tr::f_("parse floating point value stored at column {} failure", column + 1));
+                        return 0;
+                    }
+
+                    builder::append_float64(c, i, *opt);
+                    break;
+                }
+
+                case column_type::binary: {
+                    auto is_hex = oid == psql::oid_enum::blob && size >= 2
+                        && size % 2 == 0 && raw_data[0] == '\\' && raw_data[1] == 'x';
+
+                    if (!is_hex) {
+                        builder::append_binary(c, i, raw_data, static_cast<std::size_t>(size));
+                        break;
+                    }
+
+                    // Decoded in place of the data buffer
+                    auto offset = c.data.size();
+                    c.data.resize(offset + (size - 2) / 2);
+
+                    for (int k = 2; k < size; k += 2) {
+                        auto a = from_hex_char(raw_data[k]);
+                        auto b = from_hex_char(raw_data[k + 1]);
+
+                        if (a < 0 || b < 0) {
+                            pfs::throw_or(perr, make_error_code(errc::bad_value)
+                                , tr::f_("bad blob stored at column {}", column + 1));
+                            return 0;
+                        }
+
+                        c.data[offset + (k - 2) / 2] = static_cast<char>(a * 16 + b);
+                    }
+
+                    builder::set_validity(c, i, true);
+                    c.offsets.push_back(static_cast<std::int64_t>(c.data.size()));
+                    break;
+                }
+            }
+        }
+    }
+
+    batch.row_count = static_cast<std::size_t>(n);
+    _d->row_index += n;
+    return batch.row_count;
+}
+
+template <>
+bool result_t::row_view::is_null (int column) const noexcept
+{
+    return PQgetisnull(_r->_d->sth, _r->_d->row_index, column - 1) != 0;
+}
+
+template <>
+std::int64_t result_t::row_view::get_int64 (int column) const noexcept
+{
+    auto d = _r->_d;
+    column--;
+
+    if (PQgetisnull(d->sth, d->row_index, column) != 0)
+        return 0;
+
+    auto raw_data = PQgetvalue(d->sth, d->row_index, column);
+    auto size = PQgetlength(d->sth, d->row_index, column);
+
+    switch (static_cast<psql::oid_enum>(PQftype(d->sth, column))) {
+        case psql::oid_enum::int16:
+        case psql::oid_enum::int32:
+        case psql::oid_enum::int64: {
+            std::error_code ec;
+            auto x = pfs::to_integer<std::int64_t>(raw_data, raw_data + size, ec);
+            return ec ? 0 : x;
+        }
+
+        case psql::oid_enum::boolean:
+            return raw_data[0] == 't' ? 1 : 0;
+
+        default:
+            break;
+    }
+
+    // Values stored by key/value database and other ones
+    error err;
+    auto opt = d->get_int64(column + 1, & err);
+    return (err || !opt) ? 0 : *opt;
+}
+
+template <>
+double result_t::row_view::get_double (int column) const noexcept
+{
+    auto d = _r->_d;
+    column--;
+
+    if (PQgetisnull(d->sth, d->row_index, column) != 0)
+        return 0;
+
+    auto raw_data = PQgetvalue(d->sth, d->row_index, column);
+    auto size = PQgetlength(d->sth, d->row_index, column);
+
+    switch (static_cast<psql::oid_enum>(PQftype(d->sth, column))) {
+        case psql::oid_enum::float32:
+        case psql::oid_enum::float64: {
+            auto opt = pfs::to_real<double>(raw_data, raw_data + size, '.');
+            return opt ? *opt : 0;
+        }
+
+        case psql::oid_enum::int16:
+        case psql::oid_enum::int32:
+        case psql::oid_enum::int64:
+            return static_cast<double>(get_int64(column + 1));
+
+        default:
+            break;
+    }
+
+    error err;
+    auto opt = d->get_double(column + 1, & err);
+    return (err || !opt) ? 0 : *opt;
+}
+
+template <>
+pfs::string_view result_t::row_view::text (int column) const noexcept
+{
+    auto d = _r->_d;
+    column--;
+
+    return pfs::string_view {PQgetvalue(d->sth, d->row_index, column)
+        , static_cast<std::size_t>(PQgetlength(d->sth, d->row_index, column))};
+}
+
+template <>
+pfs::string_view result_t::row_view::blob (int column) const noexcept
+{
+    auto d = _r->_d;
+    auto raw = text(column);
+    column--;
+
+    auto is_hex = static_cast<psql::oid_enum>(PQftype(d->sth, column)) == psql::oid_enum::blob
+        && raw.size() >= 2 && raw.size() % 2 == 0 && raw[0] == '\\' && raw[1] == 'x';
+
+    if (!is_hex)
+        return raw;
+
+    if (d->blob_buffers.size() < static_cast<std::size_t>(d->column_count))
+        d->blob_buffers.resize(d->column_count);
+
+    auto & buf = d->blob_buffers[column];
+    buf.resize((raw.size() - 2) / 2);
+
+    for (std::size_t i = 2; i < raw.size(); i += 2) {
+        auto a = from_hex_char(raw[i]);
+        auto b = from_hex_char(raw[i + 1]);
+
+        if (a < 0 || b < 0)
+            return raw;
+
+        buf[(i - 2) / 2] = static_cast<char>(a * 16 + b);
+    }
+
+    return pfs::string_view {buf.data(), buf.size()};
+}
+
 DEBBY__NAMESPACE_END
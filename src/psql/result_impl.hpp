@@ -1,15 +1,21 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.02 Initial version.
 //      2025.09.30 Changed get implementation.
+//      2026.10.18 Added SQL fingerprint for instrumentation.
+//                 Column names are mapped to indices once per result.
+//                 Added decoded blob buffers for row view.
 ////////////////////////////////////////////////////////////////////////////////
 #include "debby/namespace.hpp"
 #include "debby/result.hpp"
 #include <pfs/optional.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 #include <libpq-fe.h>
@@ -30,6 +36,15 @@ public:
     int column_count {0}; // Number of fields
     int row_count {0};    // Total number of tuples
     int row_index {0};
+    mutable std::unordered_map<std::string, int> column_mapping;
+
+    // Decoded `BYTEA` values of the current row referenced by `row_view::blob()`
+    // (one buffer per column, memory is reused by the next rows)
+    mutable std::vector<std::string> blob_buffers;
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+    std::uint64_t fingerprint {0};
+#endif
 
 public:
     impl (handle_type h)
@@ -45,6 +60,11 @@ public:
         column_count = other.column_count;
         row_count  = other.row_count;
         row_index  = other.row_index;
+        column_mapping = std::move(other.column_mapping);
+        blob_buffers = std::move(other.blob_buffers);
+#if DEBBY__INSTRUMENTATION_ENABLED
+        fingerprint = other.fingerprint;
+#endif
 
         other.sth = nullptr;
     }
@@ -67,17 +87,25 @@ public:
     pfs::optional<double> get_double (std::string const & column_name, error * perr) const;
     pfs::optional<std::string> get_string (std::string const & column_name, error * perr) const;
 
-private:
+    /**
+     * @return Column index started from 0 and -1 if column not found
+     */
     int column_index (std::string const & column_name) const
     {
-        for (int i = 0; i < column_count; i++) {
-            auto name = PQfname(sth, i);
+        if (column_mapping.empty()) {
+            column_mapping.reserve(column_count);
 
-            if (column_name == name)
-                return i;
+            // The first one wins for duplicate names (as in the linear search)
+            for (int i = 0; i < column_count; i++)
+                column_mapping.insert({std::string{PQfname(sth, i)}, i});
         }
 
-        return -1;
+        auto pos = column_mapping.find(column_name);
+
+        if (pos == column_mapping.end())
+            return -1;
+
+        return pos->second;
     }
 };
 
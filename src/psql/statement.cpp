@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2025 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -7,6 +7,10 @@
 //      2023.11.25 Initial version.
 //      2024.10.29 V2 started.
 //      2025.09.30 Changed bind implementation.
+//      2026.10.18 Added instrumentation.
+//                 Added slow-query log.
+//                 Added binary parameter binding.
+//                 Added `bind_array()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "result_impl.hpp"
 #include "statement_impl.hpp"
@@ -16,14 +20,67 @@
 
 DEBBY__NAMESPACE_BEGIN
 
+Oid statement_t::impl::param_type (int index)
+{
+    if (!_param_types->described) {
+        _param_types->described = true;
+
+        // Described once per prepared statement, the failure is not an error: the
+        // values are passed as text then.
+        auto sth = PQdescribePrepared(_dbh, _name.c_str());
+
+        if (sth != nullptr) {
+            if (PQresultStatus(sth) == PGRES_COMMAND_OK) {
+                auto n = PQnparams(sth);
+                _param_types->oids.resize(n);
+
+                for (int i = 0; i < n; i++)
+                    _param_types->oids[i] = PQparamtype(sth, i);
+            }
+
+            PQclear(sth);
+        }
+    }
+
+    return index >= 0 && static_cast<std::size_t>(index) < _param_types->oids.size()
+        ? _param_types->oids[index] : Oid{0};
+}
+
+void statement_t::impl::log_slow_query (PGresult * sth, std::chrono::microseconds elapsed)
+{
+    slow_query_record rec;
+    rec.timestamp = std::chrono::system_clock::now();
+    rec.sql = _sql;
+    rec.elapsed = elapsed;
+    rec.rows = psql::rows_touched(sth);
+
+    for (std::size_t i = 0; i < _param_values.size(); i++) {
+        slow_query_log::append_param(rec.params, static_cast<int>(i + 1), _param_values[i]
+            , static_cast<std::size_t>(_param_lengths[i]), _param_formats[i] != 0);
+    }
+
+    if (_slow_log->explain()) {
+        rec.plan = psql::explain(_dbh, _sql, static_cast<int>(_param_values.size())
+            , _param_values.data(), _param_lengths.data(), _param_formats.data());
+    }
+
+    _slow_log->push(std::move(rec));
+}
+
 statement_t::result_type statement_t::impl::exec (error * perr)
 {
+    bool logged = _slow_log != nullptr && _slow_log->enabled();
+    auto start = logged ? slow_query_log::clock_type::now() : slow_query_log::clock_type::time_point{};
+
     int result_in_text_format = 0;
 
-    for (int i = 0; i < _param_transient_values.size(); i++) {
+    // Resolved here since the arena and buffers may be reallocated by binding
+    for (std::size_t i = 0; i < _param_storage.size(); i++) {
         if (_param_lengths[i] > 0) {
-            if (_param_values[i] == nullptr) // nullptr - not a static value, expected transient value
-                _param_values[i] = _param_transient_values[i].c_str();
+            if (_param_storage[i] == param_storage::scalar)
+                _param_values[i] = _scalar_arena.data() + i * SCALAR_SIZE;
+            else if (_param_storage[i] == param_storage::buffer)
+                _param_values[i] = _param_buffers[i].data();
         } else {
             _param_values[i] = nullptr;
         }
@@ -55,7 +112,18 @@ statement_t::result_type statement_t::impl::exec (error * perr)
         return result_t{};
     }
 
-    return result_t{result_t::impl{sth}};
+    std::chrono::microseconds elapsed;
+
+    if (logged && _slow_log->is_slow(start, elapsed))
+        log_slow_query(sth, elapsed);
+
+    result_t::impl d{sth};
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+    d.fingerprint = fingerprint;
+#endif
+
+    return result_t{std::move(d)};
 }
 
 template <>
@@ -134,7 +202,7 @@ bool statement_t::bind (int index, std::nullptr_t, error *)
 template <>
 bool statement_t::bind (int index, char const * ptr, error *)
 {
-    return _d->bind_string(index, ptr, std::strlen(ptr));
+    return _d->bind_string_static(index, ptr, std::strlen(ptr));
 }
 
 template <>
@@ -143,9 +211,27 @@ bool statement_t::bind (int index, char const * ptr, std::size_t len, error *)
     return _d->bind_blob(index, ptr, len);
 }
 
+#define DEBBY__ARRAY_BIND(t)                                                      \
+    template <>                                                                   \
+    template <>                                                                   \
+    bool statement_t::bind_array<t> (int index, std::vector<t> const & values, error *) \
+    {                                                                             \
+        return _d->bind_array<t>(index, values);                                  \
+    }
+
+DEBBY__ARRAY_BIND(bool)
+DEBBY__ARRAY_BIND(short)
+DEBBY__ARRAY_BIND(int)
+DEBBY__ARRAY_BIND(long)
+DEBBY__ARRAY_BIND(long long)
+DEBBY__ARRAY_BIND(float)
+DEBBY__ARRAY_BIND(double)
+DEBBY__ARRAY_BIND(std::string)
+
 template <>
 statement_t::result_type statement_t::exec (error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::psql, stmt_exec, _d->fingerprint, 0);
     return _d->exec(perr);
 }
 
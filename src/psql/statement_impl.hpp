@@ -1,17 +1,31 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.02 Initial version.
 //      2025.09.30 Changed bind implementation.
+//      2026.10.18 Added SQL fingerprint for instrumentation.
+//                 Added slow-query log.
+//                 Added binary parameter binding.
+//                 Added array parameter binding.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "debby/statement.hpp"
+#include "../instrumentation.hpp"
+#include "../slow_query_log.hpp"
+#include "oid_enum.hpp"
+#include <pfs/fmt.hpp>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 extern "C" {
 #include <libpq-fe.h>
@@ -21,6 +35,20 @@ DEBBY__NAMESPACE_BEGIN
 
 using statement_t = statement<backend_enum::psql>;
 
+namespace psql {
+
+/**
+ * Parameter types of the prepared statement as resolved by the server. Shared by the
+ * statements created from the same cached one, so the statement is described once.
+ */
+struct param_types
+{
+    bool described {false};
+    std::vector<Oid> oids;
+};
+
+} // namespace psql
+
 template <>
 class statement_t::impl
 {
@@ -29,28 +57,65 @@ public:
 
     static constexpr int INC_SIZE = 8;
 
+#if DEBBY__INSTRUMENTATION_ENABLED
+    std::uint64_t fingerprint {0};
+#endif
+
+private:
+    enum class param_storage: char
+    {
+          external // Caller-owned buffer or NULL
+        , scalar   // Binary value in the scalar arena
+        , buffer   // Value copied into the parameter buffer
+    };
+
+    // Size of the scalar arena slot per parameter (enough for int8/float8)
+    static constexpr std::size_t SCALAR_SIZE = 8;
+
 private:
     native_type _dbh {nullptr};
     std::string _name;
-    std::vector<std::string> _param_transient_values;
+    std::string _sql;
+    slow_query_log * _slow_log {nullptr};
+    std::shared_ptr<psql::param_types> _param_types;
+
+    // Reusable storage: the arena and buffers keep their capacity between executions,
+    // so the rebinding does not allocate.
+    std::vector<char> _scalar_arena;
+    std::vector<std::string> _param_buffers;
+    std::vector<param_storage> _param_storage;
+
     std::vector<char const *> _param_values;
     std::vector<int> _param_lengths;
     std::vector<int> _param_formats;
 
 public:
-    impl (native_type dbh, std::string const & name)
+    impl (native_type dbh, std::string const & name, std::string const & sql = std::string{}
+        , slow_query_log * slow_log = nullptr
+        , std::shared_ptr<psql::param_types> param_types = std::shared_ptr<psql::param_types>{})
         : _dbh(dbh)
         , _name(name)
+        , _sql(sql)
+        , _slow_log(slow_log)
+        , _param_types(param_types != nullptr ? std::move(param_types) : std::make_shared<psql::param_types>())
     {}
 
     impl (impl && other)
         : _dbh(other._dbh)
         , _name(std::move(other._name))
-        , _param_transient_values(std::move(other._param_transient_values))
+        , _sql(std::move(other._sql))
+        , _slow_log(other._slow_log)
+        , _param_types(std::move(other._param_types))
+        , _scalar_arena(std::move(other._scalar_arena))
+        , _param_buffers(std::move(other._param_buffers))
+        , _param_storage(std::move(other._param_storage))
         , _param_values(std::move(other._param_values))
         , _param_lengths(std::move(other._param_lengths))
         , _param_formats(std::move(other._param_formats))
     {
+#if DEBBY__INSTRUMENTATION_ENABLED
+        fingerprint = other.fingerprint;
+#endif
         other._dbh = nullptr;
     }
 
@@ -59,44 +124,296 @@ public:
 private:
     void ensure_capacity (int index)
     {
-        if (index >= _param_transient_values.size()) {
+        if (index >= _param_storage.size()) {
             std::size_t size = index + 1;
-            auto reserve_size = (std::max)(size, _param_transient_values.size() + INC_SIZE);
-            _param_transient_values.reserve(reserve_size);
+            auto reserve_size = (std::max)(size, _param_storage.size() + INC_SIZE);
+            _param_buffers.reserve(reserve_size);
+            _param_storage.reserve(reserve_size);
             _param_values.reserve(reserve_size);
             _param_lengths.reserve(reserve_size);
             _param_formats.reserve(reserve_size);
 
-            _param_transient_values.resize(size);
+            _scalar_arena.resize(size * SCALAR_SIZE);
+            _param_buffers.resize(size);
+            _param_storage.resize(size, param_storage::external);
             _param_values.resize(size);
             _param_lengths.resize(size);
             _param_formats.resize(size);
         }
     }
 
+    /**
+     * Returns parameter type resolved by the server or @c 0 if it is unknown.
+     */
+    Oid param_type (int index);
+
+    template <typename T>
+    static std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool>
+    to_int64 (T value, std::int64_t & result)
+    {
+        result = static_cast<std::int64_t>(value);
+        return true;
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_integral<T>::value && !std::is_signed<T>::value, bool>
+    to_int64 (T value, std::int64_t & result)
+    {
+        if (static_cast<std::uint64_t>(value) > static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max)()))
+            return false;
+
+        result = static_cast<std::int64_t>(value);
+        return true;
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_floating_point<T>::value, bool>
+    to_int64 (T, std::int64_t &)
+    {
+        return false;
+    }
+
+    // Stores @a size low bytes of @a value in network byte order
+    static void encode_be (char * p, std::uint64_t value, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; i++)
+            p[i] = static_cast<char>((value >> (8 * (size - i - 1))) & 0xFF);
+    }
+
+    /**
+     * Encodes @a value in binary format of @a type into @a out (at least SCALAR_SIZE bytes).
+     *
+     * @return Encoded value size or zero if the value should be passed as text.
+     */
+    template <typename T>
+    static std::size_t encode_binary (psql::oid_enum type, T value, char * out)
+    {
+        std::int64_t n = 0;
+        bool integral = to_int64(value, n);
+
+        switch (type) {
+            case psql::oid_enum::boolean:
+                if (!std::is_integral<T>::value)
+                    return 0;
+
+                encode_be(out, value != 0 ? 1 : 0, 1);
+                return 1;
+
+            case psql::oid_enum::int16:
+                if (!integral || n < (std::numeric_limits<std::int16_t>::min)()
+                        || n > (std::numeric_limits<std::int16_t>::max)())
+                    return 0;
+
+                encode_be(out, static_cast<std::uint16_t>(n), 2);
+                return 2;
+
+            case psql::oid_enum::int32:
+                if (!integral || n < (std::numeric_limits<std::int32_t>::min)()
+                        || n > (std::numeric_limits<std::int32_t>::max)())
+                    return 0;
+
+                encode_be(out, static_cast<std::uint32_t>(n), 4);
+                return 4;
+
+            case psql::oid_enum::int64:
+                if (!integral)
+                    return 0;
+
+                encode_be(out, static_cast<std::uint64_t>(n), 8);
+                return 8;
+
+            case psql::oid_enum::float32: {
+                auto f = static_cast<float>(value);
+                std::uint32_t bits = 0;
+                std::memcpy(& bits, & f, sizeof(bits));
+                encode_be(out, bits, 4);
+                return 4;
+            }
+
+            case psql::oid_enum::float64: {
+                auto f = static_cast<double>(value);
+                std::uint64_t bits = 0;
+                std::memcpy(& bits, & f, sizeof(bits));
+                encode_be(out, bits, 8);
+                return 8;
+            }
+
+            default:
+                return 0;
+        }
+    }
+
+    // Encodes value in binary format according to the parameter type, returns
+    // false if the value should be passed as text.
+    template <typename T>
+    bool bind_binary (int index, T value)
+    {
+        auto size = encode_binary(static_cast<psql::oid_enum>(param_type(index)), value
+            , _scalar_arena.data() + index * SCALAR_SIZE);
+
+        if (size == 0)
+            return false;
+
+        _param_storage[index] = param_storage::scalar;
+        _param_values[index] = nullptr;
+        _param_lengths[index] = static_cast<int>(size);
+        _param_formats[index] = 1; // binary format
+        return true;
+    }
+
+    static void append_be (std::string & buf, std::uint64_t value, std::size_t size)
+    {
+        char tmp[SCALAR_SIZE];
+        encode_be(tmp, value, size);
+        buf.append(tmp, size);
+    }
+
+    // One-dimensional array header in binary format (see array_send() in PostgreSQL sources)
+    static void append_array_header (std::string & buf, psql::oid_enum elem_type, std::size_t count)
+    {
+        append_be(buf, count > 0 ? 1 : 0, 4); // Number of dimensions
+        append_be(buf, 0, 4);                 // Has no NULLs
+        append_be(buf, static_cast<std::uint32_t>(elem_type), 4);
+
+        if (count > 0) {
+            append_be(buf, count, 4); // Dimension size
+            append_be(buf, 1, 4);     // Lower bound
+        }
+    }
+
+    static bool encode_array (std::string & buf, psql::oid_enum elem_type
+        , std::vector<std::string> const & values)
+    {
+        if (elem_type != psql::oid_enum::text && elem_type != psql::oid_enum::varchar
+                && elem_type != psql::oid_enum::blob) {
+            return false;
+        }
+
+        append_array_header(buf, elem_type, values.size());
+
+        for (auto const & v: values) {
+            append_be(buf, v.size(), 4);
+            buf.append(v);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_arithmetic<T>::value, bool>
+    encode_array (std::string & buf, psql::oid_enum elem_type, std::vector<T> const & values)
+    {
+        append_array_header(buf, elem_type, values.size());
+
+        for (T v: values) {
+            char tmp[SCALAR_SIZE];
+            auto size = encode_binary(elem_type, v, tmp);
+
+            if (size == 0)
+                return false;
+
+            append_be(buf, size, 4);
+            buf.append(tmp, size);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value, void>
+    format_text (std::string & buf, T value)
+    {
+        if (std::is_same<T, bool>::value)
+            buf += value ? '1' : '0';
+        else if (std::is_signed<T>::value)
+            fmt::format_to(std::back_inserter(buf), "{}", static_cast<long long>(value));
+        else
+            fmt::format_to(std::back_inserter(buf), "{}", static_cast<unsigned long long>(value));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_floating_point<T>::value, void>
+    format_text (std::string & buf, T value)
+    {
+        fmt::format_to(std::back_inserter(buf), "{}", value);
+    }
+
+    static void format_element (std::string & buf, std::string const & value)
+    {
+        buf += '"';
+
+        for (auto c: value) {
+            if (c == '"' || c == '\\')
+                buf += '\\';
+
+            buf += c;
+        }
+
+        buf += '"';
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic<T>::value, void>
+    format_element (std::string & buf, T value)
+    {
+        format_text(buf, value);
+    }
+
+    // Text array literal: {"a","b"} or {1,2}
+    template <typename T>
+    void format_array (std::string & buf, std::vector<T> const & values)
+    {
+        buf += '{';
+
+        for (std::size_t i = 0; i < values.size(); i++) {
+            if (i > 0)
+                buf += ',';
+
+            format_element(buf, static_cast<T>(values[i]));
+        }
+
+        buf += '}';
+    }
+
+    void bind_buffer (int index, char const * ptr, std::size_t len, int format)
+    {
+        _param_buffers[index].assign(ptr, len);
+        _param_storage[index] = param_storage::buffer;
+        _param_values[index] = nullptr;
+        _param_lengths[index] = static_cast<int>(len);
+        _param_formats[index] = format;
+    }
+
+    void bind_external (int index, char const * ptr, std::size_t len, int format)
+    {
+        _param_storage[index] = param_storage::external;
+        _param_values[index] = ptr;
+        _param_lengths[index] = static_cast<int>(len);
+        _param_formats[index] = format;
+    }
+
 public:
-    // Bind value as text representation
+    // Bind value in binary format if the server declared the parameter as one of
+    // bool/int2/int4/int8/float4/float8 and the value fits it, as text representation
+    // otherwise (e.g. numeric, text or unsigned value out of bigint range).
     template <typename T>
     typename std::enable_if<std::is_arithmetic<T>::value, bool>::type
     bind_arithmetic (int index, T value)
     {
-        // smallint         2 bytes integer	(-32768 to +32767)
-        // integer          4 bytes integer	(-2147483648 to +2147483647)
-        // bigint           8 bytes integer	(-9223372036854775808 to +9223372036854775807)
-        // decimal          variable user-specified precision, exact (up to 131072 digits before the decimal point; up to 16383 digits after the decimal point)
-        // numeric          variable user-specified precision, exact (up to 131072 digits before the decimal point; up to 16383 digits after the decimal point)
-        // real             4 bytes variable-precision, inexact	6 decimal digits precision
-        // double precision 8 bytes variable-precision, inexact	15 decimal digits precision
-        // smallserial      2 bytes small autoincrementing integer (1 to 32767)
-        // serial           4 bytes autoincrementing integer (1 to 2147483647)
-        // bigserial        8 bytes
-
         // Bind indexing started from 1
         --index;
         ensure_capacity(index);
-        _param_transient_values[index] = std::to_string(value);
-        _param_values[index] = nullptr; // nullptr -> expected transient value
-        _param_lengths[index] = _param_transient_values[index].size();
+
+        if (bind_binary(index, value))
+            return true;
+
+        auto & buf = _param_buffers[index];
+        buf.clear();
+        format_text(buf, value);
+
+        _param_storage[index] = param_storage::buffer;
+        _param_values[index] = nullptr;
+        _param_lengths[index] = static_cast<int>(buf.size());
         _param_formats[index] = 0; // text format
         return true;
     }
@@ -107,39 +424,76 @@ public:
         --index;
 
         ensure_capacity(index);
-        _param_values[index] = nullptr;
-        _param_lengths[index] = 0;
-        _param_formats[index] = 1; // binary format (no matter)
+        bind_external(index, nullptr, 0, 1); // binary format (no matter)
         return true;
     }
 
+    // Copies the string into the parameter buffer
     bool bind_string (int index, char const * ptr, std::size_t len)
     {
         // Bind indexing started from 1
         --index;
 
         ensure_capacity(index);
-        _param_transient_values[index] = std::string(ptr, len);
-        _param_values[index] = nullptr; // nullptr -> expected transient value
-        _param_lengths[index] = _param_transient_values[index].size();
-        _param_formats[index] = 0; // text format
+        bind_buffer(index, ptr, len, 0); // text format
+        return true;
+    }
+
+    // Binds the caller-owned string without copying
+    bool bind_string_static (int index, char const * ptr, std::size_t len)
+    {
+        // Bind indexing started from 1
+        --index;
+
+        ensure_capacity(index);
+        bind_external(index, ptr, len, 0); // text format
         return true;
     }
 
+    // Binds the caller-owned buffer without copying
     bool bind_blob (int index, char const * data, std::size_t const len)
     {
         // Bind indexing started from 1
         --index;
 
         ensure_capacity(index);
-        _param_transient_values[index] = std::move(std::string(data, len));
-        _param_values[index] = nullptr; // nullptr -> expected transient value
-        _param_lengths[index] = _param_transient_values[index].size();
-        _param_formats[index] = 1; // binary format
+        bind_external(index, data, len, 1); // binary format
+        return true;
+    }
+
+    // Binds values as array parameter: in binary format if the server declared the
+    // parameter as array of the supported type, as text array literal otherwise.
+    template <typename T>
+    bool bind_array (int index, std::vector<T> const & values)
+    {
+        // Bind indexing started from 1
+        --index;
+
+        ensure_capacity(index);
+
+        auto type = static_cast<psql::oid_enum>(param_type(index));
+        auto elem_type = psql::element_type(type);
+        auto & buf = _param_buffers[index];
+        buf.clear();
+
+        bool binary = elem_type != type && encode_array(buf, elem_type, values);
+
+        if (!binary) {
+            buf.clear();
+            format_array(buf, values);
+        }
+
+        _param_storage[index] = param_storage::buffer;
+        _param_values[index] = nullptr;
+        _param_lengths[index] = static_cast<int>(buf.size());
+        _param_formats[index] = binary ? 1 : 0;
         return true;
     }
 
     statement_t::result_type exec (error * perr);
+
+private:
+    void log_slow_query (PGresult * sth, std::chrono::microseconds elapsed);
 };
 
 DEBBY__NAMESPACE_END
@@ -1,13 +1,17 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2023-2024 Vladislav Trifochkin
+// Copyright (c) 2023-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2023.11.25 Initial version.
 //      2024.11.02 V2 started.
+//      2026.10.18 Added slow-query log helpers.
 ////////////////////////////////////////////////////////////////////////////////
+#pragma once
 #include "debby/namespace.hpp"
+#include "../slow_query_log.hpp"
+#include <cstdlib>
 #include <string>
 
 extern "C" {
@@ -39,6 +43,73 @@ inline std::string build_errstr (PGconn * dbh)
     return r;
 }
 
+/**
+ * Returns number of rows returned by query or affected by command, -1 if unknown.
+ */
+inline std::int64_t rows_touched (PGresult * res)
+{
+    if (PQresultStatus(res) == PGRES_TUPLES_OK)
+        return PQntuples(res);
+
+    char const * tuples = PQcmdTuples(res);
+
+    return (tuples != nullptr && *tuples != '\0') ? std::strtoll(tuples, nullptr, 10) : -1;
+}
+
+/**
+ * Captures query plan for @a sql executed with specified parameters.
+ * Read-only queries are explained with `EXPLAIN (ANALYZE, BUFFERS)` (i.e. executed once more),
+ * data modification ones with plain `EXPLAIN`, other statements are not explained.
+ */
+inline std::string explain (PGconn * dbh, std::string const & sql, int nparams
+    , char const * const * values, int const * lengths, int const * formats)
+{
+    bool analyze = slow_query_log::starts_with_keyword(sql, "select")
+        || slow_query_log::starts_with_keyword(sql, "values")
+        || slow_query_log::starts_with_keyword(sql, "table");
+
+    bool explainable = analyze
+        || slow_query_log::starts_with_keyword(sql, "insert")
+        || slow_query_log::starts_with_keyword(sql, "update")
+        || slow_query_log::starts_with_keyword(sql, "delete")
+        || slow_query_log::starts_with_keyword(sql, "with");
+
+    if (!explainable)
+        return std::string{};
+
+    // Failed statement aborts the current transaction, so isolate EXPLAIN by savepoint
+    bool in_transaction = PQtransactionStatus(dbh) == PQTRANS_INTRANS;
+
+    if (in_transaction)
+        PQclear(PQexec(dbh, "SAVEPOINT debby_explain"));
+
+    std::string explain_sql = std::string{analyze ? "EXPLAIN (ANALYZE, BUFFERS) " : "EXPLAIN "} + sql;
+    PGresult * res = PQexecParams(dbh, explain_sql.c_str(), nparams, nullptr, values, lengths, formats, 0);
+    bool success = res != nullptr && PQresultStatus(res) == PGRES_TUPLES_OK;
+    std::string plan;
+
+    if (success) {
+        for (int i = 0, n = PQntuples(res); i < n; i++) {
+            if (!plan.empty())
+                plan += '\n';
+
+            plan += PQgetvalue(res, i, 0);
+        }
+    }
+
+    if (res != nullptr)
+        PQclear(res);
+
+    if (in_transaction) {
+        if (!success)
+            PQclear(PQexec(dbh, "ROLLBACK TO SAVEPOINT debby_explain"));
+
+        PQclear(PQexec(dbh, "RELEASE SAVEPOINT debby_explain"));
+    }
+
+    return plan;
+}
+
 } // namespace psql
 
 DEBBY__NAMESPACE_END
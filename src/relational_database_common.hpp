@@ -1,12 +1,19 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.10.30 Initial version.
+//      2026.10.18 Added slow-query log.
+//                 Added nested transactions (savepoints) and transaction modes.
+//                 Added transaction restart on conflict.
 ////////////////////////////////////////////////////////////////////////////////
 #include "debby/relational_database.hpp"
+#include "slow_query_log.hpp"
+#include <pfs/fmt.hpp>
+#include <pfs/i18n.hpp>
+#include <utility>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -59,4 +66,171 @@ relational_database<Backend>::rows_count (std::string const & table_name, error
     return count;
 }
 
+template <backend_enum Backend>
+void relational_database<Backend>::begin (error * perr)
+{
+    begin(transaction_mode::standard, perr);
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::begin (transaction_mode mode, error * perr)
+{
+    auto & depth = _d->transaction_depth();
+
+    if (depth > 0) {
+        error err;
+        _d->query(fmt::format("SAVEPOINT debby_sp_{}", depth), & err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return;
+        }
+
+        ++depth;
+        return;
+    }
+
+    auto sql = impl::begin_sql(mode);
+
+    if (sql == nullptr) {
+        pfs::throw_or(perr, error {
+              make_error_code(errc::unsupported)
+            , tr::_("transaction mode is not supported by the backend")
+        });
+
+        return;
+    }
+
+    error err;
+    _d->query(sql, & err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    depth = 1;
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::commit (error * perr)
+{
+    auto & depth = _d->transaction_depth();
+    error err;
+
+    if (depth > 1) {
+        _d->query(fmt::format("RELEASE SAVEPOINT debby_sp_{}", depth - 1), & err);
+
+        if (!err)
+            --depth;
+    } else {
+        _d->query("COMMIT", & err);
+
+        // Transaction may stay active on failure (e.g. database is busy)
+        if (!_d->in_transaction())
+            depth = 0;
+    }
+
+    if (err)
+        pfs::throw_or(perr, std::move(err));
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::rollback (error * perr)
+{
+    auto & depth = _d->transaction_depth();
+    error err;
+
+    if (depth > 1) {
+        auto savepoint = fmt::format("debby_sp_{}", depth - 1);
+
+        // Savepoint stays on the stack after rolling back to it
+        _d->query("ROLLBACK TO SAVEPOINT " + savepoint, & err);
+
+        if (!err)
+            _d->query("RELEASE SAVEPOINT " + savepoint, & err);
+
+        if (!err)
+            --depth;
+    } else {
+        _d->query("ROLLBACK", & err);
+
+        if (!_d->in_transaction())
+            depth = 0;
+    }
+
+    if (err)
+        pfs::throw_or(perr, std::move(err));
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::rollback_to (int depth, error * perr)
+{
+    while (_d->transaction_depth() > depth) {
+        auto current = _d->transaction_depth();
+        error err;
+        rollback(& err);
+
+        if (err) {
+            pfs::throw_or(perr, std::move(err));
+            return;
+        }
+
+        // Nesting level is not changed (avoid infinite loop)
+        if (_d->transaction_depth() >= current)
+            return;
+    }
+}
+
+template <backend_enum Backend>
+bool relational_database<Backend>::restart_transaction (error const & err, int attempt)
+{
+    if (err.code() != make_error_code(errc::transaction_conflict))
+        return false;
+
+    if (attempt >= _d->max_transaction_retries())
+        return false;
+
+    // Rolls back nested transactions too
+    error rollback_err;
+    _d->query("ROLLBACK", & rollback_err);
+
+    if (rollback_err || _d->in_transaction())
+        return false;
+
+    _d->transaction_depth() = 0;
+    _d->on_transaction_restart();
+    return true;
+}
+
+template <backend_enum Backend>
+int relational_database<Backend>::transaction_depth () const noexcept
+{
+    return _d == nullptr ? 0 : _d->transaction_depth();
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::enable_slow_query_log (slow_query_options opts)
+{
+    _d->slow_log().enable(std::move(opts));
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::disable_slow_query_log ()
+{
+    _d->slow_log().disable();
+}
+
+template <backend_enum Backend>
+std::vector<slow_query_record> relational_database<Backend>::slow_queries () const
+{
+    return _d->slow_log().records();
+}
+
+template <backend_enum Backend>
+void relational_database<Backend>::clear_slow_queries ()
+{
+    _d->slow_log().clear();
+}
+
 DEBBY__NAMESPACE_END
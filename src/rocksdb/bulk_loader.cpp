@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "native_handle.hpp"
+#include "debby/rocksdb.hpp"
+#include <pfs/filesystem.hpp>
+#include <pfs/fmt.hpp>
+#include <pfs/i18n.hpp>
+#include <rocksdb/env.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/options.h>
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fs = pfs::filesystem;
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace rocksdb {
+
+namespace {
+
+using kv_pair = std::pair<std::string, std::string>;
+
+inline error make_bulk_load_error (std::string const & what, ::rocksdb::Status const & status)
+{
+    return error {
+          make_error_code(errc::backend_error)
+        , tr::f_("bulk load failure: {}: {}", what, status.ToString())
+    };
+}
+
+/**
+ * Sorts @a items by key keeping the value added last for duplicate keys.
+ */
+void sort_unique (std::vector<kv_pair> & items)
+{
+    std::stable_sort(items.begin(), items.end(), [] (kv_pair const & a, kv_pair const & b) {
+        return a.first < b.first;
+    });
+
+    auto out = items.begin();
+
+    for (auto pos = items.begin(); pos != items.end(); ) {
+        auto next = pos + 1;
+
+        while (next != items.end() && next->first == pos->first)
+            ++next;
+
+        if (out != next - 1)
+            *out = std::move(*(next - 1));
+
+        ++out;
+        pos = next;
+    }
+
+    items.erase(out, items.end());
+}
+
+/**
+ * Writes sorted @a items with unique keys into SST file @a path.
+ */
+error write_sst_file (::rocksdb::Options const & options, std::string const & path
+    , std::vector<kv_pair> const & items)
+{
+    ::rocksdb::SstFileWriter writer {::rocksdb::EnvOptions{}, options};
+    auto status = writer.Open(path);
+
+    for (auto pos = items.begin(); status.ok() && pos != items.end(); ++pos)
+        status = writer.Put(pos->first, pos->second);
+
+    if (status.ok())
+        status = writer.Finish();
+
+    return status.ok() ? error{} : make_bulk_load_error(path, status);
+}
+
+} // namespace
+
+class bulk_loader::impl
+{
+private:
+    native_handle _native;
+    ::rocksdb::Options _options;
+    bulk_load_options _opts;
+    unsigned int _threads {1};
+    fs::path _dir; // Temporary directory owned by the loader
+
+    std::vector<kv_pair> _chunk;
+    std::size_t _chunk_bytes {0};
+    std::string _last_key;
+    std::size_t _count {0};
+
+    std::deque<std::future<error>> _jobs;
+    std::vector<std::string> _files; // Chunk files in order of the input
+    std::size_t _file_index {0};
+
+    error _err; // First failure, the loader does not accept input after it
+    bool _finished {false};
+
+public:
+    impl (native_handle && native, bulk_load_options const & opts, error * perr)
+        : _native(std::move(native))
+        , _opts(opts)
+    {
+        if (_native.dbh == nullptr || _native.cf == nullptr) {
+            _err = error {make_error_code(errc::database_not_found)};
+            pfs::throw_or(perr, error{_err});
+            return;
+        }
+
+        _options = _native.dbh->GetOptions(_native.cf);
+        _threads = _opts.threads > 0 ? _opts.threads : (std::max)(std::thread::hardware_concurrency(), 1U);
+
+        static std::atomic<unsigned int> loader_counter {0};
+
+        auto dir_name = fmt::format("bulk-load-{:x}-{}"
+            , std::chrono::system_clock::now().time_since_epoch().count(), loader_counter++);
+
+        _dir = (_opts.work_dir.empty() ? _native.path : _opts.work_dir) / pfs::utf8_decode_path(dir_name);
+
+        std::error_code ec;
+        fs::create_directories(_dir, ec);
+
+        if (ec) {
+            _err = error {ec, tr::f_("create bulk load directory: {}", pfs::utf8_encode_path(_dir))};
+            _dir.clear();
+            pfs::throw_or(perr, error{_err});
+        }
+    }
+
+    ~impl ()
+    {
+        wait_jobs(0);
+
+        if (!_dir.empty()) {
+            std::error_code ec;
+            fs::remove_all(_dir, ec);
+        }
+    }
+
+public:
+    std::size_t count () const noexcept
+    {
+        return _count;
+    }
+
+    bool add (std::string const & key, char const * data, std::size_t len, error * perr)
+    {
+        if (_err || _finished) {
+            report(perr);
+            return false;
+        }
+
+        if (_opts.sorted) {
+            if (_count > 0 && key <= _last_key) {
+                _err = error {make_error_code(errc::bad_value)
+                    , tr::f_("bulk load input is not sorted by key: {}", key)};
+                report(perr);
+                return false;
+            }
+
+            _last_key = key;
+        }
+
+        _chunk.emplace_back(key, std::string(data, len));
+        _chunk_bytes += key.size() + len;
+        _count++;
+
+        if (_chunk_bytes >= _opts.chunk_size) {
+            flush_chunk();
+
+            if (_err) {
+                report(perr);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool finish (error * perr)
+    {
+        if (_err || _finished) {
+            report(perr);
+            return false;
+        }
+
+        flush_chunk();
+        wait_jobs(0);
+
+        std::vector<std::string> files;
+
+        // Sorted chunks and the single unsorted run do not overlap
+        if (!_err) {
+            if (_opts.sorted || _files.size() <= 1)
+                files = std::move(_files);
+            else
+                merge_runs(files);
+        }
+
+        if (!_err && !files.empty()) {
+            ::rocksdb::IngestExternalFileOptions o;
+            o.move_files = true;
+
+            auto status = _native.dbh->IngestExternalFile(_native.cf, files, o);
+
+            if (!status.ok())
+                _err = make_bulk_load_error(pfs::utf8_encode_path(_native.path), status);
+        }
+
+        _finished = true;
+        _files.clear();
+
+        std::error_code ec;
+        fs::remove_all(_dir, ec);
+        _dir.clear();
+
+        if (_err) {
+            report(perr);
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    void report (error * perr) const
+    {
+        pfs::throw_or(perr, _err ? error{_err}
+            : error {make_error_code(errc::unsupported), tr::_("bulk load is finished")});
+    }
+
+    std::string next_file_path (char const * prefix)
+    {
+        return pfs::utf8_encode_path(_dir / pfs::utf8_decode_path(fmt::format("{}-{:06}.sst", prefix, _file_index++)));
+    }
+
+    /**
+     * Waits until number of pending jobs is not greater than @a max_pending.
+     */
+    void wait_jobs (std::size_t max_pending)
+    {
+        while (_jobs.size() > max_pending) {
+            auto err = _jobs.front().get();
+            _jobs.pop_front();
+
+            if (err && !_err)
+                _err = std::move(err);
+        }
+    }
+
+    /**
+     * Passes the chunk to the worker thread (sorting it if the input is unsorted).
+     */
+    void flush_chunk ()
+    {
+        if (_chunk.empty())
+            return;
+
+        // Bounds memory used by chunks
+        wait_jobs(_threads - 1);
+
+        auto path = next_file_path(_opts.sorted ? "part" : "run");
+        auto sorted = _opts.sorted;
+        auto const & options = _options;
+
+        _files.push_back(path);
+        _jobs.push_back(std::async(std::launch::async
+            , [& options, path, sorted, items = std::move(_chunk)] () mutable {
+                if (!sorted)
+                    sort_unique(items);
+
+                return write_sst_file(options, path, items);
+            }));
+
+        _chunk = std::vector<kv_pair>{};
+        _chunk_bytes = 0;
+    }
+
+    /**
+     * Merges sorted runs into non-overlapping files limited by
+     * `bulk_load_options::target_file_size` (the latest run wins for duplicate keys).
+     */
+    void merge_runs (std::vector<std::string> & files)
+    {
+        struct cursor
+        {
+            std::unique_ptr<::rocksdb::SstFileReader> reader;
+            std::unique_ptr<::rocksdb::Iterator> it; // Destroyed before the reader
+        };
+
+        std::vector<cursor> cursors(_files.size());
+        ::rocksdb::ReadOptions read_opts;
+        read_opts.fill_cache = false;
+
+        for (std::size_t i = 0; i < _files.size(); i++) {
+            auto & c = cursors[i];
+            c.reader.reset(new ::rocksdb::SstFileReader(_options));
+            auto status = c.reader->Open(_files[i]);
+
+            if (!status.ok()) {
+                _err = make_bulk_load_error(_files[i], status);
+                return;
+            }
+
+            c.it.reset(c.reader->NewIterator(read_opts));
+            c.it->SeekToFirst();
+        }
+
+        // Top is the least key, the latest run for equal keys
+        auto lower_priority = [& cursors] (std::size_t a, std::size_t b) {
+            auto r = cursors[a].it->key().compare(cursors[b].it->key());
+            return r > 0 || (r == 0 && a < b);
+        };
+
+        std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(lower_priority)> heap {lower_priority};
+
+        for (std::size_t i = 0; i < cursors.size(); i++) {
+            if (cursors[i].it->Valid())
+                heap.push(i);
+        }
+
+        std::unique_ptr<::rocksdb::SstFileWriter> writer;
+        std::string last_key;
+        ::rocksdb::Status status;
+
+        while (status.ok() && !heap.empty()) {
+            auto i = heap.top();
+            heap.pop();
+
+            auto & it = *cursors[i].it;
+
+            // Older values of the key just written are skipped
+            if (files.empty() || it.key().compare(last_key) != 0) {
+                if (writer == nullptr) {
+                    files.push_back(next_file_path("part"));
+                    writer.reset(new ::rocksdb::SstFileWriter(::rocksdb::EnvOptions{}, _options));
+                    status = writer->Open(files.back());
+                }
+
+                if (status.ok())
+                    status = writer->Put(it.key(), it.value());
+
+                last_key.assign(it.key().data(), it.key().size());
+
+                // Files are switched at key boundary, so they do not overlap
+                if (status.ok() && writer->FileSize() >= _opts.target_file_size) {
+                    status = writer->Finish();
+                    writer.reset();
+                }
+            }
+
+            it.Next();
+
+            if (it.Valid())
+                heap.push(i);
+            else if (status.ok())
+                status = it.status();
+        }
+
+        if (status.ok() && writer != nullptr)
+            status = writer->Finish();
+
+        if (!status.ok()) {
+            _err = make_bulk_load_error(files.empty() ? std::string{} : files.back(), status);
+            return;
+        }
+
+        // Runs are not needed anymore
+        for (auto const & path: _files) {
+            std::error_code ec;
+            fs::remove(pfs::utf8_decode_path(path), ec);
+        }
+    }
+};
+
+bulk_loader::bulk_loader (keyvalue_database<backend_enum::rocksdb> & db, bulk_load_options const & opts
+    , error * perr)
+    : _d(new impl(native_handle_of(db), opts, perr))
+{}
+
+bulk_loader::bulk_loader (bulk_loader && other) noexcept = default;
+bulk_loader & bulk_loader::operator = (bulk_loader && other) noexcept = default;
+bulk_loader::~bulk_loader () = default;
+
+bool bulk_loader::add (std::string const & key, char const * data, std::size_t len, error * perr)
+{
+    return _d->add(key, data, len, perr);
+}
+
+bool bulk_loader::finish (error * perr)
+{
+    return _d->finish(perr);
+}
+
+std::size_t bulk_loader::count () const noexcept
+{
+    return _d == nullptr ? 0 : _d->count();
+}
+
+} // namespace rocksdb
+
+DEBBY__NAMESPACE_END
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -10,17 +10,40 @@
 //      2023.02.08 Applied new API.
 //      2024.11.10 V2 started.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 Added `remove_many()`.
+//                 Added instrumentation.
+//                 Added `for_each_key()`.
+//                 Read values through `PinnableSlice`.
+//                 Added `get()`, `multi_get()` and `for_each_key()` with read options.
+//                 Added `increment()` and `append()` based on merge operator.
+//                 Added `native_handle_of()`.
+//                 Added statistics option.
+//                 Merge operator never fails, `increment()` checks stored value.
+//                 Added `write_batch()`.
+//                 `increment()` is blind merge again, added `checked_increment()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
+#include "../instrumentation.hpp"
+#include "native_handle.hpp"
 #include "debby/keyvalue_database.hpp"
 #include "debby/rocksdb.hpp"
 #include <pfs/filesystem.hpp>
 #include <pfs/i18n.hpp>
 #include <rocksdb/rocksdb_namespace.h>
 #include <rocksdb/db.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/options.h>
+#include <rocksdb/statistics.h>
+#include <rocksdb/write_batch.h>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace fs = pfs::filesystem;
 
@@ -62,8 +85,11 @@ using keyvalue_database_t = keyvalue_database<backend_enum::rocksdb>;
 
 template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, bool>
-assign (T & result, std::string && val)
+assign (T & result, ::rocksdb::Slice const & val)
 {
+    if (val.size() > sizeof(T))
+        return false;
+
     fixed_packer<T> p;
     std::memset(p.bytes, 0, sizeof(p.bytes));
     std::memcpy(p.bytes, val.data(), val.size());
@@ -77,28 +103,184 @@ assign (T & result, std::string && val)
 
 template <typename T>
 inline std::enable_if_t<std::is_same<std::decay_t<T>, std::string>::value, bool>
-assign (std::string & result, std::string && data)
+assign (std::string & result, ::rocksdb::Slice const & data)
 {
-    result = std::move(data);
+    result.assign(data.data(), data.size());
     return true;
 }
 
+inline ::rocksdb::ReadOptions make_read_options (rocksdb::read_options const & opts)
+{
+    ::rocksdb::ReadOptions o;
+    o.fill_cache = opts.fill_cache;
+    o.verify_checksums = opts.verify_checksums;
+    o.readahead_size = opts.readahead_size;
+    return o;
+}
+
+/**
+ * Associative merge operator applying `increment()` and `append()` operands.
+ *
+ * @details Operand is tagged with the operation: `INCREMENT_TAG` followed by packed
+ *          `std::int64_t` delta or `APPEND_TAG` followed by bytes to append. Operands
+ *          of the same operation are combined by partial merge (deltas are summed,
+ *          appended bytes are concatenated). Full merge never fails (failure is reported
+ *          as corruption and stops writes if it happens during compaction): value which
+ *          is not a packed counter is treated as zero counter, malformed operands are
+ *          skipped.
+ */
+class merge_operator: public ::rocksdb::MergeOperator
+{
+public:
+    static constexpr char INCREMENT_TAG = 'i';
+    static constexpr char APPEND_TAG = 'a';
+
+public:
+    static std::string increment_operand (std::int64_t delta)
+    {
+        fixed_packer<std::int64_t> p;
+        p.value = delta;
+
+        std::string result(1, INCREMENT_TAG);
+        result.append(p.bytes, sizeof(std::int64_t));
+        return result;
+    }
+
+    static std::string append_operand (char const * data, std::size_t len)
+    {
+        std::string result(1, APPEND_TAG);
+        result.append(data, len);
+        return result;
+    }
+
+public:
+    bool FullMergeV2 (MergeOperationInput const & merge_in, MergeOperationOutput * merge_out) const override
+    {
+        auto & value = merge_out->new_value;
+
+        if (merge_in.existing_value != nullptr)
+            value.assign(merge_in.existing_value->data(), merge_in.existing_value->size());
+        else
+            value.clear();
+
+        for (auto const & operand: merge_in.operand_list)
+            apply(value, operand);
+
+        return true;
+    }
+
+    bool PartialMerge (::rocksdb::Slice const & /*key*/, ::rocksdb::Slice const & left_operand
+        , ::rocksdb::Slice const & right_operand, std::string * new_value
+        , ::rocksdb::Logger * /*logger*/) const override
+    {
+        if (left_operand.size() == 0 || right_operand.size() == 0
+                || left_operand.data()[0] != right_operand.data()[0]) {
+            return false;
+        }
+
+        switch (left_operand.data()[0]) {
+            case INCREMENT_TAG: {
+                std::int64_t left = 0;
+                std::int64_t right = 0;
+
+                if (!delta_of(left_operand, left) || !delta_of(right_operand, right))
+                    return false;
+
+                *new_value = increment_operand(wrapping_add(left, right));
+                return true;
+            }
+
+            case APPEND_TAG:
+                new_value->assign(left_operand.data(), left_operand.size());
+                new_value->append(right_operand.data() + 1, right_operand.size() - 1);
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    char const * Name () const override
+    {
+        return "debby.merge_operator";
+    }
+
+private:
+    static bool delta_of (::rocksdb::Slice const & operand, std::int64_t & delta)
+    {
+        if (operand.size() != 1 + sizeof(std::int64_t))
+            return false;
+
+        std::memcpy(& delta, operand.data() + 1, sizeof(std::int64_t));
+        return true;
+    }
+
+    static void apply (std::string & value, ::rocksdb::Slice const & operand)
+    {
+        if (operand.size() == 0)
+            return;
+
+        switch (operand.data()[0]) {
+            case INCREMENT_TAG: {
+                std::int64_t delta = 0;
+
+                if (!delta_of(operand, delta))
+                    return;
+
+                if (!increment_packed(value, delta)) {
+                    value.clear();
+                    increment_packed(value, delta);
+                }
+
+                return;
+            }
+
+            case APPEND_TAG:
+                value.append(operand.data() + 1, operand.size() - 1);
+                return;
+
+            default:
+                return;
+        }
+    }
+};
+
+constexpr char merge_operator::INCREMENT_TAG;
+constexpr char merge_operator::APPEND_TAG;
+
+/**
+ * Options of the debby column family (merge operator is registered each time the
+ * column family is opened or created).
+ */
+inline ::rocksdb::ColumnFamilyOptions make_column_family_options ()
+{
+    ::rocksdb::ColumnFamilyOptions o;
+    o.merge_operator = std::make_shared<merge_operator>();
+    return o;
+}
+
 template <>
 class keyvalue_database_t::impl
 {
     static constexpr char const * CFNAME = "debby";
 
+    // Number of keys looked up by single `MultiGet` call (limits number of pinned
+    // blocks)
+    static constexpr std::size_t MULTI_GET_BATCH_SIZE = 256;
+
 private:
     ::rocksdb::DB * _dbh {nullptr};
     std::vector<::rocksdb::ColumnFamilyHandle *> _handles;
     fs::path _path;
+    ::rocksdb::WriteBatch * _batch {nullptr}; // Writes collected by `write_batch()`
+    std::atomic<std::thread::id> _batch_owner {std::thread::id{}}; // Thread owning `_batch`
 
 private:
     static ::rocksdb::ColumnFamilyHandle * create_column_family (::rocksdb::DB * dbh
         , fs::path const & path, error * perr)
     {
         ::rocksdb::ColumnFamilyHandle * cf = nullptr;
-        auto status = dbh->CreateColumnFamily(::rocksdb::ColumnFamilyOptions(), CFNAME, & cf);
+        auto status = dbh->CreateColumnFamily(make_column_family_options(), CFNAME, & cf);
 
         if (!status.ok()) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -109,6 +291,17 @@ private:
         return cf;
     }
 
+    bool in_batch () const noexcept
+    {
+        return _batch_owner.load() == std::this_thread::get_id();
+    }
+
+    void end_batch () noexcept
+    {
+        _batch_owner = std::thread::id{};
+        _batch = nullptr;
+    }
+
 public:
     impl () = default;
 
@@ -136,6 +329,10 @@ public:
         if (opts.small_db)
             o.OptimizeForSmallDb();
 
+        // Tickers and histograms, see `rocksdb::statistics()`
+        if (opts.statistics)
+            o.statistics = ::rocksdb::CreateDBStatistics();
+
         // If true, the database will be created if it is missing.
         // Default: false
         o.create_if_missing = create_if_missing;
@@ -178,7 +375,7 @@ public:
         std::vector<::rocksdb::ColumnFamilyHandle *> handles;
         std::vector<::rocksdb::ColumnFamilyDescriptor> column_families;
         column_families.emplace_back(::rocksdb::kDefaultColumnFamilyName, ::rocksdb::ColumnFamilyOptions());
-        column_families.emplace_back(CFNAME, ::rocksdb::ColumnFamilyOptions());
+        column_families.emplace_back(CFNAME, make_column_family_options());
         auto status = ::rocksdb::DB::Open(o, pfs::utf8_encode_path(path), column_families, & handles, & dbh);
 
         if (!status.ok()) {
@@ -229,6 +426,51 @@ public:
     }
 
 public:
+    rocksdb::native_handle native () const
+    {
+        rocksdb::native_handle result;
+        result.dbh = _dbh;
+        result.cf = _handles.size() > 1 ? _handles[1] : nullptr;
+        result.path = _path;
+        return result;
+    }
+
+    /**
+     * Collects writes made by @a f into single `WriteBatch` (nested batch is a part of
+     * the outer one).
+     */
+    void write_batch (std::function<void ()> const & f, error * perr)
+    {
+        PFS__TERMINATE(_dbh != nullptr, "");
+
+        if (in_batch()) {
+            f();
+            return;
+        }
+
+        ::rocksdb::WriteBatch batch;
+        _batch = & batch;
+        _batch_owner = std::this_thread::get_id();
+
+        try {
+            f();
+        } catch (...) {
+            end_batch();
+            throw;
+        }
+
+        end_batch();
+
+        ::rocksdb::WriteOptions write_opts;
+        write_opts.sync = true;
+        auto status = _dbh->Write(write_opts, & batch);
+
+        if (!status.ok()) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("write batch failure: {}", status.ToString()));
+        }
+    }
+
    void clear (error * perr = nullptr)
    {
         if (_dbh == nullptr)
@@ -273,7 +515,9 @@ public:
         // Note: consider setting options.sync = true.
         ::rocksdb::WriteOptions write_opts;
         write_opts.sync = true;
-        ::rocksdb::Status status = _dbh->Delete(write_opts, _handles[1], key);
+        ::rocksdb::Status status = in_batch()
+            ? _batch->Delete(_handles[1], key)
+            : _dbh->Delete(write_opts, _handles[1], key);
 
         if (!status.ok()) {
             if (!status.IsNotFound()) {
@@ -285,6 +529,40 @@ public:
         }
     }
 
+    /**
+    * Removes values for @a keys with single atomic write. Missing keys are ignored.
+    */
+    void remove_many (std::vector<keyvalue_database_t::key_type> const & keys, error * perr)
+    {
+        if (_dbh == nullptr)
+            return;
+
+        if (_handles[1] == nullptr)
+            return;
+
+        ::rocksdb::WriteBatch own_batch;
+        auto & batch = in_batch() ? *_batch : own_batch;
+        ::rocksdb::Status status;
+
+        for (auto const & key: keys) {
+            status = batch.Delete(_handles[1], key);
+
+            if (!status.ok())
+                break;
+        }
+
+        if (status.ok() && & batch == & own_batch) {
+            ::rocksdb::WriteOptions write_opts;
+            write_opts.sync = true;
+            status = _dbh->Write(write_opts, & batch);
+        }
+
+        if (!status.ok()) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("remove failure: {}", status.ToString()));
+        }
+    }
+
     /**
     * Writes @c data into database by @a key.
     *
@@ -314,7 +592,9 @@ public:
             return true;
         }
 
-        auto status = _dbh->Put(::rocksdb::WriteOptions(), _handles[1], key, ::rocksdb::Slice(data, size));
+        auto status = in_batch()
+            ? _batch->Put(_handles[1], key, ::rocksdb::Slice(data, size))
+            : _dbh->Put(::rocksdb::WriteOptions(), _handles[1], key, ::rocksdb::Slice(data, size));
 
         if (!status.ok()) {
             pfs::throw_or(perr, make_error_code(errc::backend_error)
@@ -325,19 +605,94 @@ public:
         return true;
     }
 
+    /**
+     * Checks the value associated with @a key is a packed counter (or missing).
+     */
+    bool check_counter (keyvalue_database_t::key_type const & key, error * perr) const
+    {
+        PFS__TERMINATE(_dbh != nullptr, "");
+        PFS__TERMINATE(_handles[1] != nullptr, "");
+
+        ::rocksdb::PinnableSlice buf;
+        auto status = _dbh->Get(::rocksdb::ReadOptions(), _handles[1], key, & buf);
+
+        if (status.IsNotFound())
+            return true;
+
+        if (!status.ok()) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("read failure for key: {}: {}", key, status.ToString()));
+            return false;
+        }
+
+        if (buf.size() != 0 && buf.size() != sizeof(std::int64_t)) {
+            pfs::throw_or(perr, make_unsuitable_update_error(key));
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Writes merge @a operand (see `merge_operator`) for @a key without reading the
+     * stored value.
+     */
+    bool merge (keyvalue_database_t::key_type const & key, std::string const & operand, error * perr)
+    {
+        PFS__TERMINATE(_dbh != nullptr, "");
+        PFS__TERMINATE(_handles[1] != nullptr, "");
+
+        auto status = in_batch()
+            ? _batch->Merge(_handles[1], key, operand)
+            : _dbh->Merge(::rocksdb::WriteOptions(), _handles[1], key, operand);
+
+        if (!status.ok()) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("merge failure for key: {}: {}", key, status.ToString()));
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Visits keys starting with @a prefix in key order.
+     */
+    void for_each_key (keyvalue_database_t::key_type const & prefix
+        , std::function<bool (keyvalue_database_t::key_type const &)> const & f
+        , ::rocksdb::ReadOptions const & read_opts, error * perr) const
+    {
+        PFS__TERMINATE(_dbh != nullptr, "");
+
+        std::unique_ptr<::rocksdb::Iterator> it {_dbh->NewIterator(read_opts, _handles[1])};
+
+        for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+            if (!f(it->key().ToString()))
+                break;
+        }
+
+        auto status = it->status();
+
+        if (!status.ok()) {
+            pfs::throw_or(perr, make_error_code(errc::backend_error)
+                , tr::f_("keys iteration failure: {}", status.ToString()));
+        }
+    }
+
     template <typename T>
-    T get (std::string const & key, error * perr) const
+    T get (std::string const & key, ::rocksdb::ReadOptions const & read_opts, error * perr) const
     {
         PFS__TERMINATE(_dbh != nullptr, "");
         PFS__TERMINATE(_handles[1] != nullptr, "");
 
         T result;
 
-        std::string buf;
-        ::rocksdb::Status status = _dbh->Get(::rocksdb::ReadOptions(), _handles[1], key, & buf);
+        // Value is pinned in the block cache (or memtable) instead of being copied
+        ::rocksdb::PinnableSlice buf;
+        ::rocksdb::Status status = _dbh->Get(read_opts, _handles[1], key, & buf);
 
         if (status.ok()) {
-            if (!assign<T>(result, std::move(buf))) {
+            if (!assign<T>(result, buf)) {
                 pfs::throw_or(perr, make_unsuitable_error(key));
                 return T{};
             }
@@ -355,9 +710,59 @@ public:
 
         return result;
     }
+
+    template <typename T>
+    std::vector<T> multi_get (std::vector<std::string> const & keys, T const & default_value
+        , ::rocksdb::ReadOptions const & read_opts, error * perr) const
+    {
+        PFS__TERMINATE(_dbh != nullptr, "");
+        PFS__TERMINATE(_handles[1] != nullptr, "");
+
+        std::vector<T> result(keys.size(), default_value);
+        auto batch_size = keys.size() < MULTI_GET_BATCH_SIZE ? keys.size() : MULTI_GET_BATCH_SIZE;
+
+        std::vector<::rocksdb::Slice> slices(batch_size);
+        std::vector<::rocksdb::Status> statuses(batch_size);
+        std::unique_ptr<::rocksdb::PinnableSlice[]> values {new ::rocksdb::PinnableSlice[batch_size]};
+
+        for (std::size_t offset = 0; offset < keys.size(); offset += batch_size) {
+            auto n = keys.size() - offset < batch_size ? keys.size() - offset : batch_size;
+
+            for (std::size_t i = 0; i < n; i++)
+                slices[i] = ::rocksdb::Slice(keys[offset + i]);
+
+            _dbh->MultiGet(read_opts, _handles[1], n, slices.data(), values.get(), statuses.data());
+
+            for (std::size_t i = 0; i < n; i++) {
+                auto const & key = keys[offset + i];
+                auto const & status = statuses[i];
+
+                if (status.ok()) {
+                    T value;
+
+                    if (!assign<T>(value, values[i])) {
+                        pfs::throw_or(perr, make_unsuitable_error(key));
+                        return std::vector<T>{};
+                    }
+
+                    result[offset + i] = std::move(value);
+                } else if (!status.IsNotFound()) {
+                    pfs::throw_or(perr, make_error_code(errc::backend_error)
+                        , tr::f_("read failure for key: {}: {}", key, status.ToString()));
+                    return std::vector<T>{};
+                }
+
+                // Release pinned block
+                values[i].Reset();
+            }
+        }
+
+        return result;
+    }
 };
 
 constexpr char const * keyvalue_database<backend_enum::rocksdb>::impl::CFNAME;
+constexpr std::size_t keyvalue_database<backend_enum::rocksdb>::impl::MULTI_GET_BATCH_SIZE;
 
 template keyvalue_database<backend_enum::rocksdb>::keyvalue_database (impl && d);
 template keyvalue_database<backend_enum::rocksdb>::keyvalue_database (keyvalue_database && other) noexcept;
@@ -373,13 +778,50 @@ void keyvalue_database_t::clear (error * perr)
 template <>
 void keyvalue_database_t::remove (key_type const & key, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_remove, 0, 0);
     _d->remove(key, perr);
 }
 
+template <>
+void keyvalue_database_t::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    _d->remove_many(keys, perr);
+}
+
+template <>
+void keyvalue_database_t::write_batch (std::function<void ()> const & f, error * perr)
+{
+    _d->write_batch(f, perr);
+}
+
+template <>
+void keyvalue_database_t::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const
+{
+    _d->for_each_key(prefix, f, ::rocksdb::ReadOptions(), perr);
+}
+
+template <>
+void keyvalue_database_t::increment (key_type const & key, std::int64_t delta, error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_set, 0, sizeof(delta));
+
+    _d->merge(key, merge_operator::increment_operand(delta), perr);
+}
+
+template <>
+void keyvalue_database_t::append (key_type const & key, char const * data, std::size_t len
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_set, 0, len);
+    _d->merge(key, merge_operator::append_operand(data, len), perr);
+}
+
 template <>
 void keyvalue_database_t::set (key_type const & key, char const * value, std::size_t len
     , error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_set, 0, len);
     _d->put(key, value, len, perr);
 }
 
@@ -388,6 +830,7 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value, void>
 keyvalue_database_t::set (key_type const & key, T value, error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_set, 0, sizeof(T));
     char buf[sizeof(fixed_packer<T>)];
     auto p = new (buf) fixed_packer<T>{};
     p->value = value;
@@ -399,7 +842,10 @@ template <typename T>
 std::enable_if_t<std::is_arithmetic<T>::value || std::is_same<std::decay_t<T>, std::string>::value, std::decay_t<T>>
 keyvalue_database_t::get (key_type const & key, error * perr) const
 {
-    return _d->template get<std::decay_t<T>>(key, perr);
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_get, 0, 0);
+    auto result = _d->template get<std::decay_t<T>>(key, ::rocksdb::ReadOptions(), perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
 }
 
 namespace rocksdb {
@@ -437,13 +883,84 @@ bool wipe (fs::path const & path, error * perr)
     return true;
 }
 
+native_handle native_handle_of (keyvalue_database_t const & db)
+{
+    auto d = db.backend_impl();
+    return d == nullptr ? native_handle{} : d->native();
+}
+
+template <typename T>
+T get (keyvalue_database_t const & db, std::string const & key, read_options const & opts, error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_get, 0, 0);
+
+    auto d = db.backend_impl();
+
+    if (d == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return T{};
+    }
+
+    auto result = d->template get<T>(key, make_read_options(opts), perr);
+    DEBBY__INSTRUMENT_BYTES(instrumentation::bytes_of(result));
+    return result;
+}
+
+template <typename T>
+std::vector<T> multi_get (keyvalue_database_t const & db, std::vector<std::string> const & keys
+    , T const & default_value, read_options const & opts, error * perr)
+{
+    auto d = db.backend_impl();
+
+    if (d == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return std::vector<T>{};
+    }
+
+    return d->template multi_get<T>(keys, default_value, make_read_options(opts), perr);
+}
+
+void for_each_key (keyvalue_database_t const & db, std::string const & prefix
+    , std::function<bool (std::string const &)> const & f, read_options const & opts, error * perr)
+{
+    auto d = db.backend_impl();
+
+    if (d == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return;
+    }
+
+    d->for_each_key(prefix, f, make_read_options(opts), perr);
+}
+
+void checked_increment (keyvalue_database_t & db, std::string const & key, std::int64_t delta
+    , error * perr)
+{
+    DEBBY__INSTRUMENT(backend_enum::rocksdb, kv_set, 0, sizeof(delta));
+
+    auto d = db.backend_impl();
+
+    if (d == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return;
+    }
+
+    if (d->check_counter(key, perr))
+        d->merge(key, merge_operator::increment_operand(delta), perr);
+}
+
 } // namespace rocksdb
 
 #define DEBBY__ROCKSDB_SET(t) \
     template void keyvalue_database_t::set<t> (key_type const & key, t value, error * perr);
 
 #define DEBBY__ROCKSDB_GET(t) \
-    template t keyvalue_database_t::get<t> (key_type const & key, error * perr) const;
+    template t keyvalue_database_t::get<t> (key_type const & key, error * perr) const; \
+    template t rocksdb::get<t> (keyvalue_database_t const & db, std::string const & key \
+        , rocksdb::read_options const & opts, error * perr); \
+    template std::vector<t> rocksdb::multi_get<t> (keyvalue_database_t const & db \
+        , std::vector<std::string> const & keys, t const & default_value \
+        , rocksdb::read_options const & opts, error * perr);
 
 DEBBY__ROCKSDB_SET(bool)
 DEBBY__ROCKSDB_SET(char)
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/namespace.hpp"
+#include "debby/rocksdb.hpp"
+#include <pfs/filesystem.hpp>
+#include <rocksdb/rocksdb_namespace.h>
+#include <rocksdb/db.h>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace rocksdb {
+
+/**
+ * Native handles of the open database used by the tools implemented outside
+ * the key-value database.
+ */
+struct native_handle
+{
+    ::rocksdb::DB * dbh {nullptr};
+    ::rocksdb::ColumnFamilyHandle * cf {nullptr}; // debby column family
+    pfs::filesystem::path path;
+};
+
+/**
+ * Returns native handles of @a db (null handles if the database is not open).
+ */
+native_handle native_handle_of (keyvalue_database<backend_enum::rocksdb> const & db);
+
+} // namespace rocksdb
+
+DEBBY__NAMESPACE_END
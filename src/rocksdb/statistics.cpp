@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "native_handle.hpp"
+#include "debby/rocksdb.hpp"
+#include <pfs/i18n.hpp>
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+#include <rocksdb/statistics.h>
+#include <memory>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace rocksdb {
+
+namespace {
+
+inline bool check_open (native_handle const & h, error * perr)
+{
+    if (h.dbh == nullptr || h.cf == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::database_not_found)});
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<::rocksdb::Statistics> statistics_of (native_handle const & h, error * perr)
+{
+    if (!check_open(h, perr))
+        return nullptr;
+
+    auto stats = h.dbh->GetDBOptions().statistics;
+
+    if (stats == nullptr) {
+        pfs::throw_or(perr, error {make_error_code(errc::unsupported)
+            , tr::_("RocksDB statistics is not enabled")});
+    }
+
+    return stats;
+}
+
+} // namespace
+
+db_statistics statistics (keyvalue_database<backend_enum::rocksdb> const & db, error * perr)
+{
+    db_statistics result;
+    auto stats = statistics_of(native_handle_of(db), perr);
+
+    if (stats == nullptr)
+        return result;
+
+    result.block_cache_hit = stats->getTickerCount(::rocksdb::BLOCK_CACHE_HIT);
+    result.block_cache_miss = stats->getTickerCount(::rocksdb::BLOCK_CACHE_MISS);
+    result.bloom_filter_useful = stats->getTickerCount(::rocksdb::BLOOM_FILTER_USEFUL);
+    result.stall_micros = stats->getTickerCount(::rocksdb::STALL_MICROS);
+    result.compact_read_bytes = stats->getTickerCount(::rocksdb::COMPACT_READ_BYTES);
+    result.compact_write_bytes = stats->getTickerCount(::rocksdb::COMPACT_WRITE_BYTES);
+
+    for (auto const & t: ::rocksdb::TickersNameMap)
+        result.tickers[t.second] = stats->getTickerCount(t.first);
+
+    for (auto const & h: ::rocksdb::HistogramsNameMap) {
+        ::rocksdb::HistogramData data;
+        stats->histogramData(h.first, & data);
+
+        histogram_stats hs;
+        hs.count = data.count;
+        hs.sum = data.sum;
+        hs.average = data.average;
+        hs.median = data.median;
+        hs.p95 = data.percentile95;
+        hs.p99 = data.percentile99;
+        hs.max = data.max;
+
+        result.histograms[h.second] = hs;
+    }
+
+    return result;
+}
+
+void reset_statistics (keyvalue_database<backend_enum::rocksdb> & db, error * perr)
+{
+    auto stats = statistics_of(native_handle_of(db), perr);
+
+    if (stats == nullptr)
+        return;
+
+    auto status = stats->Reset();
+
+    if (!status.ok()) {
+        pfs::throw_or(perr, make_error_code(errc::backend_error)
+            , tr::f_("reset statistics failure: {}", status.ToString()));
+    }
+}
+
+std::string property (keyvalue_database<backend_enum::rocksdb> const & db, std::string const & name
+    , error * perr)
+{
+    auto h = native_handle_of(db);
+
+    if (!check_open(h, perr))
+        return std::string{};
+
+    std::string value;
+
+    if (!h.dbh->GetProperty(h.cf, name, & value)) {
+        pfs::throw_or(perr, make_error_code(errc::key_not_found)
+            , tr::f_("unknown RocksDB property: {}", name));
+        return std::string{};
+    }
+
+    return value;
+}
+
+std::uint64_t int_property (keyvalue_database<backend_enum::rocksdb> const & db, std::string const & name
+    , error * perr)
+{
+    auto h = native_handle_of(db);
+
+    if (!check_open(h, perr))
+        return 0;
+
+    std::uint64_t value = 0;
+
+    if (!h.dbh->GetIntProperty(h.cf, name, & value)) {
+        pfs::throw_or(perr, make_error_code(errc::key_not_found)
+            , tr::f_("unknown RocksDB integer property: {}", name));
+        return 0;
+    }
+
+    return value;
+}
+
+perf_scope::perf_scope (perf_level level)
+    : _saved_level(static_cast<int>(::rocksdb::GetPerfLevel()))
+{
+    ::rocksdb::SetPerfLevel(level == perf_level::count_time
+        ? ::rocksdb::PerfLevel::kEnableTimeExceptForMutex
+        : ::rocksdb::PerfLevel::kEnableCount);
+    ::rocksdb::get_perf_context()->Reset();
+}
+
+perf_scope::~perf_scope ()
+{
+    ::rocksdb::SetPerfLevel(static_cast<::rocksdb::PerfLevel>(_saved_level));
+}
+
+perf_counters perf_scope::counters () const
+{
+    auto ctx = ::rocksdb::get_perf_context();
+
+    perf_counters result;
+    result.user_key_comparison_count = ctx->user_key_comparison_count;
+    result.block_cache_hit_count = ctx->block_cache_hit_count;
+    result.block_read_count = ctx->block_read_count;
+    result.block_read_byte = ctx->block_read_byte;
+    result.block_read_time = ctx->block_read_time;
+    result.get_from_memtable_count = ctx->get_from_memtable_count;
+    result.get_from_memtable_time = ctx->get_from_memtable_time;
+    result.get_from_output_files_time = ctx->get_from_output_files_time;
+    result.bloom_memtable_hit_count = ctx->bloom_memtable_hit_count;
+    result.bloom_memtable_miss_count = ctx->bloom_memtable_miss_count;
+    result.bloom_sst_hit_count = ctx->bloom_sst_hit_count;
+    result.bloom_sst_miss_count = ctx->bloom_sst_miss_count;
+    result.internal_key_skipped_count = ctx->internal_key_skipped_count;
+    result.internal_delete_skipped_count = ctx->internal_delete_skipped_count;
+    result.write_wal_time = ctx->write_wal_time;
+    result.write_memtable_time = ctx->write_memtable_time;
+    return result;
+}
+
+} // namespace rocksdb
+
+DEBBY__NAMESPACE_END
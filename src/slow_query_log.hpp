@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+//                 Options are shared as immutable snapshot.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/slow_query_log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+/**
+ * Slow-query log shared by relational database backends. Records are kept in
+ * bounded ring buffer and can be queried from any thread.
+ *
+ * @details Options are replaced by `enable()` as whole immutable snapshot, so queries
+ *          running concurrently see either previous or new options.
+ */
+class slow_query_log
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // Maximum length of the parameters summary
+    static constexpr std::size_t PARAMS_SUMMARY_LIMIT = 256;
+
+private:
+    std::atomic<bool> _enabled {false};
+
+    // Accessed by std::atomic_load/std::atomic_store only
+    std::shared_ptr<slow_query_options const> _opts {std::make_shared<slow_query_options>()};
+
+    mutable std::mutex _mtx;
+    std::vector<slow_query_record> _ring;
+    std::size_t _capacity {1};
+    std::size_t _next {0}; // Position for the next record
+
+private:
+    std::shared_ptr<slow_query_options const> options () const noexcept
+    {
+        return std::atomic_load(& _opts);
+    }
+
+public:
+    bool enabled () const noexcept
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    bool explain () const noexcept
+    {
+        return options()->explain;
+    }
+
+    /**
+     * Checks if elapsed time since @a start exceeds threshold.
+     */
+    bool is_slow (clock_type::time_point start, std::chrono::microseconds & elapsed) const noexcept
+    {
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start);
+        return elapsed >= options()->threshold;
+    }
+
+    void enable (slow_query_options && opts)
+    {
+        auto capacity = (std::max)(opts.capacity, std::size_t{1});
+        std::shared_ptr<slow_query_options const> snapshot = std::make_shared<slow_query_options>(std::move(opts));
+
+        std::lock_guard<std::mutex> locker{_mtx};
+        std::atomic_store(& _opts, std::move(snapshot));
+        _ring.clear();
+        _ring.reserve(capacity);
+        _capacity = capacity;
+        _next = 0;
+        _enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void disable ()
+    {
+        _enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void push (slow_query_record && rec)
+    {
+        auto opts = options();
+
+        if (opts->callback)
+            opts->callback(rec);
+
+        std::lock_guard<std::mutex> locker{_mtx};
+        auto capacity = _capacity;
+
+        if (_ring.size() < capacity) {
+            _ring.push_back(std::move(rec));
+        } else {
+            _ring[_next] = std::move(rec);
+        }
+
+        _next = (_next + 1) % capacity;
+    }
+
+    /**
+     * Returns records from the oldest to the newest.
+     */
+    std::vector<slow_query_record> records () const
+    {
+        std::lock_guard<std::mutex> locker{_mtx};
+        std::vector<slow_query_record> result;
+        result.reserve(_ring.size());
+
+        auto first = _ring.size() < _capacity ? 0 : _next;
+
+        for (std::size_t i = 0; i < _ring.size(); i++)
+            result.push_back(_ring[(first + i) % _ring.size()]);
+
+        return result;
+    }
+
+    void clear ()
+    {
+        std::lock_guard<std::mutex> locker{_mtx};
+        _ring.clear();
+        _next = 0;
+    }
+
+public:
+    /**
+     * Appends parameter value (truncated) to the summary @a out.
+     */
+    static void append_param (std::string & out, int index, char const * value, std::size_t len, bool binary)
+    {
+        if (out.size() >= PARAMS_SUMMARY_LIMIT)
+            return;
+
+        if (!out.empty())
+            out += ", ";
+
+        out += '$';
+        out += std::to_string(index);
+        out += '=';
+
+        if (value == nullptr) {
+            out += "NULL";
+        } else if (binary) {
+            out += "<";
+            out += std::to_string(len);
+            out += " bytes>";
+        } else {
+            constexpr std::size_t VALUE_LIMIT = 32;
+            out += '\'';
+            out.append(value, (std::min)(len, VALUE_LIMIT));
+
+            if (len > VALUE_LIMIT)
+                out += "...";
+
+            out += '\'';
+        }
+
+        if (out.size() > PARAMS_SUMMARY_LIMIT) {
+            out.resize(PARAMS_SUMMARY_LIMIT);
+            out += "...";
+        }
+    }
+
+    /**
+     * Checks if @a sql starts with keyword @a keyword (case-insensitive).
+     */
+    static bool starts_with_keyword (std::string const & sql, char const * keyword)
+    {
+        auto pos = sql.find_first_not_of(" \t\r\n(");
+
+        if (pos == std::string::npos)
+            return false;
+
+        for (; *keyword != '\0'; ++keyword, ++pos) {
+            if (pos >= sql.size())
+                return false;
+
+            if (std::tolower(static_cast<unsigned char>(sql[pos])) != *keyword)
+                return false;
+        }
+
+        return pos == sql.size() || !std::isalnum(static_cast<unsigned char>(sql[pos]));
+    }
+};
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/sqlite3.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+DEBBY__NAMESPACE_BEGIN
+
+namespace sqlite3 {
+
+/**
+ * Busy handler of the connection (see `sqlite3_busy_handler()`). Counters can be read
+ * concurrently with the connection usage.
+ */
+class busy_handler
+{
+    using clock_type = std::chrono::steady_clock;
+
+private:
+    busy_policy _policy;
+    std::chrono::microseconds _event_wait {0}; // Wait of the current busy event
+    std::minstd_rand _rand;
+
+    std::atomic<std::uint64_t> _busy_events {0};
+    std::atomic<std::uint64_t> _timeouts {0};
+    std::atomic<std::uint64_t> _transaction_restarts {0};
+    std::atomic<std::int64_t> _total_wait {0}; // In microseconds
+
+public:
+    busy_handler ()
+        : _rand(static_cast<std::minstd_rand::result_type>(
+            clock_type::now().time_since_epoch().count()))
+    {}
+
+public:
+    static int callback (void * data, int count)
+    {
+        return static_cast<busy_handler *>(data)->handle(count);
+    }
+
+    busy_policy const & policy () const noexcept
+    {
+        return _policy;
+    }
+
+    void set_policy (busy_policy const & policy) noexcept
+    {
+        _policy = policy;
+    }
+
+    void on_transaction_restart () noexcept
+    {
+        ++_transaction_restarts;
+    }
+
+    busy_stats stats () const noexcept
+    {
+        busy_stats result;
+        result.busy_events = _busy_events.load();
+        result.timeouts = _timeouts.load();
+        result.transaction_restarts = _transaction_restarts.load();
+        result.total_wait = std::chrono::microseconds{_total_wait.load()};
+        return result;
+    }
+
+    void reset_stats () noexcept
+    {
+        _busy_events = 0;
+        _timeouts = 0;
+        _transaction_restarts = 0;
+        _total_wait = 0;
+    }
+
+private:
+    /**
+     * @param count Number of times the handler was invoked for the current busy event.
+     * @return Non-zero to retry the lock acquisition.
+     */
+    int handle (int count)
+    {
+        if (count == 0) {
+            ++_busy_events;
+            _event_wait = std::chrono::microseconds{0};
+        }
+
+        std::chrono::microseconds const max_wait = _policy.max_wait;
+        auto delay = (std::min)(backoff(count), max_wait - _event_wait);
+
+        if (delay.count() <= 0) {
+            ++_timeouts;
+            return 0;
+        }
+
+        auto start = clock_type::now();
+        std::this_thread::sleep_for(delay);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start);
+
+        _event_wait += elapsed;
+        _total_wait += elapsed.count();
+
+        return 1;
+    }
+
+    std::chrono::microseconds backoff (int count)
+    {
+        std::chrono::microseconds const initial_delay = (std::max)(_policy.initial_delay
+            , std::chrono::milliseconds{1});
+        std::chrono::microseconds const max_delay = (std::max)(_policy.max_delay
+            , _policy.initial_delay);
+
+        // Shift is limited to avoid overflow, the delay reaches the limit much earlier
+        auto delay = (std::min)(initial_delay * (std::int64_t{1} << (std::min)(count, 20))
+            , max_delay);
+
+        std::uniform_int_distribution<std::int64_t> jitter {0, delay.count() / 2};
+        return delay - std::chrono::microseconds{jitter(_rand)};
+    }
+};
+
+} // namespace sqlite3
+
+DEBBY__NAMESPACE_END
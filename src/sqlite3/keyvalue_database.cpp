@@ -1,25 +1,95 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.04 Initial version.
 //      2025.09.29 Changed set/get implementation.
+//      2026.10.18 `INSERT OR REPLACE` replaced by UPSERT.
+//                 Added key-value table layout option.
+//                 Added `remove_many()`.
+//                 Added `for_each_key()`.
+//                 Added `increment()` and `append()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../keyvalue_database_common.hpp"
 #include "../keyvalue_relational_database_impl.hpp"
 #include "relational_database_impl.hpp"
 #include "debby/sqlite3.hpp"
 #include <pfs/fmt.hpp>
+#include <algorithm>
 
 DEBBY__NAMESPACE_BEGIN
 
 using keyvalue_database_t = keyvalue_database<backend_enum::sqlite3>;
 
 template<> char const * keyvalue_database_t::impl::REMOVE_SQL = R"(DELETE FROM "{}" WHERE key=?)";
-template<> char const * keyvalue_database_t::impl::PUT_SQL = R"(INSERT OR REPLACE INTO "{}" (key, value) VALUES (?, ?))";
+template<> char const * keyvalue_database_t::impl::PUT_SQL = R"(INSERT INTO "{}" (key, value) VALUES (?, ?) ON CONFLICT (key) DO UPDATE SET value=excluded.value)";
 template<> char const * keyvalue_database_t::impl::GET_SQL = R"(SELECT value FROM "{}" WHERE key=?)";
+template<> char const * keyvalue_database_t::impl::FOR_EACH_KEY_SQL = R"(SELECT key FROM "{}" WHERE key >= ? ORDER BY key)";
+template<> char const * keyvalue_database_t::impl::INIT_SQL = R"(INSERT INTO "{}" (key, value) VALUES (?, ?) ON CONFLICT (key) DO NOTHING)";
+template<> char const * keyvalue_database_t::impl::LOCK_SQL = R"(SELECT value FROM "{}" WHERE key=?)";
+
+// Maximum number of keys removed by single statement execution
+// (must not exceed SQLITE_MAX_VARIABLE_NUMBER).
+static constexpr std::size_t REMOVE_MANY_CHUNK_SIZE = 256;
+
+static std::string remove_many_sql (std::string const & table_name, std::size_t count)
+{
+    std::string sql = fmt::format(R"(DELETE FROM "{}" WHERE key IN (?)", table_name);
+    sql.reserve(sql.size() + 2 * count);
+
+    for (std::size_t i = 1; i < count; i++)
+        sql += ",?";
+
+    sql += ')';
+    return sql;
+}
+
+template <>
+void keyvalue_database_t::impl::remove_many (std::vector<key_type> const & keys, error * perr)
+{
+    if (keys.empty())
+        return;
+
+    error err;
+    this->begin(& err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return;
+    }
+
+    std::size_t offset = 0;
+
+    while (!err && offset < keys.size()) {
+        auto count = (std::min)(REMOVE_MANY_CHUNK_SIZE, keys.size() - offset);
+
+        // Only the full chunk statement is cached, the tail one is used once
+        auto stmt = count == REMOVE_MANY_CHUNK_SIZE
+            ? this->prepare_cached(remove_many_sql(_table_name, count), & err)
+            : this->prepare(remove_many_sql(_table_name, count), & err);
+
+        for (std::size_t i = 0; !err && i < count; i++) {
+            auto const & key = keys[offset + i];
+            stmt.bind(static_cast<int>(i + 1), key.c_str(), key.size(), & err);
+        }
+
+        if (!err)
+            stmt.exec(& err);
+
+        offset += count;
+    }
+
+    if (!err)
+        this->commit(& err);
+
+    if (err) {
+        error ignored;
+        this->rollback(& ignored);
+        pfs::throw_or(perr, std::move(err));
+    }
+}
 
 template keyvalue_database_t::keyvalue_database ();
 template keyvalue_database_t::keyvalue_database (impl && d) noexcept;
@@ -29,6 +99,13 @@ template keyvalue_database_t & keyvalue_database_t::operator = (keyvalue_databas
 
 template void keyvalue_database_t::clear (error * perr);
 template void keyvalue_database_t::remove (key_type const & key, error * perr);
+template void keyvalue_database_t::remove_many (std::vector<key_type> const & keys, error * perr);
+template void keyvalue_database_t::write_batch (std::function<void ()> const & f, error * perr);
+template void keyvalue_database_t::for_each_key (key_type const & prefix
+    , std::function<bool (key_type const &)> const & f, error * perr) const;
+template void keyvalue_database_t::increment (key_type const & key, std::int64_t delta, error * perr);
+template void keyvalue_database_t::append (key_type const & key, char const * data, std::size_t len
+    , error * perr);
 template void keyvalue_database_t::set (key_type const & key, char const * value
     , std::size_t len, error * perr);
 
@@ -81,6 +158,13 @@ make_kv (pfs::filesystem::path const & path, std::string const & table_name, boo
 keyvalue_database<backend_enum::sqlite3>
 make_kv (pfs::filesystem::path const & path, std::string const & table_name, bool create_if_missing
     , preset_enum preset, error * perr)
+{
+    return make_kv(path, table_name, create_if_missing, preset, KV_WITHOUT_ROWID, perr);
+}
+
+keyvalue_database<backend_enum::sqlite3>
+make_kv (pfs::filesystem::path const & path, std::string const & table_name, bool create_if_missing
+    , preset_enum preset, kv_layout_enum layout, error * perr)
 {
     error err;
     auto db = make(path, create_if_missing, preset, & err);
@@ -90,9 +174,10 @@ make_kv (pfs::filesystem::path const & path, std::string const & table_name, boo
         return keyvalue_database_t{};
     }
 
+    // PRIMARY KEY implies uniqueness, so no extra UNIQUE constraint (and index) is needed.
     std::string sql = fmt::format("CREATE TABLE IF NOT EXISTS \"{}\""
-        " (key TEXT NOT NULL UNIQUE, value BLOB"
-        " , PRIMARY KEY(key)) WITHOUT ROWID", table_name);
+        " (key TEXT NOT NULL PRIMARY KEY, value BLOB){}", table_name
+        , layout == KV_WITHOUT_ROWID ? " WITHOUT ROWID" : "");
 
     db.query(sql, & err);
 
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -9,6 +9,9 @@
 //      2022.03.12 Refactored.
 //      2023.02.07 Applied new API.
 //      2024.10.29 V2 started.
+//      2026.10.18 Added slow-query log.
+//                 Added nested transactions (savepoints) and transaction modes.
+//                 Fixed busy timeout replaced by busy policy.
 ////////////////////////////////////////////////////////////////////////////////
 #include "../relational_database_common.hpp"
 #include "relational_database_impl.hpp"
@@ -27,6 +30,17 @@ template database_t::~relational_database ();
 template database_t & database_t::operator = (relational_database && other) noexcept;
 
 template std::size_t database_t::rows_count (std::string const & table_name, error * perr);
+template void database_t::enable_slow_query_log (slow_query_options opts);
+template void database_t::disable_slow_query_log ();
+template std::vector<slow_query_record> database_t::slow_queries () const;
+template void database_t::clear_slow_queries ();
+template void database_t::begin (error * perr);
+template void database_t::begin (transaction_mode mode, error * perr);
+template void database_t::commit (error * perr);
+template void database_t::rollback (error * perr);
+template void database_t::rollback_to (int depth, error * perr);
+template int database_t::transaction_depth () const noexcept;
+template bool database_t::restart_transaction (error const & err, int attempt);
 
 template <>
 void database_t::query (std::string const & sql, error * perr)
@@ -40,25 +54,6 @@ database_t::result_type database_t::exec (std::string const & sql, error * perr)
     return _d->exec(sql, perr);
 }
 
-template <>
-void database_t::begin (error * perr)
-{
-    query("BEGIN TRANSACTION", perr);
-}
-
-template <>
-void database_t::commit (error * perr)
-{
-    query("COMMIT TRANSACTION", perr);
-    //sqlite3_wal_checkpoint_v2(_rep.dbh, nullptr, SQLITE_CHECKPOINT_FULL, nullptr, nullptr);
-}
-
-template <>
-void database_t::rollback (error * perr)
-{
-    query("ROLLBACK TRANSACTION", perr);
-}
-
 template <>
 database_t::statement_type database_t::prepare (std::string const & sql, error * perr)
 {
@@ -187,8 +182,6 @@ bool database_t::exists (std::string const & name, error * perr)
 
 namespace sqlite3 {
 
-int constexpr MAX_BUSY_TIMEOUT = 1000; // 1 second
-
 database_t make (fs::path const & path, bool create_if_missing, error * perr)
 {
     return make(path, create_if_missing, make_options{}, perr);
@@ -266,9 +259,6 @@ database_t make (pfs::filesystem::path const & path, bool create_if_missing, mak
             });
         }
     } else {
-        // NOTE what for this call ?
-        sqlite3_busy_timeout(dbh, MAX_BUSY_TIMEOUT);
-
         // Enable extended result codes
         sqlite3_extended_result_codes(dbh, 1);
 
@@ -335,6 +325,9 @@ database_t make (pfs::filesystem::path const & path, bool create_if_missing, mak
 
         database_t::impl d{dbh};
 
+        if (opts.busy)
+            d.busy().set_policy(*opts.busy);
+
         for (auto const & pragma: pragmas) {
             error err;
             auto success = d.query(pragma, & err);
@@ -351,6 +344,28 @@ database_t make (pfs::filesystem::path const & path, bool create_if_missing, mak
     return database_t{};
 }
 
+void set_busy_policy (database_t & db, busy_policy const & policy)
+{
+    auto d = db.backend_impl();
+
+    if (d != nullptr)
+        d->busy().set_policy(policy);
+}
+
+busy_stats stats (database_t const & db)
+{
+    auto d = db.backend_impl();
+    return d == nullptr ? busy_stats{} : d->busy().stats();
+}
+
+void reset_stats (database_t & db)
+{
+    auto d = db.backend_impl();
+
+    if (d != nullptr)
+        d->busy().reset_stats();
+}
+
 bool wipe (fs::path const & path, error * perr)
 {
     std::error_code ec;
@@ -1,17 +1,23 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.11.13 Initial version (moved from relational_database.cpp).
+//      2026.10.18 Added slow-query log.
+//                 Added transaction depth tracking.
+//                 Added busy handler.
 ////////////////////////////////////////////////////////////////////////////////
+#include "busy_handler.hpp"
 #include "statement_impl.hpp"
 #include "result_impl.hpp"
 #include "debby/relational_database.hpp"
 #include "sqlite3.h"
 #include "utils.hpp"
+#include "../slow_query_log.hpp"
 #include <pfs/i18n.hpp>
+#include <memory>
 #include <unordered_map>
 
 DEBBY__NAMESPACE_BEGIN
@@ -28,16 +34,30 @@ public:
 private:
     native_type _dbh {nullptr};
     cache_type  _cache; // Prepared statements cache
+    int _transaction_depth {0}; // Zero or number of nested transactions started by `begin()`
+
+    // Allocated separately to keep address stable for statements
+    std::unique_ptr<slow_query_log> _slow_log {new slow_query_log};
+
+    // Allocated separately to keep address stable for the connection
+    std::unique_ptr<sqlite3::busy_handler> _busy {new sqlite3::busy_handler};
 
 public:
     impl (native_type dbh) : _dbh(dbh)
-    {}
+    {
+        if (_dbh != nullptr)
+            sqlite3_busy_handler(_dbh, sqlite3::busy_handler::callback, _busy.get());
+    }
 
     impl (impl && other) noexcept
     {
         _dbh = other._dbh;
         other._dbh = nullptr;
         _cache = std::move(other._cache);
+        _transaction_depth = other._transaction_depth;
+        other._transaction_depth = 0;
+        _slow_log = std::move(other._slow_log);
+        _busy = std::move(other._busy);
     }
 
     ~impl ()
@@ -55,19 +75,81 @@ public:
     }
 
 public:
+    static char const * begin_sql (transaction_mode mode) noexcept
+    {
+        switch (mode) {
+            case transaction_mode::standard:
+            case transaction_mode::deferred:
+                return "BEGIN DEFERRED TRANSACTION";
+            case transaction_mode::immediate:
+                return "BEGIN IMMEDIATE TRANSACTION";
+            case transaction_mode::exclusive:
+                return "BEGIN EXCLUSIVE TRANSACTION";
+            default:
+                break;
+        }
+
+        return nullptr;
+    }
+
+    int & transaction_depth () noexcept
+    {
+        return _transaction_depth;
+    }
+
+    bool in_transaction () const noexcept
+    {
+        return _dbh != nullptr && sqlite3_get_autocommit(_dbh) == 0;
+    }
+
+    int max_transaction_retries () const noexcept
+    {
+        return _busy->policy().max_transaction_retries;
+    }
+
+    void on_transaction_restart () noexcept
+    {
+        _busy->on_transaction_restart();
+    }
+
+    sqlite3::busy_handler & busy () const noexcept
+    {
+        return *_busy;
+    }
+
+    slow_query_log & slow_log () const noexcept
+    {
+        return *_slow_log;
+    }
+
     bool query (std::string const & sql, error * perr)
     {
+        bool logged = _slow_log->enabled();
+        auto start = logged ? slow_query_log::clock_type::now() : slow_query_log::clock_type::time_point{};
+
         int rc = sqlite3_exec(_dbh, sql.c_str(), nullptr, nullptr, nullptr);
 
         if (SQLITE_OK != rc) {
             pfs::throw_or(perr, error {
-                  make_error_code(errc::sql_error)
+                  make_error_code(sqlite3::sql_errc(rc))
                 , fmt::format("{}: {}", sqlite3::build_errstr(rc, _dbh), sql)
             });
 
             return false;
         }
 
+        std::chrono::microseconds elapsed;
+
+        // Query may consist of multiple statements, so it is not explained
+        if (logged && _slow_log->is_slow(start, elapsed)) {
+            slow_query_record rec;
+            rec.timestamp = std::chrono::system_clock::now();
+            rec.sql = sql;
+            rec.elapsed = elapsed;
+            rec.rows = sqlite3_changes(_dbh);
+            _slow_log->push(std::move(rec));
+        }
+
         return true;
     }
 
@@ -86,7 +168,7 @@ public:
             return database_t::result_type{};
         }
 
-        return statement_t::impl{sth, false}.exec(true, perr);
+        return statement_t::impl{sth, false, _slow_log.get()}.exec(true, perr);
     }
 
     database_t::statement_type prepare (std::string const & sql, bool cache_it, error * perr)
@@ -100,7 +182,7 @@ public:
         if (pos != _cache.end()) {
             sqlite3_reset(pos->second);
             sqlite3_clear_bindings(pos->second);
-            statement_t::impl d{pos->second, true};
+            statement_t::impl d{pos->second, true, _slow_log.get()};
             return database_t::statement_type {std::move(d)};
         }
 
@@ -130,7 +212,7 @@ public:
             }
         }
 
-        statement_t::impl d{sth, cache_it};
+        statement_t::impl d{sth, cache_it, _slow_log.get()};
         return database_t::statement_type{std::move(d)};
     }
 };
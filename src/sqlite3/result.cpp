@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -9,13 +9,23 @@
 //      2022.03.12 Refactored.
 //      2024.10.29 V2 started.
 //      2025.09.30 Changed get implementation.
+//      2026.10.18 Added instrumentation.
+//                 Added `column()`.
+//                 Added `fetch_columns()`.
+//                 Added row view.
+//                 Snapshot conflict reported as `transaction_conflict`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "result_impl.hpp"
 #include "utils.hpp"
+#include "../column_batch_builder.hpp"
 #include "../fixed_packer.hpp"
+#include "../instrumentation.hpp"
 #include <pfs/assert.hpp>
 #include <pfs/i18n.hpp>
+#include <algorithm>
+#include <cctype>
 #include <cstring>
+#include <string>
 #include <utility>
 
 DEBBY__NAMESPACE_BEGIN
@@ -91,9 +101,24 @@ std::string result_t::column_name (int column) const noexcept
     return std::string{};
 }
 
+template <>
+result_t::column_handle result_t::column (std::string const & name, error * perr) const
+{
+    auto index = _d->column_index(name);
+
+    if (index < 0) {
+        pfs::throw_or(perr, make_error_code(errc::column_not_found)
+            , tr::f_("bad column name: {}", name));
+        return column_handle{};
+    }
+
+    return column_handle{index + 1};
+}
+
 template <>
 void result_t::next ()
 {
+    DEBBY__INSTRUMENT(backend_enum::sqlite3, result_next, _d->fingerprint, 0);
     auto rc = sqlite3_step(_d->sth);
 
     switch (rc) {
@@ -125,7 +150,7 @@ void result_t::next ()
             _d->state = impl::FAILURE;
 
             throw error {
-                  make_error_code(errc::sql_error)
+                  make_error_code(sqlite3::sql_errc(rc))
                 , fmt::format("{} :{}", sqlite3::build_errstr(rc, _d->sth)
                     , sqlite3::current_sql(_d->sth))
             };
@@ -389,4 +414,187 @@ pfs::optional<std::string> result_t::get<std::string> (std::string const & colum
     return _d->get_string(column, perr);
 }
 
+// Column type by the declared type affinity (see "Determination Of Column Affinity" in
+// SQLite documentation) or by the storage class of the current value
+static column_type batch_column_type (sqlite3_stmt * sth, int column)
+{
+    auto decl = sqlite3_column_decltype(sth, column);
+
+    if (decl != nullptr) {
+        std::string t {decl};
+        std::transform(t.begin(), t.end(), t.begin(), [] (char ch) {
+            return static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        });
+
+        if (t.find("INT") != std::string::npos)
+            return column_type::int64;
+
+        if (t.find("CHAR") != std::string::npos || t.find("CLOB") != std::string::npos
+                || t.find("TEXT") != std::string::npos || t.find("BLOB") != std::string::npos) {
+            return column_type::binary;
+        }
+
+        if (t.find("REAL") != std::string::npos || t.find("FLOA") != std::string::npos
+                || t.find("DOUB") != std::string::npos) {
+            return column_type::float64;
+        }
+    }
+
+    switch (sqlite3_column_type(sth, column)) {
+        case SQLITE_INTEGER:
+            return column_type::int64;
+        case SQLITE_FLOAT:
+            return column_type::float64;
+        default:
+            return column_type::binary;
+    }
+}
+
+template <>
+std::size_t result_t::fetch_columns (column_batch & batch, std::size_t batch_size, error * perr)
+{
+    namespace builder = column_batch_builder;
+
+    auto sth = _d->sth;
+    auto column_count = _d->column_count;
+
+    builder::reset(batch, column_count, batch_size);
+
+    if (_d->state != impl::ROW)
+        return 0;
+
+    for (int column = 0; column < column_count; column++) {
+        auto & c = batch.columns[column];
+        c.name = sqlite3_column_name(sth, column);
+        c.type = batch_column_type(sth, column);
+        builder::start_column(c, batch_size);
+    }
+
+    std::size_t row = 0;
+
+    while (row < batch_size && _d->state == impl::ROW) {
+        for (int column = 0; column < column_count; column++) {
+            auto & c = batch.columns[column];
+
+            if (sqlite3_column_type(sth, column) == SQLITE_NULL) {
+                builder::append_null(c, row);
+                continue;
+            }
+
+            switch (c.type) {
+                case column_type::int64:
+                    builder::append_int64(c, row, sqlite3_column_int64(sth, column));
+                    break;
+
+                case column_type::float64:
+                    builder::append_float64(c, row, sqlite3_column_double(sth, column));
+                    break;
+
+                case column_type::binary: {
+                    // Text representation for numbers, raw bytes for text and blobs
+                    auto bytes = static_cast<char const *>(sqlite3_column_blob(sth, column));
+                    auto size = sqlite3_column_bytes(sth, column);
+                    builder::append_binary(c, row, bytes, static_cast<std::size_t>(size));
+                    break;
+                }
+            }
+        }
+
+        row++;
+        batch.row_count = row;
+
+        auto rc = sqlite3_step(sth);
+
+        if (rc == SQLITE_ROW)
+            continue;
+
+        if (rc == SQLITE_DONE) {
+            _d->state = impl::DONE;
+            sqlite3_reset(sth);
+            break;
+        }
+
+        _d->state = impl::FAILURE;
+
+        error err {
+              make_error_code(sqlite3::sql_errc(rc))
+            , fmt::format("{}: {}", sqlite3::build_errstr(rc, sth), sqlite3::current_sql(sth))
+        };
+
+        sqlite3_reset(sth);
+        pfs::throw_or(perr, std::move(err));
+        break;
+    }
+
+    return batch.row_count;
+}
+
+template <>
+bool result_t::row_view::is_null (int column) const noexcept
+{
+    return sqlite3_column_type(_r->_d->sth, column - 1) == SQLITE_NULL;
+}
+
+template <>
+std::int64_t result_t::row_view::get_int64 (int column) const noexcept
+{
+    auto d = _r->_d;
+
+    switch (sqlite3_column_type(d->sth, column - 1)) {
+        case SQLITE_NULL:
+            return 0;
+
+        // Values stored by key/value database
+        case SQLITE_BLOB: {
+            error err;
+            auto opt = d->get_int64(column, & err);
+            return (err || !opt) ? 0 : *opt;
+        }
+
+        default:
+            return sqlite3_column_int64(d->sth, column - 1);
+    }
+}
+
+template <>
+double result_t::row_view::get_double (int column) const noexcept
+{
+    auto d = _r->_d;
+
+    switch (sqlite3_column_type(d->sth, column - 1)) {
+        case SQLITE_NULL:
+            return 0;
+
+        // Values stored by key/value database
+        case SQLITE_BLOB: {
+            error err;
+            auto opt = d->get_double(column, & err);
+            return (err || !opt) ? 0 : *opt;
+        }
+
+        default:
+            return sqlite3_column_double(d->sth, column - 1);
+    }
+}
+
+template <>
+pfs::string_view result_t::row_view::text (int column) const noexcept
+{
+    auto sth = _r->_d->sth;
+    auto chars = reinterpret_cast<char const *>(sqlite3_column_text(sth, column - 1));
+    auto size = sqlite3_column_bytes(sth, column - 1);
+
+    return chars == nullptr ? pfs::string_view{} : pfs::string_view{chars, static_cast<std::size_t>(size)};
+}
+
+template <>
+pfs::string_view result_t::row_view::blob (int column) const noexcept
+{
+    auto sth = _r->_d->sth;
+    auto bytes = static_cast<char const *>(sqlite3_column_blob(sth, column - 1));
+    auto size = sqlite3_column_bytes(sth, column - 1);
+
+    return bytes == nullptr ? pfs::string_view{} : pfs::string_view{bytes, static_cast<std::size_t>(size)};
+}
+
 DEBBY__NAMESPACE_END
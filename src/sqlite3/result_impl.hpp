@@ -1,11 +1,13 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.10.30 Initial version.
 //      2025.09.30 Changed get implementation.
+//      2026.10.18 Added SQL fingerprint for instrumentation.
+//                 `column_index()` is public (used by column handle).
 ////////////////////////////////////////////////////////////////////////////////
 #include "sqlite3.h"
 #include "debby/namespace.hpp"
@@ -37,6 +39,10 @@ public:
     int column_count {0};
     mutable std::unordered_map<std::string, int> column_mapping;
 
+#if DEBBY__INSTRUMENTATION_ENABLED
+    std::uint64_t fingerprint {0};
+#endif
+
 private:
     bool _handle_owned {false};
 
@@ -60,6 +66,9 @@ public:
         column_count = other.column_count;
         column_mapping = std::move(other.column_mapping);
         _handle_owned = other._handle_owned;
+#if DEBBY__INSTRUMENTATION_ENABLED
+        fingerprint = other.fingerprint;
+#endif
 
         other.sth = nullptr;
         other._handle_owned = false;
@@ -85,7 +94,6 @@ public:
     pfs::optional<double> get_double (std::string const & column_name, error * perr) const;
     pfs::optional<std::string> get_string (std::string const & column_name, error * perr) const;
 
-private:
     /**
      * @return Column index started from 0 and -1 if column not found
      */
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -10,6 +10,10 @@
 //      2024.10.29 V2 started.
 //      2024.10.30 V2 implemented.
 //      2025.09.30 Changed bind implementation.
+//      2026.10.18 Added instrumentation.
+//                 Added slow-query log.
+//                 Added `bind_array()` (unsupported).
+//                 Snapshot conflict reported as `transaction_conflict`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "result_impl.hpp"
 #include "statement_impl.hpp"
@@ -17,6 +21,7 @@
 #include <pfs/i18n.hpp>
 #include <pfs/numeric_cast.hpp>
 #include <limits>
+#include <unordered_map>
 
 DEBBY__NAMESPACE_BEGIN
 
@@ -41,7 +46,100 @@ void statement_t::impl::reset (error * perr)
     }
 }
 
+static std::string explain_query_plan (struct sqlite3 * dbh, char const * sql)
+{
+    std::string explain_sql = std::string{"EXPLAIN QUERY PLAN "} + sql;
+    struct sqlite3_stmt * sth {nullptr};
+
+    auto rc = sqlite3_prepare_v2(dbh, explain_sql.c_str(), static_cast<int>(explain_sql.size()), & sth, nullptr);
+
+    if (SQLITE_OK != rc)
+        return std::string{};
+
+    std::string plan;
+    std::unordered_map<int, int> depths;
+
+    // Columns: id, parent, notused, detail
+    while (sqlite3_step(sth) == SQLITE_ROW) {
+        auto id = sqlite3_column_int(sth, 0);
+        auto parent = sqlite3_column_int(sth, 1);
+        auto detail = reinterpret_cast<char const *>(sqlite3_column_text(sth, 3));
+        auto pos = depths.find(parent);
+        auto depth = pos == depths.end() ? 0 : pos->second + 1;
+
+        depths[id] = depth;
+
+        if (!plan.empty())
+            plan += '\n';
+
+        plan.append(2 * depth, ' ');
+        plan += detail != nullptr ? detail : "";
+    }
+
+    sqlite3_finalize(sth);
+    return plan;
+}
+
+void statement_t::impl::log_slow_query (native_type sth, std::chrono::microseconds elapsed)
+{
+    slow_query_record rec;
+    rec.timestamp = std::chrono::system_clock::now();
+    rec.elapsed = elapsed;
+
+    auto sql = sqlite3_sql(sth);
+    rec.sql = sql != nullptr ? sql : "";
+
+    // SQLite does not provide access to bound values, so SQL text with
+    // substituted values is used as parameters summary.
+    if (sqlite3_bind_parameter_count(sth) > 0) {
+        auto expanded = sqlite3_expanded_sql(sth);
+
+        if (expanded != nullptr) {
+            rec.params = expanded;
+            sqlite3_free(expanded);
+
+            if (rec.params.size() > slow_query_log::PARAMS_SUMMARY_LIMIT) {
+                rec.params.resize(slow_query_log::PARAMS_SUMMARY_LIMIT);
+                rec.params += "...";
+            }
+        }
+    }
+
+    // Rows of the query are fetched lazily, so unknown
+    rec.rows = sqlite3_stmt_readonly(sth) ? -1 : sqlite3_changes(sqlite3_db_handle(sth));
+
+    if (_slow_log->explain() && sql != nullptr)
+        rec.plan = explain_query_plan(sqlite3_db_handle(sth), sql);
+
+    _slow_log->push(std::move(rec));
+}
+
 statement_t::result_type statement_t::impl::exec (bool move_handle_ownership, error * perr)
+{
+    if (_slow_log == nullptr || !_slow_log->enabled())
+        return exec_step(move_handle_ownership, perr);
+
+    // Handle may be moved to the result
+    auto sth = _sth;
+    auto start = slow_query_log::clock_type::now();
+
+    error err;
+    auto res = exec_step(move_handle_ownership, & err);
+
+    if (err) {
+        pfs::throw_or(perr, std::move(err));
+        return res;
+    }
+
+    std::chrono::microseconds elapsed;
+
+    if (_slow_log->is_slow(start, elapsed))
+        log_slow_query(sth, elapsed);
+
+    return res;
+}
+
+statement_t::result_type statement_t::impl::exec_step (bool move_handle_ownership, error * perr)
 {
     std::error_code ec;
     result_t::impl::status status {result_t::impl::INITIAL};
@@ -72,7 +170,7 @@ statement_t::result_type statement_t::impl::exec (bool move_handle_ownership, er
         default: {
             status = result_t::impl::FAILURE;
 
-            pfs::throw_or(perr, make_error_code(errc::sql_error)
+            pfs::throw_or(perr, make_error_code(sqlite3::sql_errc(rc))
                 , fmt::format("{}: {}", sqlite3::build_errstr(rc, _sth), sqlite3::current_sql(_sth)));
 
             return result_t{};
@@ -82,7 +180,13 @@ statement_t::result_type statement_t::impl::exec (bool move_handle_ownership, er
     if (rc != SQLITE_ROW)
         sqlite3_reset(_sth);
 
-    return result_t{result_t::impl{_sth, status, move_handle_ownership}};
+    result_t::impl d{_sth, status, move_handle_ownership};
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+    d.fingerprint = fingerprint();
+#endif
+
+    return result_t{std::move(d)};
 }
 
 template <>
@@ -371,9 +475,30 @@ bool statement_t::bind (char const * placeholder, char const * ptr, std::size_t
     return _d->bind_blob(placeholder, ptr, len, perr);
 }
 
+// SQLite has no array parameters
+#define DEBBY__ARRAY_BIND(t)                                                      \
+    template <>                                                                   \
+    template <>                                                                   \
+    bool statement_t::bind_array<t> (int, std::vector<t> const &, error * perr)   \
+    {                                                                             \
+        pfs::throw_or(perr, make_error_code(errc::unsupported)                    \
+            , tr::_("array parameters are not supported by SQLite"));             \
+        return false;                                                             \
+    }
+
+DEBBY__ARRAY_BIND(bool)
+DEBBY__ARRAY_BIND(short)
+DEBBY__ARRAY_BIND(int)
+DEBBY__ARRAY_BIND(long)
+DEBBY__ARRAY_BIND(long long)
+DEBBY__ARRAY_BIND(float)
+DEBBY__ARRAY_BIND(double)
+DEBBY__ARRAY_BIND(std::string)
+
 template <>
 statement_t::result_type statement_t::exec (error * perr)
 {
+    DEBBY__INSTRUMENT(backend_enum::sqlite3, stmt_exec, _d->fingerprint(), 0);
     return _d->exec(false, perr);
 }
 
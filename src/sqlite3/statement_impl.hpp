@@ -1,13 +1,17 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2024-2025 Vladislav Trifochkin
+// Copyright (c) 2024-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2024.10.30 Initial version.
 //      2025.09.30 Changed bind implementation.
+//      2026.10.18 Added SQL fingerprint for instrumentation.
+//                 Added slow-query log.
 ////////////////////////////////////////////////////////////////////////////////
 #include "debby/statement.hpp"
+#include "../instrumentation.hpp"
+#include "../slow_query_log.hpp"
 #include "sqlite3.h"
 
 DEBBY__NAMESPACE_BEGIN
@@ -23,17 +27,27 @@ public:
 private:
     mutable native_type _sth {nullptr};
     bool _cached {false};
+    slow_query_log * _slow_log {nullptr};
+
+#if DEBBY__INSTRUMENTATION_ENABLED
+    std::uint64_t _fingerprint {0};
+#endif
 
 public:
-    impl (native_type sth, bool cached) noexcept
+    impl (native_type sth, bool cached, slow_query_log * slow_log = nullptr) noexcept
         : _sth(sth)
         , _cached(cached)
+        , _slow_log(slow_log)
     {}
 
     impl (impl && other) noexcept
     {
         _sth = other._sth;
         _cached = other._cached;
+        _slow_log = other._slow_log;
+#if DEBBY__INSTRUMENTATION_ENABLED
+        _fingerprint = other._fingerprint;
+#endif
         other._sth = nullptr;
         other._cached = false;
     }
@@ -56,9 +70,25 @@ public:
         return _sth;
     }
 
+#if DEBBY__INSTRUMENTATION_ENABLED
+    std::uint64_t fingerprint ()
+    {
+        if (_fingerprint == 0 && _sth != nullptr)
+            _fingerprint = instrumentation::register_sql(sqlite3_sql(_sth));
+
+        return _fingerprint;
+    }
+#endif
+
     void reset (error * perr);
     statement_t::result_type exec (bool move_handle_ownership, error * perr);
 
+    // Executes statement without slow-query log
+    statement_t::result_type exec_step (bool move_handle_ownership, error * perr);
+
+    // Records statement into slow-query log
+    void log_slow_query (native_type sth, std::chrono::microseconds elapsed);
+
     bool bind_int64 (int index, std::int64_t value, error * perr);
     bool bind_int64 (char const * placeholder, std::int64_t value, error * perr);
     bool bind_double (int index, double value, error * perr);
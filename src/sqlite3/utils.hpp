@@ -1,13 +1,15 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
 // Changelog:
 //      2021.12.07 Initial version.
 //      2024.10.29 V2 started.
+//      2026.10.18 Added `sql_errc()`.
 ////////////////////////////////////////////////////////////////////////////////
 #include "sqlite3.h"
+#include "debby/error.hpp"
 #include "debby/namespace.hpp"
 #include <pfs/fmt.hpp>
 #include <string>
@@ -47,6 +49,17 @@ inline std::string build_errstr (int rc)
     return build_errstr(rc, reinterpret_cast<struct sqlite3 *>(0));
 }
 
+/**
+ * Returns error code for failed SQL execution with result code @a rc (extended result codes
+ * are enabled).
+ */
+inline errc sql_errc (int rc) noexcept
+{
+    // Read transaction can not be upgraded to write one since its snapshot is outdated,
+    // the transaction should be restarted
+    return rc == SQLITE_BUSY_SNAPSHOT ? errc::transaction_conflict : errc::sql_error;
+}
+
 inline std::string current_sql (struct sqlite3_stmt * sth) noexcept
 {
     assert(sth);
@@ -0,0 +1,19 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "../keyvalue_relational_database_impl.hpp"
+#include "../write_executor_impl.hpp"
+#include "relational_database_impl.hpp"
+#include "debby/sqlite3.hpp"
+
+DEBBY__NAMESPACE_BEGIN
+
+template class write_executor<relational_database<backend_enum::sqlite3>>;
+template class write_executor<keyvalue_database<backend_enum::sqlite3>>;
+
+DEBBY__NAMESPACE_END
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "debby/keyvalue_database.hpp"
+#include "debby/relational_database.hpp"
+#include "debby/write_executor.hpp"
+#include "mpsc_queue.hpp"
+#include <pfs/i18n.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+DEBBY__NAMESPACE_BEGIN
+
+template <backend_enum Backend>
+inline relational_database<Backend> & transaction_target (relational_database<Backend> & db)
+{
+    return db;
+}
+
+// Key-value database implementation is relational database (requires complete implementation)
+template <backend_enum Backend>
+inline relational_database<Backend> & transaction_target (keyvalue_database<Backend> & db)
+{
+    return *db.backend_impl();
+}
+
+// Write lock is acquired at the transaction start, so it never needs upgrade
+inline transaction_mode write_transaction_mode (relational_database<backend_enum::sqlite3> const &)
+{
+    return transaction_mode::immediate;
+}
+
+template <backend_enum Backend>
+inline transaction_mode write_transaction_mode (relational_database<Backend> const &)
+{
+    return transaction_mode::standard;
+}
+
+/**
+ * Rolls back transactions (including nested ones) left by operations or failed commit.
+ */
+template <backend_enum Backend>
+inline void reset_transaction (relational_database<Backend> & tx)
+{
+    error ignored;
+    tx.rollback_to(0, & ignored);
+
+    // Transaction started bypassing begin()
+    if (tx.backend_impl()->in_transaction())
+        tx.rollback(& ignored);
+}
+
+template <typename Database>
+class write_executor<Database>::impl
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct task: mpsc_node
+    {
+        operation_type op;
+        std::promise<void> done;
+    };
+
+private:
+    database_type _db;
+    write_executor_options _opts;
+
+    mpsc_queue _queue;
+    std::atomic<std::size_t> _pending {0}; // Pushed but not popped tasks
+    std::atomic<bool> _waiting {false};    // Consumer is waiting (or going to wait) for tasks
+    std::atomic<bool> _stop {false};
+    std::mutex _mtx;
+    std::condition_variable _cv;
+
+    std::atomic<std::uint64_t> _operations {0};
+    std::atomic<std::uint64_t> _failures {0};
+    std::atomic<std::uint64_t> _batches {0};
+
+    std::thread _thread; // Started after other members are initialized
+
+public:
+    impl (database_type && db, write_executor_options const & opts)
+        : _db(std::move(db))
+        , _opts(opts)
+    {
+        if (_opts.max_batch_size == 0)
+            _opts.max_batch_size = 1;
+
+        _thread = std::thread {& impl::run, this};
+    }
+
+    ~impl ()
+    {
+        _stop = true;
+        notify();
+        _thread.join();
+    }
+
+public:
+    std::future<void> submit (operation_type && op)
+    {
+        auto t = new task;
+        t->op = std::move(op);
+        auto result = t->done.get_future();
+
+        _queue.push(t);
+        ++_pending;
+
+        // Sequentially consistent `_pending` and `_waiting` guarantee the consumer either
+        // sees the task or is notified
+        if (_waiting)
+            notify();
+
+        return result;
+    }
+
+    write_executor_stats stats () const noexcept
+    {
+        write_executor_stats result;
+        result.operations = _operations.load();
+        result.failures = _failures.load();
+        result.batches = _batches.load();
+        return result;
+    }
+
+private:
+    void notify ()
+    {
+        std::lock_guard<std::mutex> locker{_mtx};
+        _cv.notify_one();
+    }
+
+    task * pop ()
+    {
+        auto t = static_cast<task *>(_queue.pop());
+
+        if (t != nullptr)
+            --_pending;
+
+        return t;
+    }
+
+    /**
+     * Waits for tasks (until @a deadline if it is not null).
+     *
+     * @return @c false if there are no tasks.
+     */
+    bool wait (clock_type::time_point deadline)
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+        _waiting = true;
+
+        auto ready = [this] { return _pending > 0 || _stop; };
+
+        if (deadline == clock_type::time_point{})
+            _cv.wait(locker, ready);
+        else
+            _cv.wait_until(locker, deadline, ready);
+
+        _waiting = false;
+        return _pending > 0;
+    }
+
+    void run ()
+    {
+        std::vector<task *> batch;
+        batch.reserve(_opts.max_batch_size);
+
+        while (wait(clock_type::time_point{})) {
+            auto deadline = clock_type::now() + _opts.max_delay;
+
+            while (batch.size() < _opts.max_batch_size) {
+                auto t = pop();
+
+                if (t != nullptr) {
+                    batch.push_back(t);
+                    continue;
+                }
+
+                // Producer is linking the task
+                if (_pending > 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (_opts.max_delay.count() <= 0 || _stop || !wait(deadline))
+                    break;
+            }
+
+            perform(batch);
+
+            for (auto t: batch)
+                delete t;
+
+            batch.clear();
+        }
+    }
+
+    /**
+     * Performs @a batch in single transaction. Transaction is rolled back and performed again
+     * without the operation thrown exception. Operation must leave the transaction nesting
+     * level unchanged (nested transactions must be finished).
+     */
+    void perform (std::vector<task *> & batch)
+    {
+        auto & tx = transaction_target(_db);
+        std::vector<bool> failed(batch.size(), false);
+
+        for (;;) {
+            bool op_failed = false;
+            error err;
+
+            // Connection is never expected in transaction here
+            reset_transaction(tx);
+            tx.begin(write_transaction_mode(tx), & err);
+
+            for (std::size_t i = 0; !err && i < batch.size(); i++) {
+                if (failed[i])
+                    continue;
+
+                try {
+                    batch[i]->op(_db);
+
+                    if (tx.transaction_depth() != 1 || !tx.backend_impl()->in_transaction()) {
+                        throw error {
+                              make_error_code(errc::unsupported)
+                            , tr::_("operation left the transaction nesting level changed")
+                        };
+                    }
+                } catch (...) {
+                    // Counters are updated before the waiter is released
+                    ++_operations;
+                    ++_failures;
+                    batch[i]->done.set_exception(std::current_exception());
+                    failed[i] = true;
+                    op_failed = true;
+                    break;
+                }
+            }
+
+            if (!err && !op_failed)
+                tx.commit(& err);
+
+            if (op_failed || err) {
+                reset_transaction(tx);
+
+                if (op_failed)
+                    continue;
+            }
+
+            ++_batches;
+
+            for (std::size_t i = 0; i < batch.size(); i++) {
+                if (failed[i])
+                    continue;
+
+                ++_operations;
+
+                if (err) {
+                    ++_failures;
+                    batch[i]->done.set_exception(std::make_exception_ptr(err));
+                } else {
+                    batch[i]->done.set_value();
+                }
+            }
+
+            return;
+        }
+    }
+};
+
+template <typename Database>
+write_executor<Database>::write_executor (database_type && db, write_executor_options const & opts)
+    : _d(new impl(std::move(db), opts))
+{}
+
+template <typename Database>
+write_executor<Database>::write_executor (write_executor && other) noexcept = default;
+
+template <typename Database>
+write_executor<Database> & write_executor<Database>::operator = (write_executor && other) noexcept = default;
+
+template <typename Database>
+write_executor<Database>::~write_executor () = default;
+
+template <typename Database>
+std::future<void> write_executor<Database>::submit (operation_type op)
+{
+    return _d->submit(std::move(op));
+}
+
+template <typename Database>
+void write_executor<Database>::flush ()
+{
+    // Tasks are completed in order of submission
+    submit([] (database_type &) {}).wait();
+}
+
+template <typename Database>
+write_executor_stats write_executor<Database>::stats () const noexcept
+{
+    return _d == nullptr ? write_executor_stats{} : _d->stats();
+}
+
+DEBBY__NAMESPACE_END
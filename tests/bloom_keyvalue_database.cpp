@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/debby/bloom_filter.hpp"
+#include "pfs/debby/bloom_keyvalue_database.hpp"
+#include "pfs/debby/keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <string>
+
+#if DEBBY__MAP_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+#   include "pfs/debby/sqlite3.hpp"
+#endif
+
+namespace fs = pfs::filesystem;
+
+TEST_CASE("bloom filter") {
+    debby::bloom_filter filter {10000};
+
+    CHECK_EQ(filter.block_count(), 10000 * 10 / 256 + 1);
+
+    for (int i = 0; i < 10000; i++)
+        filter.insert("key/" + std::to_string(i));
+
+    // No false negatives
+    for (int i = 0; i < 10000; i++)
+        REQUIRE(filter.may_contain("key/" + std::to_string(i)));
+
+    int false_positives = 0;
+
+    for (int i = 0; i < 100000; i++) {
+        if (filter.may_contain("absent/" + std::to_string(i)))
+            false_positives++;
+    }
+
+    // About 1% with 10 bits per key
+    CHECK_LT(false_positives, 3000);
+    CHECK_LT(filter.estimated_false_positive_rate(), 0.03);
+
+    auto path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-bloom.filter");
+    REQUIRE(filter.save(path));
+
+    auto loaded = debby::bloom_filter::load(path);
+    CHECK_EQ(loaded.block_count(), filter.block_count());
+    CHECK_EQ(loaded.count(), 10000);
+
+    for (int i = 0; i < 10000; i++)
+        REQUIRE(loaded.may_contain("key/" + std::to_string(i)));
+
+    fs::remove(path);
+
+    debby::error err;
+    debby::bloom_filter::load(path, & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::database_not_found));
+
+    filter.clear();
+    CHECK_FALSE(filter.may_contain("key/0"));
+}
+
+template <debby::backend_enum Backend>
+void check (debby::keyvalue_database<Backend> && database, fs::path const & filter_path)
+{
+    using bloom_t = debby::bloom_keyvalue_database<Backend>;
+
+    debby::bloom_options opts;
+    opts.expected_keys = 1000;
+    opts.path = filter_path;
+
+    fs::remove(filter_path);
+
+    {
+        auto db = bloom_t::make(std::move(database), opts);
+        REQUIRE(db);
+
+        for (int i = 0; i < 1000; i++)
+            db.set("key/" + std::to_string(i), i);
+
+        db.set("str", "hello");
+
+        CHECK_EQ(db.template get<int>("key/42"), 42);
+        CHECK_EQ(db.template get<std::string>("str"), "hello");
+
+        for (int i = 0; i < 10000; i++)
+            CHECK_EQ(db.template get_or<int>("absent/" + std::to_string(i), -1), -1);
+
+        auto stats = db.stats();
+        CHECK_EQ(stats.lookups, 10002);
+        CHECK_EQ(stats.negatives + stats.false_positives, 10000);
+        CHECK_GT(stats.negatives, 9500);
+        CHECK_LT(stats.false_positive_rate(), 0.05);
+
+        // Removed key stays in the filter
+        db.remove("key/0");
+        CHECK_EQ(db.template get_or<int>("key/0", -1), -1);
+        CHECK_EQ(db.stats().false_positives, stats.false_positives + 1);
+
+        debby::error err;
+        db.template get<int>("absent", & err);
+        CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+
+        // The filter is saved on destruction
+    }
+
+    REQUIRE(fs::exists(filter_path));
+}
+
+#if DEBBY__MAP_ENABLED
+TEST_CASE("bloom over in-memory map") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::map_st>;
+    auto filter_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-bloom-map.filter");
+
+    check(database_t::make(), filter_path);
+    fs::remove(filter_path);
+
+    // Rebuilt by the key scan
+    auto database = database_t::make();
+    database.set("a", 1);
+    database.set("b", 2);
+
+    auto db = debby::bloom_keyvalue_database<debby::backend_enum::map_st>::make(std::move(database));
+    CHECK_EQ(db.filter().count(), 2);
+    CHECK_EQ(db.get<int>("a"), 1);
+    CHECK_EQ(db.get<int>("b"), 2);
+
+    db.clear();
+    CHECK_EQ(db.get_or<int>("a", -1), -1);
+    CHECK_EQ(db.stats().negatives, 1);
+}
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+TEST_CASE("bloom over sqlite3") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::sqlite3>;
+    using bloom_t = debby::bloom_keyvalue_database<debby::backend_enum::sqlite3>;
+
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-bloom-kv.db");
+    auto filter_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-bloom-kv.filter");
+    debby::sqlite3::wipe(db_path);
+
+    check(database_t::make(db_path, "test-kv", true), filter_path);
+
+    debby::bloom_options opts;
+    opts.path = filter_path;
+
+    {
+        // Loaded from the file, which is removed until saved again
+        auto db = bloom_t::make(database_t::make(db_path, "test-kv", true), opts);
+        CHECK_FALSE(fs::exists(filter_path));
+        CHECK_EQ(db.filter().count(), 1001);
+        CHECK_EQ(db.get<int>("key/999"), 999);
+        CHECK_EQ(db.get<std::string>("str"), "hello");
+
+        REQUIRE(db.save());
+        CHECK(fs::exists(filter_path));
+
+        // Write invalidates saved filter
+        db.set("new", 1);
+        CHECK_FALSE(fs::exists(filter_path));
+    }
+
+    {
+        auto db = bloom_t::make(database_t::make(db_path, "test-kv", true), opts);
+        CHECK_EQ(db.get<int>("new"), 1);
+
+        // Sized for actual number of keys
+        REQUIRE(db.rebuild());
+        CHECK_EQ(db.filter().count(), 1001);
+    }
+
+    fs::remove(filter_path);
+    debby::sqlite3::wipe(db_path);
+}
+#endif
@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/debby/instrumentation.hpp"
+#include "pfs/debby/keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#if DEBBY__MAP_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+#   include "pfs/debby/sqlite3.hpp"
+#endif
+
+namespace fs = pfs::filesystem;
+namespace instrumentation = debby::instrumentation;
+
+namespace {
+
+instrumentation::metric const * find_metric (std::vector<instrumentation::metric> const & metrics
+    , debby::backend_enum backend, instrumentation::operation_enum op)
+{
+    auto pos = std::find_if(metrics.begin(), metrics.end(), [&] (instrumentation::metric const & m) {
+        return m.backend == backend && m.operation == op;
+    });
+
+    return pos == metrics.end() ? nullptr : & *pos;
+}
+
+} // namespace
+
+TEST_CASE("histogram buckets") {
+    using histogram = instrumentation::histogram;
+
+    for (std::uint64_t v = 0; v < 8; v++) {
+        CHECK_EQ(histogram::bucket_index(v), v);
+        CHECK_EQ(histogram::bucket_upper_bound(histogram::bucket_index(v)), v);
+    }
+
+    CHECK_EQ(histogram::bucket_index(8), 8);
+    CHECK_EQ(histogram::bucket_index(15), 15);
+    CHECK_EQ(histogram::bucket_index(16), 16);
+    CHECK_EQ(histogram::bucket_index(17), 16);
+    CHECK_EQ(histogram::bucket_upper_bound(16), 17);
+    CHECK_EQ(histogram::bucket_index((std::numeric_limits<std::uint64_t>::max)()), histogram::BUCKET_COUNT - 1);
+    CHECK_EQ(histogram::bucket_upper_bound(histogram::BUCKET_COUNT - 1), (std::numeric_limits<std::uint64_t>::max)());
+
+    // Relative error is less than 12.5%
+    for (std::uint64_t v: {100ULL, 1000ULL, 12345ULL, 1000000ULL, 987654321ULL}) {
+        auto upper = histogram::bucket_upper_bound(histogram::bucket_index(v));
+        CHECK_GE(upper, v);
+        CHECK_LT(static_cast<double>(upper - v) / v, 0.125);
+    }
+
+    histogram h;
+
+    for (std::uint64_t v = 1; v <= 100; v++) {
+        h.buckets[histogram::bucket_index(v)]++;
+        h.count++;
+        h.sum += v;
+    }
+
+    CHECK_EQ(h.percentile(0.0), 1);
+    CHECK_EQ(h.percentile(0.5), 51);
+    CHECK_EQ(h.max(), 103);
+    CHECK_EQ(h.mean(), doctest::Approx(50.5));
+}
+
+TEST_CASE("SQL fingerprint") {
+    CHECK_EQ(instrumentation::normalize_sql("SELECT  value\n FROM \"Test\" WHERE key='abc' AND n = 42 -- comment")
+        , std::string{"select value from \"Test\" where key=? and n = ?"});
+    CHECK_EQ(instrumentation::normalize_sql("DELETE FROM t1 WHERE key IN (?,?, ?)")
+        , std::string{"delete from t1 where key in (?)"});
+    CHECK_EQ(instrumentation::normalize_sql("INSERT INTO t (a, b) VALUES ($1, $2)")
+        , std::string{"insert into t (a, b) values (?)"});
+
+    CHECK_EQ(instrumentation::fingerprint("SELECT * FROM t WHERE id = 1")
+        , instrumentation::fingerprint("select *  from t where id = 25"));
+    CHECK_NE(instrumentation::fingerprint("SELECT * FROM t WHERE id = 1")
+        , instrumentation::fingerprint("SELECT * FROM t2 WHERE id = 1"));
+}
+
+#if DEBBY__MAP_ENABLED
+TEST_CASE("key-value metrics") {
+    if (!instrumentation::enabled()) {
+        MESSAGE("Instrumentation is disabled, test skipped");
+        return;
+    }
+
+    instrumentation::reset();
+    REQUIRE(instrumentation::snapshot().empty());
+
+    auto db = debby::keyvalue_database<debby::backend_enum::map_st>::make();
+
+    db.set("text", std::string{"Hello"});
+    db.set("int", 42);
+    CHECK_EQ(db.get<std::string>("text"), std::string{"Hello"});
+    db.remove("int");
+
+    // Operations from another thread are kept after thread finished
+    std::thread t {[] {
+        auto db = debby::keyvalue_database<debby::backend_enum::map_mt>::make();
+        db.set("text", std::string{"World"});
+    }};
+
+    t.join();
+
+    auto metrics = instrumentation::snapshot();
+
+    auto set_metric = find_metric(metrics, debby::backend_enum::map_st, instrumentation::operation_enum::kv_set);
+    REQUIRE(set_metric != nullptr);
+    CHECK_EQ(set_metric->latency.count, 2);
+    CHECK_EQ(set_metric->bytes, 5 + sizeof(int));
+    CHECK_EQ(set_metric->fingerprint, 0);
+
+    auto get_metric = find_metric(metrics, debby::backend_enum::map_st, instrumentation::operation_enum::kv_get);
+    REQUIRE(get_metric != nullptr);
+    CHECK_EQ(get_metric->latency.count, 1);
+    CHECK_EQ(get_metric->bytes, 5);
+
+    auto remove_metric = find_metric(metrics, debby::backend_enum::map_st, instrumentation::operation_enum::kv_remove);
+    REQUIRE(remove_metric != nullptr);
+    CHECK_EQ(remove_metric->latency.count, 1);
+
+    auto mt_metric = find_metric(metrics, debby::backend_enum::map_mt, instrumentation::operation_enum::kv_set);
+    REQUIRE(mt_metric != nullptr);
+    CHECK_EQ(mt_metric->latency.count, 1);
+
+    auto text = instrumentation::to_prometheus(metrics);
+    CHECK(text.find("debby_operation_duration_seconds_count{backend=\"map_st\",operation=\"kv_set\"") != std::string::npos);
+
+    instrumentation::reset();
+    CHECK(instrumentation::snapshot().empty());
+}
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+TEST_CASE("statement metrics") {
+    if (!instrumentation::enabled()) {
+        MESSAGE("Instrumentation is disabled, test skipped");
+        return;
+    }
+
+    auto db_path = fs::temp_directory_path() / "debby-instrumentation.db";
+    debby::sqlite3::wipe(db_path);
+
+    {
+        auto db = debby::sqlite3::make(db_path, true);
+        db.query("CREATE TABLE test (id INTEGER)");
+
+        instrumentation::reset();
+
+        auto stmt = db.prepare("INSERT INTO test (id) VALUES (?)");
+
+        for (int i = 0; i < 3; i++) {
+            stmt.reset();
+            stmt.bind(1, i);
+            stmt.exec();
+        }
+
+        auto select_stmt = db.prepare("SELECT id FROM test");
+        auto res = select_stmt.exec();
+
+        while (res.has_more())
+            res.next();
+
+        auto metrics = instrumentation::snapshot();
+        auto insert_fp = instrumentation::fingerprint("INSERT INTO test (id) VALUES (?)");
+        auto select_fp = instrumentation::fingerprint("SELECT id FROM test");
+
+        auto insert_metric = std::find_if(metrics.begin(), metrics.end(), [&] (instrumentation::metric const & m) {
+            return m.operation == instrumentation::operation_enum::stmt_exec && m.fingerprint == insert_fp;
+        });
+
+        REQUIRE(insert_metric != metrics.end());
+        CHECK_EQ(insert_metric->backend, debby::backend_enum::sqlite3);
+        CHECK_EQ(insert_metric->latency.count, 3);
+        CHECK_EQ(insert_metric->sql, std::string{"insert into test (id) values (?)"});
+
+        auto next_metric = std::find_if(metrics.begin(), metrics.end(), [&] (instrumentation::metric const & m) {
+            return m.operation == instrumentation::operation_enum::result_next && m.fingerprint == select_fp;
+        });
+
+        REQUIRE(next_metric != metrics.end());
+        CHECK_EQ(next_metric->latency.count, 3);
+    }
+
+    debby::sqlite3::wipe(db_path);
+}
+#endif
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2025 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -7,10 +7,34 @@
 //      2021.12.07 Initial version.
 //      2022.03.12 Refactored.
 //      2025.09.29 Added tests for blob, universal_id, utc_time, local_time.
+//      2026.10.18 Added test for sqlite3 rowid layout.
+//                 Added test for `remove_many()`.
+//                 Added tests for `flat_hash_map` backend.
+//                 Added tests for `radix_tree` backend and `for_each_key()`.
+//                 Added tests for arena allocated in-memory backends.
+//                 Added tests for in-memory snapshots.
+//                 Added tests for `lru_cache` backend.
+//                 Added test for RocksDB read options and `multi_get()`.
+//                 Added tests for `increment()` and `append()`.
+//                 Added test for RocksDB bulk loader.
+//                 Added test for RocksDB statistics, properties and perf context.
+//                 Added tests for LMDB/MDBX group commit.
+//                 Added test for `write_batch()`.
+//                 Added per-backend `write_batch()` tests (commit, discard, nesting).
+//                 Added test for RocksDB `checked_increment()`.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include "pfs/debby/keyvalue_database.hpp"
 #include "pfs/debby/settings.hpp"
 #include <pfs/filesystem.hpp>
@@ -23,6 +47,18 @@
 #   include "pfs/debby/in_memory.hpp"
 #endif
 
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
 #if DEBBY__SQLITE3_ENABLED
 #   include "pfs/debby/sqlite3.hpp"
 #endif
@@ -49,6 +85,17 @@
 
 namespace fs = pfs::filesystem;
 
+// Backends visiting keys in byte-wise order by `for_each_key()`
+constexpr bool is_ordered (debby::backend_enum backend)
+{
+    return backend != debby::backend_enum::unordered_map_st
+        && backend != debby::backend_enum::unordered_map_mt
+        && backend != debby::backend_enum::flat_hash_map_st
+        && backend != debby::backend_enum::flat_hash_map_mt
+        && backend != debby::backend_enum::lru_cache_st
+        && backend != debby::backend_enum::lru_cache_mt;
+}
+
 template <debby::backend_enum Backend>
 void check_keyvalue_database (debby::keyvalue_database<Backend> & db)
 {
@@ -116,6 +163,196 @@ void check_keyvalue_database (debby::keyvalue_database<Backend> & db)
 
         db.remove("text");
         REQUIRE(db.template get_or<std::string>("text", "").empty());
+
+        std::vector<std::string> keys;
+
+        for (int i = 0; i < 600; i++) {
+            keys.push_back("key." + std::to_string(i));
+            db.set(keys.back(), i);
+        }
+
+        db.set("key.\"quoted\\", 42);
+        keys.push_back("key.\"quoted\\");
+        keys.push_back("key.missing");
+
+        db.remove_many(keys);
+        db.remove_many(std::vector<std::string>{});
+
+        REQUIRE_EQ(db.template get_or<int>("key.0", -1), -1);
+        REQUIRE_EQ(db.template get_or<int>("key.599", -1), -1);
+        REQUIRE_EQ(db.template get_or<int>("key.\"quoted\\", -1), -1);
+        REQUIRE_EQ(db.template get<int>("int"), -42);
+
+        // Prefix iteration
+        db.set("tenant/b/feature/x", 4);
+        db.set("tenant/a/feature/y", 2);
+        db.set("tenant/a/feature/x", 1);
+        db.set("tenant/a", 3);
+        db.set("tenant", 5);
+
+        std::vector<std::string> visited;
+        auto collect = [& visited] (std::string const & key) {
+            visited.push_back(key);
+            return true;
+        };
+
+        db.for_each_key("tenant/a", collect);
+
+        if (!is_ordered(Backend))
+            std::sort(visited.begin(), visited.end());
+
+        REQUIRE_EQ(visited, std::vector<std::string>{"tenant/a", "tenant/a/feature/x", "tenant/a/feature/y"});
+
+        visited.clear();
+        db.for_each_key("tenant/c", collect);
+        REQUIRE(visited.empty());
+
+        visited.clear();
+        db.for_each_key("", collect);
+        REQUIRE(std::count(visited.begin(), visited.end(), std::string{"tenant/b/feature/x"}) == 1);
+
+        if (is_ordered(Backend))
+            REQUIRE(std::is_sorted(visited.begin(), visited.end()));
+
+        // Stop iteration
+        visited.clear();
+        db.for_each_key("tenant", [& visited] (std::string const & key) {
+            visited.push_back(key);
+            return visited.size() < 2;
+        });
+
+        REQUIRE_EQ(visited.size(), 2);
+
+        if (is_ordered(Backend))
+            REQUIRE_EQ(visited, std::vector<std::string>{"tenant", "tenant/a"});
+
+        // Atomic updates
+        db.remove("counter");
+        db.increment("counter");
+        db.increment("counter", 41);
+        REQUIRE_EQ(db.template get<std::int64_t>("counter"), 42);
+
+        db.increment("counter", -50);
+        REQUIRE_EQ(db.template get<std::int64_t>("counter"), -8);
+
+        db.set("counter", std::int64_t{100});
+        db.increment("counter", std::numeric_limits<std::int64_t>::max());
+        REQUIRE_EQ(db.template get<std::int64_t>("counter"), std::numeric_limits<std::int64_t>::min() + 99);
+
+        // `long long` counter (`std::int64_t` may be `long`)
+        db.set("counter", 100LL);
+        db.increment("counter");
+        REQUIRE_EQ(db.template get<long long>("counter"), 101LL);
+
+        db.remove("log");
+        db.append("log", "Hello");
+        db.append("log", std::string{", World"});
+        db.append("log", "!", 1);
+        REQUIRE_EQ(db.template get<std::string>("log"), std::string{"Hello, World!"});
+
+        // RocksDB increment is blind merge (see `rocksdb::checked_increment()`)
+        if (Backend != debby::backend_enum::rocksdb) {
+            debby::error err;
+            db.increment("log", 1, & err);
+            REQUIRE_EQ(err.code(), make_error_code(debby::errc::bad_value));
+            REQUIRE_EQ(db.template get<std::string>("log"), std::string{"Hello, World!"});
+        }
+    } catch (debby::error ex) {
+        REQUIRE_MESSAGE(false, ex.what());
+    }
+}
+
+template <debby::backend_enum Backend>
+void check_write_batch (debby::keyvalue_database<Backend> & db)
+{
+    bool relational = Backend == debby::backend_enum::sqlite3 || Backend == debby::backend_enum::psql;
+
+    // In-memory backends apply writes immediately
+    bool persistent = relational || Backend == debby::backend_enum::lmdb
+        || Backend == debby::backend_enum::mdbx || Backend == debby::backend_enum::rocksdb;
+
+    try {
+        db.remove_many({"batch/1", "batch/2", "batch/3", "batch/4", "batch/counter"});
+
+        // Commit
+        int visible = -1;
+
+        db.write_batch([& db, & visible] {
+            db.set("batch/1", 1);
+            db.set("batch/2", 2);
+            db.increment("batch/counter");
+            db.remove("batch/2");
+            visible = db.template get_or<int>("batch/1", -1);
+        });
+
+        REQUIRE_EQ(db.template get<int>("batch/1"), 1);
+        REQUIRE_EQ(db.template get_or<int>("batch/2", -1), -1);
+        REQUIRE_EQ(db.template get<std::int64_t>("batch/counter"), 1);
+
+        // RocksDB collects writes into `WriteBatch`, reads inside the batch do not see them
+        if (Backend == debby::backend_enum::rocksdb)
+            CHECK_EQ(visible, -1);
+        else
+            CHECK_EQ(visible, 1);
+
+        // Discard on throw
+        if (persistent) {
+            REQUIRE_THROWS_AS(db.write_batch([& db] {
+                db.set("batch/1", 10);
+                db.set("batch/3", 3);
+                db.increment("batch/counter");
+                throw std::runtime_error{"failure"};
+            }), std::runtime_error);
+
+            REQUIRE_EQ(db.template get<int>("batch/1"), 1);
+            REQUIRE_EQ(db.template get_or<int>("batch/3", -1), -1);
+            REQUIRE_EQ(db.template get<std::int64_t>("batch/counter"), 1);
+        }
+
+        // Nested call is part of the outer batch
+        db.write_batch([& db] {
+            db.set("batch/3", 3);
+
+            db.write_batch([& db] {
+                db.set("batch/4", 4);
+            });
+        });
+
+        REQUIRE_EQ(db.template get<int>("batch/3"), 3);
+        REQUIRE_EQ(db.template get<int>("batch/4"), 4);
+
+        if (persistent) {
+            REQUIRE_THROWS_AS(db.write_batch([& db] {
+                db.set("batch/3", 30);
+
+                db.write_batch([& db] {
+                    db.set("batch/4", 40);
+                });
+
+                throw std::runtime_error{"failure"};
+            }), std::runtime_error);
+
+            REQUIRE_EQ(db.template get<int>("batch/3"), 3);
+            REQUIRE_EQ(db.template get<int>("batch/4"), 4);
+        }
+
+        // Nested call inside relational transaction is nested transaction (savepoint)
+        // discarded alone
+        if (relational) {
+            db.write_batch([& db] {
+                db.set("batch/3", 30);
+
+                CHECK_THROWS_AS(db.write_batch([& db] {
+                    db.set("batch/4", 40);
+                    throw std::runtime_error{"failure"};
+                }), std::runtime_error);
+            });
+
+            REQUIRE_EQ(db.template get<int>("batch/3"), 30);
+            REQUIRE_EQ(db.template get<int>("batch/4"), 4);
+        }
+
+        db.remove_many({"batch/1", "batch/2", "batch/3", "batch/4", "batch/counter"});
     } catch (debby::error ex) {
         REQUIRE_MESSAGE(false, ex.what());
     }
@@ -181,12 +418,75 @@ void check (debby::keyvalue_database<Backend> && db)
     {
         db.clear();
         check_keyvalue_database(db);
+        check_write_batch(db);
 
         settings_t settings {std::move(db)};
         check_settings(settings);
     }
 }
 
+#if DEBBY__FLAT_HASH_MAP_ENABLED || DEBBY__RADIX_TREE_ENABLED
+template <debby::backend_enum Backend>
+void check_compact_backend ()
+{
+    auto db = debby::keyvalue_database<Backend>::make();
+
+    int const count = 20000;
+
+    // Mix of inline (short) and heap allocated (long) keys and values
+    auto make_key = [] (int i) {
+        return (i % 3 == 0 ? std::string{"long-key-prefix-"} : std::string{"k"}) + std::to_string(i);
+    };
+
+    for (int i = 0; i < count; i++) {
+        if (i % 2 == 0)
+            db.set(make_key(i), i);
+        else
+            db.set(make_key(i), std::string(static_cast<std::size_t>(i % 40), 'x'));
+    }
+
+    for (int i = 0; i < count; i += 4)
+        db.remove(make_key(i));
+
+    // Reinsert removed keys with other type to reuse deleted slots
+    for (int i = 0; i < count; i += 8)
+        db.set(make_key(i), static_cast<long long int>(i));
+
+    for (int i = 0; i < count; i++) {
+        debby::error err;
+
+        if (i % 8 == 0) {
+            CHECK_EQ(db.template get<long long int>(make_key(i)), static_cast<long long int>(i));
+            CHECK_EQ(db.template get<int>(make_key(i), & err), 0);
+            CHECK_EQ(err.code(), make_error_code(debby::errc::bad_value));
+        } else if (i % 4 == 0) {
+            CHECK_EQ(db.template get<int>(make_key(i), & err), 0);
+            CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+        } else if (i % 2 == 0) {
+            CHECK_EQ(db.template get<int>(make_key(i)), i);
+        } else {
+            CHECK_EQ(db.template get<std::string>(make_key(i)), std::string(static_cast<std::size_t>(i % 40), 'x'));
+        }
+    }
+
+    // Repeated insert/remove cycles must not exhaust the table with tombstones
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < count; i++)
+            db.set("tmp" + std::to_string(round * count + i), true);
+
+        for (int i = 0; i < count; i++)
+            db.remove("tmp" + std::to_string(round * count + i));
+    }
+
+    CHECK_EQ(db.template get<int>(make_key(2)), 2);
+
+    db.clear();
+    debby::error err;
+    CHECK_EQ(db.template get<int>(make_key(2), & err), 0);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+}
+#endif
+
 #if DEBBY__MAP_ENABLED
 TEST_CASE("in-memory thread unsafe map set/get") {
     using database_t = debby::keyvalue_database<debby::backend_enum::map_st>;
@@ -199,6 +499,49 @@ TEST_CASE("in-memory thread safe map set/get") {
     auto db = database_t::make();
     check(std::move(db));
 }
+
+TEST_CASE("in-memory arena allocated map set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::map_st>;
+    auto db = database_t::make(debby::in_memory::arena_options{});
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory arena allocated map rebuild") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::map_mt>;
+    debby::in_memory::arena_options opts;
+    opts.block_size = 1024;
+    auto db = database_t::make(opts);
+
+    // Rebuild cache several times: `clear()` drops all elements at once
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 1000; i++) {
+            auto key = "cache/" + std::to_string(round) + "/" + std::to_string(i);
+            db.set(key, i);
+            db.set(key + "/s", std::string(i % 100, 'x'));
+            db.set(key + "/big", std::string(1000, 'y'));
+        }
+
+        for (int i = 0; i < 1000; i += 3)
+            db.remove("cache/" + std::to_string(round) + "/" + std::to_string(i));
+
+        CHECK_EQ(db.get<int>("cache/" + std::to_string(round) + "/1"), 1);
+        CHECK_EQ(db.get<std::string>("cache/" + std::to_string(round) + "/99/s"), std::string(99, 'x'));
+        CHECK_EQ(db.get<std::string>("cache/" + std::to_string(round) + "/0/big"), std::string(1000, 'y'));
+
+        int count = 0;
+
+        db.for_each_key("cache/", [& count] (std::string const &) {
+            count++;
+            return true;
+        });
+
+        CHECK_EQ(count, 3000 - 334);
+
+        db.clear();
+
+        REQUIRE_THROWS(db.get<int>("cache/" + std::to_string(round) + "/1"));
+    }
+}
 #endif
 
 #if DEBBY__UNORDERED_MAP_ENABLED
@@ -213,6 +556,284 @@ TEST_CASE("in-memory thread safe unordered_map set/get") {
     auto db = database_t::make();
     check(std::move(db));
 }
+
+TEST_CASE("in-memory arena allocated unordered_map set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::unordered_map_mt>;
+    auto db = database_t::make(debby::in_memory::arena_options{});
+    check(std::move(db));
+}
+#endif
+
+#if DEBBY__MAP_ENABLED || DEBBY__UNORDERED_MAP_ENABLED
+template <debby::backend_enum Backend>
+void check_snapshot (debby::keyvalue_database<Backend> && db)
+{
+    auto path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-kv.snapshot");
+
+    db.set("bool", true);
+    db.set("char", 'c');
+    db.set("short", static_cast<short>(-12345));
+    db.set("ulong", std::numeric_limits<unsigned long>::max());
+    db.set("float", 3.14f);
+    db.set("double", 2.718281828);
+    db.set("empty", std::string{});
+    db.set("large", std::string(200 * 1024, 'L')); // Crosses checksum chunks
+
+    for (int i = 0; i < 10000; i++)
+        db.set("key/" + std::to_string(i), "value/" + std::to_string(i));
+
+    REQUIRE(debby::in_memory::save(db, path));
+
+    auto db1 = debby::in_memory::load<Backend>(path);
+    REQUIRE(db1);
+
+    CHECK_EQ(db1.template get<bool>("bool"), true);
+    CHECK_EQ(db1.template get<char>("char"), 'c');
+    CHECK_EQ(db1.template get<short>("short"), -12345);
+    CHECK_EQ(db1.template get<unsigned long>("ulong"), std::numeric_limits<unsigned long>::max());
+    CHECK_EQ(db1.template get<float>("float"), 3.14f);
+    CHECK_EQ(db1.template get<double>("double"), 2.718281828);
+    CHECK_EQ(db1.template get<std::string>("empty"), std::string{});
+    CHECK_EQ(db1.template get<std::string>("large"), std::string(200 * 1024, 'L'));
+
+    for (int i = 0; i < 10000; i += 7)
+        CHECK_EQ(db1.template get<std::string>("key/" + std::to_string(i)), "value/" + std::to_string(i));
+
+    int count = 0;
+
+    db1.for_each_key("", [& count] (std::string const &) {
+        count++;
+        return true;
+    });
+
+    CHECK_EQ(count, 10008);
+
+    auto db2 = debby::in_memory::load<Backend>(path, debby::in_memory::arena_options{});
+    REQUIRE(db2);
+    CHECK_EQ(db2.template get<std::string>("key/9999"), "value/9999");
+
+    // Corrupt payload
+    {
+        std::fstream f(pfs::utf8_encode_path(path), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(100 * 1024);
+        f.put('X');
+    }
+
+    debby::error err;
+    auto db3 = debby::in_memory::load<Backend>(path, & err);
+    CHECK_FALSE(db3);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::bad_value));
+
+    fs::remove(path);
+
+    err = debby::error{};
+    auto db4 = debby::in_memory::load<Backend>(path, & err);
+    CHECK_FALSE(db4);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::database_not_found));
+}
+#endif
+
+#if DEBBY__MAP_ENABLED
+TEST_CASE("in-memory map snapshot") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::map_st>;
+    check_snapshot(database_t::make());
+}
+#endif
+
+#if DEBBY__UNORDERED_MAP_ENABLED
+TEST_CASE("in-memory unordered_map snapshot") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::unordered_map_mt>;
+    check_snapshot(database_t::make(debby::in_memory::arena_options{}));
+}
+#endif
+
+#if DEBBY__FLAT_HASH_MAP_ENABLED
+TEST_CASE("in-memory thread unsafe flat_hash_map set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::flat_hash_map_st>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory thread safe flat_hash_map set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::flat_hash_map_mt>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory flat_hash_map growth and tombstones") {
+    check_compact_backend<debby::backend_enum::flat_hash_map_st>();
+}
+#endif
+
+#if DEBBY__RADIX_TREE_ENABLED
+TEST_CASE("in-memory thread unsafe radix_tree set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::radix_tree_st>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory thread safe radix_tree set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::radix_tree_mt>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory radix_tree node growth and removal") {
+    check_compact_backend<debby::backend_enum::radix_tree_st>();
+}
+
+TEST_CASE("in-memory radix_tree ordered iteration") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::radix_tree_st>;
+    auto db = database_t::make();
+    std::map<std::string, int> expected;
+
+    // Keys with long common prefixes, keys being prefixes of other keys and
+    // all byte values at the same position (node growth up to 256 children)
+    for (int t = 0; t < 20; t++) {
+        expected["tenant/" + std::to_string(t)] = t;
+
+        for (int f = 0; f < 60; f++)
+            expected["tenant/" + std::to_string(t) + "/feature/" + std::to_string(f)] = t * 100 + f;
+    }
+
+    for (int c = 0; c < 256; c++)
+        expected[std::string{"bytes/"} + static_cast<char>(c)] = c;
+
+    expected[""] = -1;
+
+    for (auto const & item: expected)
+        db.set(item.first, item.second);
+
+    auto check_prefix = [& db, & expected] (std::string const & prefix) {
+        std::vector<std::string> visited;
+
+        db.for_each_key(prefix, [& visited] (std::string const & key) {
+            visited.push_back(key);
+            return true;
+        });
+
+        std::vector<std::string> keys;
+
+        for (auto const & item: expected) {
+            if (item.first.compare(0, prefix.size(), prefix) == 0)
+                keys.push_back(item.first);
+        }
+
+        CHECK_EQ(visited, keys);
+    };
+
+    check_prefix("");
+    check_prefix("tenant/1");
+    check_prefix("tenant/1/");
+    check_prefix("tenant/19/feature/5");
+    check_prefix("bytes/");
+    check_prefix("tenant/x");
+
+    // Remove most of keys to shrink and collapse nodes
+    for (auto pos = expected.begin(); pos != expected.end(); ) {
+        if (pos->second % 7 != 0) {
+            db.remove(pos->first);
+            pos = expected.erase(pos);
+        } else {
+            ++pos;
+        }
+    }
+
+    check_prefix("");
+    check_prefix("tenant/1");
+    check_prefix("bytes/");
+
+    for (auto const & item: expected)
+        CHECK_EQ(db.get<int>(item.first), item.second);
+}
+#endif
+
+#if DEBBY__LRU_CACHE_ENABLED
+TEST_CASE("in-memory thread unsafe lru_cache set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::lru_cache_st>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory thread safe lru_cache set/get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::lru_cache_mt>;
+    auto db = database_t::make();
+    check(std::move(db));
+}
+
+TEST_CASE("in-memory lru_cache eviction") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::lru_cache_st>;
+    debby::in_memory::cache_options opts;
+    opts.capacity = 64 * 1024;
+    auto db = database_t::make(opts);
+
+    // Hot keys accessed again become protected
+    for (int i = 0; i < 10; i++)
+        db.set("hot/" + std::to_string(i), std::string(100, 'h'));
+
+    for (int i = 0; i < 10; i++)
+        CHECK_EQ(db.get<std::string>("hot/" + std::to_string(i)), std::string(100, 'h'));
+
+    // Scan through many more keys than the cache can hold
+    for (int i = 0; i < 5000; i++)
+        db.set("scan/" + std::to_string(i), std::string(100, 's'));
+
+    auto st = debby::in_memory::stats(db);
+    CHECK_LE(st.bytes, opts.capacity);
+    CHECK_GT(st.evictions, 0);
+    CHECK_EQ(st.hits, 10);
+    CHECK_EQ(st.misses, 0);
+
+    // Hot keys survived the scan, the oldest scanned ones are evicted
+    for (int i = 0; i < 10; i++)
+        CHECK_EQ(db.get<std::string>("hot/" + std::to_string(i)), std::string(100, 'h'));
+
+    CHECK_EQ(db.get<std::string>("scan/4999"), std::string(100, 's'));
+
+    debby::error err;
+    db.get<std::string>("scan/0", & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+
+    st = debby::in_memory::stats(db);
+    CHECK_EQ(st.hits, 21);
+    CHECK_EQ(st.misses, 1);
+
+    // Entry exceeding capacity is not stored
+    db.set("huge", std::string(opts.capacity, 'x'));
+    CHECK_EQ(db.get_or<std::string>("huge", std::string{}), std::string{});
+
+    db.clear();
+    st = debby::in_memory::stats(db);
+    CHECK_EQ(st.count, 0);
+    CHECK_EQ(st.bytes, 0);
+}
+
+TEST_CASE("in-memory lru_cache time to live") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::lru_cache_mt>;
+    debby::in_memory::cache_options opts;
+    opts.default_ttl = std::chrono::milliseconds{50};
+    auto db = database_t::make(opts);
+
+    db.set("a", 1);
+    db.set("b", 2);
+    db.set("c", 3);
+
+    CHECK(debby::in_memory::expire(db, "b", std::chrono::milliseconds{0}));
+    CHECK(debby::in_memory::expire(db, "c", std::chrono::milliseconds{60 * 1000}));
+    CHECK_FALSE(debby::in_memory::expire(db, "d", std::chrono::milliseconds{0}));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    debby::error err;
+    db.get<int>("a", & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+    CHECK_EQ(db.get<int>("b"), 2);
+    CHECK_EQ(db.get<int>("c"), 3);
+
+    auto st = debby::in_memory::stats(db);
+    CHECK_EQ(st.expirations, 1);
+    CHECK_EQ(st.count, 2);
+}
 #endif
 
 #if DEBBY__LMDB_ENABLED
@@ -225,6 +846,71 @@ TEST_CASE("lmdb set/get") {
 }
 #endif
 
+template <typename Database>
+void check_group_commit (Database & db)
+{
+    db.clear();
+
+    std::vector<std::thread> writers;
+
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([& db, t] {
+            for (int i = t; i < 1000; i += 4) {
+                auto key = "key/" + std::to_string(i);
+                db.set(key, i);
+
+                if (i % 10 == 0)
+                    db.remove(key);
+            }
+        });
+    }
+
+    for (auto & w: writers)
+        w.join();
+
+    for (int i = 0; i < 1000; i++) {
+        auto key = "key/" + std::to_string(i);
+        REQUIRE_EQ(db.template get_or<int>(key, -1), i % 10 == 0 ? -1 : i);
+    }
+
+    // Missing key
+    debby::error err;
+    db.remove("missing", & err);
+    CHECK(err);
+
+    db.clear();
+}
+
+#if DEBBY__LMDB_ENABLED
+TEST_CASE("lmdb group commit") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::lmdb>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-lmdb-gc.db");
+
+    debby::group_commit_options gc;
+    gc.max_batch_size = 16;
+    gc.max_latency = std::chrono::microseconds{100};
+
+    auto db = database_t::make(db_path, true, gc);
+    REQUIRE(db);
+    check_group_commit(db);
+}
+#endif
+
+#if DEBBY__MDBX_ENABLED
+TEST_CASE("mdbx group commit") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::mdbx>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-mdbx-gc.db");
+
+    debby::group_commit_options gc;
+    gc.max_batch_size = 16;
+    gc.max_latency = std::chrono::microseconds{100};
+
+    auto db = database_t::make(db_path, true, gc);
+    REQUIRE(db);
+    check_group_commit(db);
+}
+#endif
+
 #if DEBBY__MDBX_ENABLED
 TEST_CASE("mdbx set/get") {
     using database_t = debby::keyvalue_database<debby::backend_enum::mdbx>;
@@ -243,6 +929,205 @@ TEST_CASE("rocksdb set/get") {
     db.clear();
     check(std::move(db));
 }
+
+TEST_CASE("rocksdb read options and multi_get") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::rocksdb>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-rocksdb-kv-multi.db");
+    debby::rocksdb::wipe(db_path);
+
+    auto db = database_t::make(db_path, true);
+    std::vector<std::string> keys;
+
+    // More than a single MultiGet batch
+    for (int i = 0; i < 1000; i++) {
+        keys.push_back("key/" + std::to_string(i));
+        db.set(keys.back(), i);
+    }
+
+    keys.push_back("missing");
+
+    auto values = debby::rocksdb::multi_get<int>(db, keys, -1);
+    REQUIRE_EQ(values.size(), keys.size());
+
+    for (int i = 0; i < 1000; i++)
+        REQUIRE_EQ(values[i], i);
+
+    CHECK_EQ(values.back(), -1);
+
+    debby::rocksdb::read_options opts;
+    opts.fill_cache = false;
+    opts.readahead_size = 2 * 1024 * 1024;
+
+    CHECK_EQ(debby::rocksdb::get<int>(db, "key/42", opts), 42);
+
+    debby::error err;
+    debby::rocksdb::get<int>(db, "missing", opts, & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+
+    int count = 0;
+
+    debby::rocksdb::for_each_key(db, "key/", [& count] (std::string const &) {
+        count++;
+        return true;
+    }, opts);
+
+    CHECK_EQ(count, 1000);
+
+    db = database_t{};
+    debby::rocksdb::wipe(db_path);
+}
+
+TEST_CASE("rocksdb increment") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::rocksdb>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-rocksdb-kv-increment.db");
+    debby::rocksdb::wipe(db_path);
+
+    auto db = database_t::make(db_path, true);
+
+    // Non-counter value is treated as zero counter by blind merge
+    db.set("log", "Hello");
+    db.increment("log", 5);
+    CHECK_EQ(db.get<std::int64_t>("log"), 5);
+
+    debby::rocksdb::checked_increment(db, "counter");
+    debby::rocksdb::checked_increment(db, "counter", 41);
+    CHECK_EQ(db.get<std::int64_t>("counter"), 42);
+
+    db.set("log", "Hello");
+    debby::error err;
+    debby::rocksdb::checked_increment(db, "log", 1, & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::bad_value));
+    CHECK_EQ(db.get<std::string>("log"), std::string{"Hello"});
+
+    db = database_t{};
+    debby::rocksdb::wipe(db_path);
+}
+
+TEST_CASE("rocksdb bulk loader") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::rocksdb>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-rocksdb-kv-bulk.db");
+    debby::rocksdb::wipe(db_path);
+
+    auto db = database_t::make(db_path, true);
+    db.set("key/00000", std::string{"replaced"});
+
+    debby::rocksdb::bulk_load_options opts;
+    opts.chunk_size = 64 * 1024; // Many chunks
+    opts.threads = 4;
+
+    // Sorted input
+    {
+        opts.sorted = true;
+        debby::rocksdb::bulk_loader loader {db, opts};
+
+        for (int i = 0; i < 10000; i++) {
+            char key[16];
+            std::snprintf(key, sizeof(key), "key/%05d", i);
+            REQUIRE(loader.add(key, "value/" + std::to_string(i)));
+        }
+
+        debby::error err;
+        CHECK_FALSE(loader.add("key/00000", "unsorted", & err));
+        CHECK_EQ(err.code(), make_error_code(debby::errc::bad_value));
+    }
+
+    // Not finished loader discards the input
+    CHECK_EQ(db.get<std::string>("key/00000"), "replaced");
+
+    {
+        debby::rocksdb::bulk_loader loader {db, opts};
+
+        for (int i = 0; i < 10000; i++) {
+            char key[16];
+            std::snprintf(key, sizeof(key), "key/%05d", i);
+            REQUIRE(loader.add(key, "value/" + std::to_string(i)));
+        }
+
+        CHECK_EQ(loader.count(), 10000);
+        REQUIRE(loader.finish());
+    }
+
+    CHECK_EQ(db.get<std::string>("key/00000"), "value/0");
+    CHECK_EQ(db.get<std::string>("key/09999"), "value/9999");
+
+    // Unsorted input with duplicates merged from many runs
+    {
+        opts.sorted = false;
+        opts.target_file_size = 256 * 1024;
+        debby::rocksdb::bulk_loader loader {db, opts};
+
+        for (int i = 9999; i >= 0; i--)
+            REQUIRE(loader.add("num/" + std::to_string(i), i));
+
+        for (int i = 0; i < 100; i++)
+            REQUIRE(loader.add("num/" + std::to_string(i), -i));
+
+        REQUIRE(loader.finish());
+    }
+
+    CHECK_EQ(db.get<int>("num/5000"), 5000);
+    CHECK_EQ(db.get<int>("num/42"), -42);
+
+    int count = 0;
+
+    db.for_each_key("num/", [& count] (std::string const &) {
+        count++;
+        return true;
+    });
+
+    CHECK_EQ(count, 10000);
+
+    db = database_t{};
+    debby::rocksdb::wipe(db_path);
+}
+
+TEST_CASE("rocksdb statistics") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::rocksdb>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-rocksdb-kv-stats.db");
+    debby::rocksdb::wipe(db_path);
+
+    {
+        auto db = database_t::make(db_path, true);
+
+        debby::error err;
+        debby::rocksdb::statistics(db, & err);
+        CHECK_EQ(err.code(), make_error_code(debby::errc::unsupported));
+    }
+
+    debby::rocksdb::options_type opts;
+    opts.statistics = true;
+
+    auto db = database_t::make(db_path, opts, true);
+
+    for (int i = 0; i < 1000; i++)
+        db.set("key/" + std::to_string(i), i);
+
+    {
+        debby::rocksdb::perf_scope perf;
+        CHECK_EQ(db.get<int>("key/42"), 42);
+        CHECK_GT(perf.counters().get_from_memtable_count, 0);
+    }
+
+    auto stats = debby::rocksdb::statistics(db);
+    CHECK_FALSE(stats.tickers.empty());
+    CHECK_FALSE(stats.histograms.empty());
+    CHECK_EQ(stats.tickers["rocksdb.number.keys.written"], 1000);
+    CHECK_GE(stats.block_cache_hit_rate(), 0.0);
+
+    debby::rocksdb::reset_statistics(db);
+    CHECK_EQ(debby::rocksdb::statistics(db).tickers["rocksdb.number.keys.written"], 0);
+
+    CHECK_GT(debby::rocksdb::int_property(db, "rocksdb.estimate-num-keys"), 0);
+    CHECK_GT(debby::rocksdb::int_property(db, "rocksdb.cur-size-all-mem-tables"), 0);
+    CHECK_FALSE(debby::rocksdb::property(db, "rocksdb.stats").empty());
+
+    debby::error err;
+    debby::rocksdb::int_property(db, "unknown", & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+
+    db = database_t{};
+    debby::rocksdb::wipe(db_path);
+}
 #endif
 
 #if DEBBY__SQLITE3_ENABLED
@@ -253,6 +1138,16 @@ TEST_CASE("rocksdb set/get") {
     db.clear();
     check(std::move(db));
 }
+
+TEST_CASE("sqlite3 set/get (rowid layout)") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::sqlite3>;
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-sqlite3-kv-rowid.db");
+    debby::sqlite3::wipe(db_path);
+    auto db = database_t::make(db_path, "test-kv", true, debby::sqlite3::DEFAULT_PRESET
+        , debby::sqlite3::KV_ROWID);
+    check(std::move(db));
+    debby::sqlite3::wipe(db_path);
+}
 #endif
 
 #if DEBBY__PSQL_ENABLED
@@ -271,6 +1166,20 @@ TEST_CASE("PostgreSQL set/get") {
 
     REQUIRE(db);
 
+    db.clear();
+
+    // Single statement, the last value wins for duplicate keys
+    debby::psql::put_many(db, {"a", "b", "a"}, {"1", "2", "3"});
+    CHECK_EQ(db.get<std::string>("a"), "3");
+    CHECK_EQ(db.get<std::string>("b"), "2");
+
+    db.remove_many({"a", "b"});
+    CHECK_EQ(db.get_or<std::string>("a", "none"), "none");
+
+    err = debby::error{};
+    debby::psql::put_many(db, {"a"}, {}, & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::bad_value));
+
     db.clear();
     check(std::move(db));
 }
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021-2024 Vladislav Trifochkin
+// Copyright (c) 2021-2026 Vladislav Trifochkin
 //
 // This file is part of `debby-lib`.
 //
@@ -7,11 +7,19 @@
 //      2021.11.24 Initial version.
 //      2024.10.29 V2 started.
 //      2024.10.30 Fixed for sqlite3 database.
+//      2026.10.18 Added slow-query log test.
+//                 Added nested transactions test.
+//                 Added busy policy and transaction restart tests.
+//                 Added test for transaction body thrown exception.
+//                 Added test for failed `transaction_guard` commit.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "pfs/debby/relational_database.hpp"
 #include <pfs/filesystem.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
 
 #if DEBBY__SQLITE3_ENABLED
 #   include "pfs/debby/sqlite3.hpp"
@@ -130,6 +138,180 @@ void check (RelationalDatabaseType & db_opened)
     REQUIRE_FALSE(db.exists("three"));
 }
 
+template <typename RelationalDatabaseType>
+void check_slow_query_log (RelationalDatabaseType & db, std::string const & insert_sql)
+{
+    db.remove_all();
+    db.query(CREATE_TABLE_THREE);
+
+    debby::slow_query_options opts;
+    opts.threshold = std::chrono::microseconds{0}; // Record every query
+    opts.capacity = 2;
+    opts.explain = true;
+
+    int callback_counter = 0;
+    opts.callback = [& callback_counter] (debby::slow_query_record const &) { ++callback_counter; };
+
+    db.enable_slow_query_log(std::move(opts));
+
+    {
+        auto stmt = db.prepare(insert_sql);
+        REQUIRE(stmt);
+        stmt.bind(1, 42);
+        stmt.exec();
+    }
+
+    auto records = db.slow_queries();
+    REQUIRE_EQ(records.size(), 1);
+    CHECK_EQ(records[0].sql, insert_sql);
+    CHECK(records[0].params.find("42") != std::string::npos);
+    CHECK_EQ(records[0].rows, 1);
+
+    {
+        auto res = db.exec("SELECT col FROM three");
+    }
+
+    records = db.slow_queries();
+    REQUIRE_EQ(records.size(), 2);
+    CHECK_EQ(records[1].sql, std::string{"SELECT col FROM three"});
+    CHECK_FALSE(records[1].plan.empty());
+
+    // Oldest record is overwritten
+    db.query("DELETE FROM three");
+    records = db.slow_queries();
+    REQUIRE_EQ(records.size(), 2);
+    CHECK_EQ(records[0].sql, std::string{"SELECT col FROM three"});
+    CHECK_EQ(records[1].sql, std::string{"DELETE FROM three"});
+    CHECK_EQ(records[1].rows, 1);
+    CHECK_EQ(callback_counter, 3);
+
+    db.disable_slow_query_log();
+    db.query("DELETE FROM three");
+    CHECK_EQ(db.slow_queries().size(), 2);
+
+    db.clear_slow_queries();
+    CHECK(db.slow_queries().empty());
+
+    db.remove_all();
+}
+
+template <typename RelationalDatabaseType>
+void check_nested_transactions (RelationalDatabaseType & db, debby::transaction_mode mode
+    , debby::transaction_mode unsupported_mode)
+{
+    using guard_t = debby::transaction_guard<RelationalDatabaseType::backend_value>;
+
+    db.remove_all();
+    db.query(CREATE_TABLE_THREE);
+
+    auto count = [& db] () {
+        return db.rows_count("three");
+    };
+
+    CHECK_EQ(db.transaction_depth(), 0);
+
+    db.begin(mode);
+    db.query("INSERT INTO three (col) VALUES (1)");
+
+    db.begin();
+    CHECK_EQ(db.transaction_depth(), 2);
+    db.query("INSERT INTO three (col) VALUES (2)");
+    db.rollback(); // Rolls back to savepoint only
+    CHECK_EQ(db.transaction_depth(), 1);
+    CHECK_EQ(count(), 1);
+
+    db.begin();
+    db.query("INSERT INTO three (col) VALUES (3)");
+    db.commit();
+    CHECK_EQ(count(), 2);
+
+    db.commit();
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(count(), 2);
+
+    // Failed nested transaction body
+    auto failure = db.transaction([& db] () -> pfs::optional<std::string> {
+        db.query("INSERT INTO three (col) VALUES (4)");
+
+        auto nested_failure = db.transaction([& db] () -> pfs::optional<std::string> {
+            db.query("INSERT INTO three (col) VALUES (5)");
+            return std::string{"failure"};
+        });
+
+        CHECK(nested_failure);
+        return pfs::nullopt;
+    });
+
+    CHECK_FALSE(failure);
+    CHECK_EQ(count(), 3);
+
+    // Transaction body thrown exception (with nested transaction left started)
+    CHECK_THROWS_AS(db.transaction([& db] () -> pfs::optional<std::string> {
+        db.query("INSERT INTO three (col) VALUES (40)");
+        db.begin();
+        db.query("INSERT INTO three (col) VALUES (41)");
+        throw std::runtime_error{"failure"};
+    }), std::runtime_error);
+
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(count(), 3);
+
+    CHECK_THROWS_AS(db.transaction([& db] () -> pfs::optional<std::string> {
+        db.query("INSERT INTO three (col) VALUES (42)");
+        db.query("INSERT INTO unknown_table (col) VALUES (43)");
+        return pfs::nullopt;
+    }), debby::error);
+
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(count(), 3);
+
+    // Next transaction is committed
+    failure = db.transaction([& db] () -> pfs::optional<std::string> {
+        db.query("INSERT INTO three (col) VALUES (44)");
+        return pfs::nullopt;
+    });
+
+    CHECK_FALSE(failure);
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(count(), 4);
+
+    db.query("DELETE FROM three WHERE col = 44");
+    CHECK_EQ(count(), 3);
+
+    // Guard
+    {
+        guard_t tx {db, mode};
+        CHECK(tx.active());
+        db.query("INSERT INTO three (col) VALUES (6)");
+
+        {
+            guard_t nested_tx {db};
+            db.query("INSERT INTO three (col) VALUES (7)");
+        } // Rolled back
+
+        CHECK_EQ(db.transaction_depth(), 1);
+        tx.commit();
+        CHECK_FALSE(tx);
+    }
+
+    CHECK_EQ(count(), 4);
+
+    {
+        guard_t tx {db};
+        db.query("INSERT INTO three (col) VALUES (8)");
+    }
+
+    CHECK_EQ(count(), 4);
+    CHECK_EQ(db.transaction_depth(), 0);
+
+    debby::error err;
+    db.begin(unsupported_mode, & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::unsupported));
+    CHECK_EQ(db.transaction_depth(), 0);
+
+    db.remove_all();
+}
+
 #if DEBBY__SQLITE3_ENABLED
 TEST_CASE("sqlite3") {
     using database_t = debby::relational_database<debby::backend_enum::sqlite3>;
@@ -140,6 +322,166 @@ TEST_CASE("sqlite3") {
     REQUIRE(db);
 
     check(db);
+
+    db = debby::sqlite3::make(db_path);
+    check_slow_query_log(db, "INSERT INTO three (col) VALUES (?)");
+    check_nested_transactions(db, debby::transaction_mode::immediate
+        , debby::transaction_mode::serializable);
+    debby::sqlite3::wipe(db_path);
+}
+
+TEST_CASE("sqlite3 busy policy") {
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-sqlite3-busy.db");
+    debby::sqlite3::wipe(db_path);
+
+    auto writer = debby::sqlite3::make(db_path);
+    auto db = debby::sqlite3::make(db_path);
+    REQUIRE(writer);
+    REQUIRE(db);
+
+    debby::sqlite3::busy_policy policy;
+    policy.initial_delay = std::chrono::milliseconds{1};
+    policy.max_delay = std::chrono::milliseconds{10};
+    policy.max_wait = std::chrono::milliseconds{50};
+    debby::sqlite3::set_busy_policy(db, policy);
+
+    writer.begin(debby::transaction_mode::immediate);
+
+    debby::error err;
+    db.begin(debby::transaction_mode::immediate, & err);
+    CHECK(err);
+    CHECK_EQ(db.transaction_depth(), 0);
+
+    auto stats = debby::sqlite3::stats(db);
+    CHECK_EQ(stats.busy_events, 1);
+    CHECK_EQ(stats.timeouts, 1);
+    CHECK_GE(stats.total_wait, std::chrono::milliseconds{40});
+    CHECK_LE(stats.total_wait, std::chrono::milliseconds{500});
+
+    writer.commit();
+
+    db.begin(debby::transaction_mode::immediate);
+    db.commit();
+
+    debby::sqlite3::reset_stats(db);
+    CHECK_EQ(debby::sqlite3::stats(db).busy_events, 0);
+    CHECK_EQ(debby::sqlite3::stats(db).total_wait.count(), 0);
+
+    debby::sqlite3::wipe(db_path);
+}
+
+TEST_CASE("sqlite3 transaction restart") {
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-sqlite3-restart.db");
+    debby::sqlite3::wipe(db_path);
+
+    auto db = debby::sqlite3::make(db_path, true, debby::sqlite3::CONCURRENCY_PRESET);
+    auto other = debby::sqlite3::make(db_path, true, debby::sqlite3::CONCURRENCY_PRESET);
+    REQUIRE(db);
+    REQUIRE(other);
+
+    db.query(CREATE_TABLE_THREE);
+
+    int attempts = 0;
+
+    auto failure = db.transaction(debby::transaction_mode::deferred, [&] () -> pfs::optional<std::string> {
+        attempts++;
+
+        // Read transaction snapshot
+        db.rows_count("three");
+
+        // Concurrent write makes the snapshot outdated
+        if (attempts == 1)
+            other.query("INSERT INTO three (col) VALUES (1)");
+
+        db.query("INSERT INTO three (col) VALUES (2)");
+        return pfs::nullopt;
+    });
+
+    CHECK_FALSE(failure);
+    CHECK_EQ(attempts, 2);
+    CHECK_EQ(db.rows_count("three"), 2);
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(debby::sqlite3::stats(db).transaction_restarts, 1);
+
+    // Conflict reported if retries are exhausted
+    debby::sqlite3::busy_policy policy;
+    policy.max_transaction_retries = 0;
+    debby::sqlite3::set_busy_policy(db, policy);
+
+    attempts = 0;
+
+    try {
+        db.transaction(debby::transaction_mode::deferred, [&] () -> pfs::optional<std::string> {
+            attempts++;
+            db.rows_count("three");
+            other.query("INSERT INTO three (col) VALUES (3)");
+            db.query("INSERT INTO three (col) VALUES (4)");
+            return pfs::nullopt;
+        });
+
+        REQUIRE(false);
+    } catch (debby::error const & ex) {
+        CHECK_EQ(ex.code(), make_error_code(debby::errc::transaction_conflict));
+    }
+
+    // Transaction is rolled back
+    CHECK_EQ(attempts, 1);
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(db.rows_count("three"), 3);
+
+    db = debby::relational_database<debby::backend_enum::sqlite3>{};
+    other = debby::relational_database<debby::backend_enum::sqlite3>{};
+    debby::sqlite3::wipe(db_path);
+}
+
+TEST_CASE("sqlite3 transaction guard failed commit") {
+    using guard_t = debby::transaction_guard<debby::backend_enum::sqlite3>;
+
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-sqlite3-guard.db");
+    debby::sqlite3::wipe(db_path);
+
+    auto db = debby::sqlite3::make(db_path);
+    REQUIRE(db);
+
+    // Deferred foreign key violation fails COMMIT and leaves the transaction open
+    db.query("PRAGMA foreign_keys = ON");
+    db.query("CREATE TABLE parent (id INTEGER PRIMARY KEY)");
+    db.query("CREATE TABLE child (parent_id INTEGER"
+        " REFERENCES parent (id) DEFERRABLE INITIALLY DEFERRED)");
+
+    {
+        guard_t tx {db};
+        db.query("INSERT INTO child (parent_id) VALUES (1)");
+
+        debby::error err;
+        tx.commit(& err);
+        CHECK(err);
+        CHECK(tx.active());
+        CHECK_EQ(db.transaction_depth(), 1);
+    } // Rolled back
+
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(db.rows_count("child"), 0);
+
+    // Commit retried after the violation is fixed
+    {
+        guard_t tx {db};
+        db.query("INSERT INTO child (parent_id) VALUES (1)");
+
+        debby::error err;
+        tx.commit(& err);
+        CHECK(err);
+        REQUIRE(tx.active());
+
+        db.query("INSERT INTO parent (id) VALUES (1)");
+        tx.commit();
+        CHECK_FALSE(tx);
+    }
+
+    CHECK_EQ(db.transaction_depth(), 0);
+    CHECK_EQ(db.rows_count("child"), 1);
+
+    db = debby::relational_database<debby::backend_enum::sqlite3>{};
     debby::sqlite3::wipe(db_path);
 }
 #endif
@@ -160,5 +502,10 @@ TEST_CASE("PostgreSQL") {
     REQUIRE(db);
 
     check(db);
+
+    db = debby::psql::make(conninfo.cbegin(), conninfo.cend());
+    check_slow_query_log(db, "INSERT INTO three (col) VALUES ($1)");
+    check_nested_transactions(db, debby::transaction_mode::repeatable_read
+        , debby::transaction_mode::immediate);
 }
 #endif
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+//                 Added test for database without shards.
+//                 Added `get_many<bool>()` test.
+//                 Added failed `add_shards()` test.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/debby/keyvalue_database.hpp"
+#include "pfs/debby/sharded_keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if DEBBY__MAP_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+#   include "pfs/debby/sqlite3.hpp"
+#endif
+
+namespace fs = pfs::filesystem;
+
+TEST_CASE("jump consistent hash") {
+    using sharded_t = debby::sharded_keyvalue_database<debby::backend_enum::map_mt>;
+
+    std::vector<int> counts(8, 0);
+    int moved = 0;
+
+    for (int i = 0; i < 10000; i++) {
+        auto key = "key/" + std::to_string(i);
+        auto index = sharded_t::shard_index(key, 8);
+        counts[index]++;
+
+        // Growing 8 shards to 10 moves keys to new shards only
+        auto new_index = sharded_t::shard_index(key, 10);
+
+        if (new_index != index) {
+            REQUIRE_GE(new_index, 8);
+            moved++;
+        }
+    }
+
+    for (auto n: counts) {
+        CHECK_GT(n, 1000);
+        CHECK_LT(n, 1500);
+    }
+
+    // About 2/10 of keys
+    CHECK_GT(moved, 1500);
+    CHECK_LT(moved, 2500);
+}
+
+#if DEBBY__MAP_ENABLED
+TEST_CASE("sharded in-memory map") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::map_mt>;
+    using sharded_t = debby::sharded_keyvalue_database<debby::backend_enum::map_mt>;
+
+    auto db = sharded_t::make(4, [] (std::size_t) { return database_t::make(); });
+    REQUIRE(db);
+    CHECK_EQ(db.shard_count(), 4);
+
+    // Concurrent writers
+    std::vector<std::thread> writers;
+
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([& db, t] {
+            for (int i = t; i < 1000; i += 4)
+                db.set("key/" + std::to_string(i), "value/" + std::to_string(i));
+        });
+    }
+
+    for (auto & w: writers)
+        w.join();
+
+    CHECK_EQ(db.get<std::string>("key/1"), "value/1");
+    CHECK_EQ(db.shard_at(db.shard_of("key/1")).get<std::string>("key/1"), "value/1");
+
+    std::vector<std::string> keys {"key/0", "missing", "key/999", "key/500"};
+    auto values = db.get_many<std::string>(keys, "none");
+    REQUIRE_EQ(values.size(), 4);
+    CHECK_EQ(values[0], "value/0");
+    CHECK_EQ(values[1], "none");
+    CHECK_EQ(values[2], "value/999");
+    CHECK_EQ(values[3], "value/500");
+
+    db.set_many(std::vector<std::pair<std::string, std::string>>{{"a", "1"}, {"b", "2"}});
+    CHECK_EQ(db.get<std::string>("b"), "2");
+
+    // `std::vector<bool>` result filled by shards in parallel
+    std::vector<std::string> flags;
+
+    for (int i = 0; i < 100; i++) {
+        flags.push_back("flag/" + std::to_string(i));
+        db.set(flags.back(), i % 3 == 0);
+    }
+
+    auto flag_values = db.get_many<bool>(flags, false);
+    REQUIRE_EQ(flag_values.size(), flags.size());
+
+    for (int i = 0; i < 100; i++)
+        REQUIRE_EQ(flag_values[i], i % 3 == 0);
+
+    db.remove_many(flags);
+
+    db.remove_many({"key/0", "a"});
+    CHECK_EQ(db.get_or<std::string>("key/0", "none"), "none");
+    CHECK_EQ(db.get_or<std::string>("a", "none"), "none");
+
+    int count = 0;
+
+    db.for_each_key("key/", [& count] (std::string const &) {
+        count++;
+        return true;
+    });
+
+    CHECK_EQ(count, 999);
+
+    // Failed resharding (in-memory backend moves string values only) returns new shards
+    for (int i = 0; i < 100; i++)
+        db.set("int/" + std::to_string(i), i);
+
+    std::vector<database_t> failed_extra;
+    failed_extra.push_back(database_t::make());
+    failed_extra.push_back(database_t::make());
+
+    debby::error err;
+    CHECK_FALSE(db.add_shards(std::move(failed_extra), & err));
+    CHECK(err);
+    CHECK_EQ(db.shard_count(), 4);
+    REQUIRE_EQ(failed_extra.size(), 2);
+    CHECK(failed_extra[0]);
+    CHECK(failed_extra[1]);
+    CHECK_EQ(db.get<int>("int/42"), 42);
+
+    for (int i = 0; i < 100; i++)
+        db.remove("int/" + std::to_string(i));
+
+    // Resharding
+    std::vector<database_t> extra;
+    extra.push_back(database_t::make());
+    extra.push_back(database_t::make());
+    REQUIRE(db.add_shards(std::move(extra)));
+    CHECK_EQ(db.shard_count(), 6);
+
+    for (int i = 1; i < 1000; i++) {
+        auto key = "key/" + std::to_string(i);
+        REQUIRE_EQ(db.get<std::string>(key), "value/" + std::to_string(i));
+    }
+
+    count = 0;
+
+    db.for_each_key("", [& count] (std::string const &) {
+        count++;
+        return true;
+    });
+
+    CHECK_EQ(count, 1000);
+
+    // Moved keys are stored by new shards only
+    auto key = std::string{"key/1"};
+
+    for (int i = 1; db.shard_of(key) < 4; i++)
+        key = "key/" + std::to_string(i);
+
+    CHECK_EQ(db.shard_at(db.shard_of(key)).get<std::string>(key), "value/" + key.substr(4));
+    CHECK_EQ(db.shard_at(sharded_t::shard_index(key, 4)).get_or<std::string>(key, "none"), "none");
+
+    db.clear();
+    CHECK_EQ(db.get_or<std::string>("key/1", "none"), "none");
+}
+
+TEST_CASE("sharded database without shards") {
+    using sharded_t = debby::sharded_keyvalue_database<debby::backend_enum::map_mt>;
+
+    sharded_t db;
+    REQUIRE_FALSE(db);
+    CHECK_EQ(db.shard_count(), 0);
+
+    debby::error err;
+    CHECK_EQ(db.get_or<std::string>("a", "none", & err), "none");
+    CHECK_EQ(err.code(), debby::make_error_code(debby::errc::database_not_found));
+
+    CHECK_THROWS_AS(db.set("a", std::string{"1"}), debby::error);
+    CHECK_THROWS_AS(db.get<std::string>("a"), debby::error);
+    CHECK_THROWS_AS(db.remove("a"), debby::error);
+    CHECK_THROWS_AS(db.set_many(std::vector<std::pair<std::string, std::string>>{{"a", "1"}}), debby::error);
+    CHECK_THROWS_AS(db.get_many<std::string>({"a"}, "none"), debby::error);
+    CHECK_THROWS_AS(db.remove_many({"a"}), debby::error);
+}
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+TEST_CASE("sharded sqlite3") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::sqlite3>;
+    using sharded_t = debby::sharded_keyvalue_database<debby::backend_enum::sqlite3>;
+
+    auto shard_path = [] (std::size_t i) {
+        return fs::temp_directory_path() / pfs::utf8_decode_path("debby-sharded-" + std::to_string(i) + ".db");
+    };
+
+    for (std::size_t i = 0; i < 3; i++)
+        debby::sqlite3::wipe(shard_path(i));
+
+    {
+        auto db = sharded_t::make(2, [& shard_path] (std::size_t i) {
+            return database_t::make(shard_path(i), "test-kv", true);
+        });
+
+        REQUIRE(db);
+
+        std::vector<std::pair<std::string, int>> items;
+
+        for (int i = 0; i < 500; i++)
+            items.emplace_back("key/" + std::to_string(i), i);
+
+        db.set_many(items);
+
+        // Values are moved as raw bytes
+        std::vector<database_t> extra;
+        extra.push_back(database_t::make(shard_path(2), "test-kv", true));
+        REQUIRE(db.add_shards(std::move(extra)));
+    }
+
+    auto db = sharded_t::make(3, [& shard_path] (std::size_t i) {
+        return database_t::make(shard_path(i), "test-kv", true);
+    });
+
+    std::vector<std::string> keys;
+
+    for (int i = 0; i < 500; i++)
+        keys.push_back("key/" + std::to_string(i));
+
+    auto values = db.get_many<int>(keys, -1);
+
+    for (int i = 0; i < 500; i++)
+        REQUIRE_EQ(values[i], i);
+
+    for (std::size_t i = 0; i < 3; i++)
+        debby::sqlite3::wipe(shard_path(i));
+}
+#endif
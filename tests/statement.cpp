@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2021.11.24 Initial version.
+//      2026.10.18 Added tests for PostgreSQL binary parameter binding.
 ////////////////////////////////////////////////////////////////////////////////
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
@@ -13,6 +14,7 @@
 #include "pfs/filesystem.hpp"
 #include "pfs/fmt.hpp"
 #include <cmath>
+#include <cstdint>
 #include <limits>
 
 #if DEBBY__SQLITE3_ENABLED
@@ -184,7 +186,17 @@ void check (RelationalDatabaseType & db, std::string const & insert_statement_fo
         CHECK_EQ(result.column_name(18), std::string{"utc_time"});
         CHECK_EQ(result.column_name(19), std::string{"local_time"});
 
+        // Resolved once and reused for each row
+        auto text_column = result.column("text");
+        auto double_column = result.column("double");
+        REQUIRE(text_column);
+        CHECK_EQ(text_column.index(), 15);
+        REQUIRE_THROWS_AS(result.column("unknown"), debby::error);
+
         while (result.has_more()) {
+            CHECK_EQ(result.template get_or<std::string>(text_column, ""), std::string{"Hello"});
+            CHECK_EQ(result.template get_or<double>(double_column, 0), double{3.14159});
+
             {
                 REQUIRE_THROWS_AS(result.template get_or<int>("unknown", -42), debby::error);
             }
@@ -253,6 +265,89 @@ void prepared_select (RelationalDatabaseType & db, std::string const & sql)
     }
 }
 
+template <typename RelationalDatabaseType>
+void fetch_columns (RelationalDatabaseType & db)
+{
+    db.query("DROP TABLE IF EXISTS fetch_test");
+    db.query("CREATE TABLE fetch_test (i BIGINT, d DOUBLE PRECISION, s TEXT)");
+    db.query("INSERT INTO fetch_test VALUES (1, 0.5, 'a'), (NULL, 1.5, NULL), (3, NULL, ''), (4, 4.5, 'dd')");
+
+    auto stmt = db.prepare("SELECT i, d, s FROM fetch_test ORDER BY d");
+    REQUIRE(stmt);
+
+    auto result = stmt.exec();
+    debby::column_batch batch;
+
+    // NULL is sorted last by PostgreSQL and first by SQLite, so only totals are compared
+    std::size_t rows = 0;
+    std::size_t nulls = 0;
+    std::string chars;
+
+    while (result.fetch_columns(batch, 3) > 0) {
+        REQUIRE_EQ(batch.columns.size(), 3);
+        CHECK_EQ(batch.columns[0].name, std::string{"i"});
+        CHECK_EQ(batch.columns[0].type, debby::column_type::int64);
+        CHECK_EQ(batch.columns[1].type, debby::column_type::float64);
+        CHECK_EQ(batch.columns[2].type, debby::column_type::binary);
+
+        REQUIRE_EQ(batch.columns[0].int64_values.size(), batch.row_count);
+        REQUIRE_EQ(batch.columns[1].float64_values.size(), batch.row_count);
+        REQUIRE_EQ(batch.columns[2].offsets.size(), batch.row_count + 1);
+
+        for (auto const & c: batch.columns)
+            nulls += c.null_count;
+
+        chars += batch.columns[2].data;
+        rows += batch.row_count;
+    }
+
+    CHECK_EQ(rows, 4);
+    CHECK_EQ(nulls, 3);
+    CHECK_EQ(chars.size(), 3);
+    CHECK(result.is_done());
+
+    db.query("DROP TABLE fetch_test");
+}
+
+template <typename RelationalDatabaseType>
+void iterate_rows (RelationalDatabaseType & db)
+{
+    db.query("DROP TABLE IF EXISTS rows_test");
+    db.query("CREATE TABLE rows_test (i INTEGER, d DOUBLE PRECISION, s TEXT)");
+    db.query("INSERT INTO rows_test VALUES (1, 0.5, 'a'), (2, NULL, NULL), (3, 2.5, 'ccc')");
+
+    auto stmt = db.prepare("SELECT i, d, s FROM rows_test ORDER BY i");
+    REQUIRE(stmt);
+
+    auto result = stmt.exec();
+    std::int64_t sum = 0;
+    double dsum = 0;
+    std::string chars;
+    int nulls = 0;
+
+    for (auto row: result) {
+        sum += row.template get<std::int64_t>(1);
+        dsum += row.template get<double>(2);
+        chars += std::string(row.text(3).data(), row.text(3).size());
+
+        if (row.is_null(2))
+            nulls++;
+    }
+
+    CHECK_EQ(sum, 6);
+    CHECK_EQ(dsum, 3.0);
+    CHECK_EQ(chars, std::string{"accc"});
+    CHECK_EQ(nulls, 1);
+    CHECK(result.is_done());
+
+    // Nothing to iterate
+    auto empty_stmt = db.prepare("SELECT i FROM rows_test WHERE i > 3");
+    auto empty = empty_stmt.exec();
+    CHECK(empty.begin() == empty.end());
+
+    db.query("DROP TABLE rows_test");
+}
+
 #if DEBBY__SQLITE3_ENABLED
 TEST_CASE("sqlite3") {
     using database_t = debby::relational_database<debby::backend_enum::sqlite3>;
@@ -267,6 +362,35 @@ TEST_CASE("sqlite3") {
     check(db, INSERT_SQLITE3);
     prepared_select(db, SELECT_SQLITE3);
 
+    {
+        auto stmt = db.prepare(fmt::format(SELECT_SQLITE3, TABLE_NAME));
+        debby::error err;
+        stmt.exec_batch(& err, std::vector<int>{1, 2});
+        CHECK_EQ(err.code(), make_error_code(debby::errc::unsupported));
+    }
+
+    fetch_columns(db);
+    iterate_rows(db);
+
+    {
+        db.query("CREATE TABLE blobs (b BLOB)");
+        db.query("INSERT INTO blobs VALUES (X'00FF'), (NULL), (X'41')");
+
+        auto stmt = db.prepare("SELECT b FROM blobs");
+        auto result = stmt.exec();
+        auto batch = result.fetch_columns(10);
+
+        REQUIRE_EQ(batch.row_count, 3);
+        auto const & c = batch.columns[0];
+        CHECK_EQ(c.type, debby::column_type::binary);
+        CHECK_EQ(c.null_count, 1);
+        CHECK_EQ(c.validity[0], 0x05);
+        CHECK(c.is_null(1));
+        CHECK_EQ(c.offsets, std::vector<std::int64_t>{0, 2, 2, 3});
+        CHECK_EQ(c.data, std::string{"\x00\xFF" "A", 3});
+        CHECK(result.is_done());
+    }
+
     database_t::wipe(db_path);
 }
 #endif
@@ -290,5 +414,79 @@ TEST_CASE("PostgreSQL") {
 
     check(db, INSERT_PSQL);
     prepared_select(db, SELECT_PSQL);
+
+    {
+        db.query("CREATE TEMP TABLE batch (id INT8, name TEXT, score FLOAT8)");
+
+        auto stmt = db.prepare("INSERT INTO batch SELECT * FROM unnest($1::int8[], $2::text[], $3::float8[])");
+        REQUIRE(stmt);
+
+        auto result = stmt.exec_batch(nullptr, std::vector<long long>{1, 2, 3}
+            , std::vector<std::string>{"a", "b\"c", "d\\e"}, std::vector<double>{0.5, 1.5, 2.5});
+        REQUIRE(result.is_done());
+        REQUIRE_EQ(db.rows_count("batch"), 3);
+
+        auto select = db.prepare("SELECT name, score FROM batch WHERE id = ANY($1)");
+        REQUIRE(select);
+        auto selected = select.exec_batch(nullptr, std::vector<int>{2});
+        REQUIRE(selected.has_more());
+        CHECK_EQ(selected.get_or<std::string>("name", ""), std::string{"b\"c"});
+        CHECK_EQ(selected.get_or<double>("score", 0), 1.5);
+    }
+
+    // Parameters bound in binary format (bool/int2/int4/int8/float4/float8) or as text
+    // (fallback), the value is returned as text by the server
+    {
+        auto round_trip = [& db] (char const * sql, auto value, debby::error * perr = nullptr) {
+            auto stmt = db.prepare(sql);
+            REQUIRE(stmt);
+            stmt.bind(1, value);
+
+            debby::error err;
+            auto result = stmt.exec(& err);
+
+            if (err) {
+                if (perr == nullptr)
+                    REQUIRE_MESSAGE(false, err.what());
+
+                *perr = std::move(err);
+                return std::string{};
+            }
+
+            REQUIRE(result.has_more());
+            return result.template get_or<std::string>("v", std::string{});
+        };
+
+        CHECK_EQ(round_trip("SELECT ($1::int2)::text AS v", (std::numeric_limits<std::int16_t>::min)())
+            , std::string{"-32768"});
+        CHECK_EQ(round_trip("SELECT ($1::int4)::text AS v", (std::numeric_limits<std::int32_t>::min)())
+            , std::string{"-2147483648"});
+        CHECK_EQ(round_trip("SELECT ($1::int8)::text AS v", (std::numeric_limits<std::int64_t>::min)())
+            , std::string{"-9223372036854775808"});
+        CHECK_EQ(round_trip("SELECT ($1::int8)::text AS v", 42), std::string{"42"});
+        CHECK_EQ(round_trip("SELECT ($1::float4)::text AS v", 1.5f), std::string{"1.5"});
+        CHECK_EQ(round_trip("SELECT ($1::float8)::text AS v", -2.5), std::string{"-2.5"});
+        CHECK_EQ(round_trip("SELECT ($1::bool)::text AS v", true), std::string{"true"});
+        CHECK_EQ(round_trip("SELECT ($1::bool)::text AS v", false), std::string{"false"});
+
+        // Text fallback
+        CHECK_EQ(round_trip("SELECT ($1::numeric)::text AS v", 12345), std::string{"12345"});
+        CHECK_EQ(round_trip("SELECT ($1::numeric)::text AS v", 2.5), std::string{"2.5"});
+        CHECK_EQ(round_trip("SELECT $1::text AS v", 42), std::string{"42"});
+
+        // Unsigned 64-bit values above INT64_MAX
+        CHECK_EQ(round_trip("SELECT ($1::numeric)::text AS v", (std::numeric_limits<std::uint64_t>::max)())
+            , std::string{"18446744073709551615"});
+        CHECK_EQ(round_trip("SELECT ($1::int8)::text AS v"
+            , static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max)()))
+            , std::string{"9223372036854775807"});
+
+        debby::error err;
+        round_trip("SELECT ($1::int8)::text AS v", (std::numeric_limits<std::uint64_t>::max)(), & err);
+        CHECK(err); // Out of bigint range, not wrapped around
+    }
+
+    fetch_columns(db);
+    iterate_rows(db);
 }
 #endif
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/debby/keyvalue_database.hpp"
+#include "pfs/debby/tiered_keyvalue_database.hpp"
+#include <pfs/filesystem.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if DEBBY__MAP_ENABLED || DEBBY__LRU_CACHE_ENABLED
+#   include "pfs/debby/in_memory.hpp"
+#endif
+
+#if DEBBY__SQLITE3_ENABLED
+#   include "pfs/debby/sqlite3.hpp"
+#endif
+
+namespace fs = pfs::filesystem;
+
+#if DEBBY__LRU_CACHE_ENABLED && DEBBY__MAP_ENABLED
+
+using front_t = debby::keyvalue_database<debby::backend_enum::lru_cache_mt>;
+using back_t = debby::keyvalue_database<debby::backend_enum::map_mt>;
+using tiered_t = debby::tiered_keyvalue_database<debby::backend_enum::lru_cache_mt, debby::backend_enum::map_mt>;
+
+TEST_CASE("tiered write-through") {
+    auto db = tiered_t::make(front_t::make(), back_t::make());
+    REQUIRE(db);
+
+    db.set("int", 42);
+    db.set("str", std::string{"hello"});
+    db.set("cstr", "world");
+
+    // Written to both tiers
+    CHECK_EQ(db.back().get<int>("int"), 42);
+    CHECK_EQ(db.front().get<int>("int"), 42);
+    CHECK_EQ(db.back().get<std::string>("str"), "hello");
+    CHECK_EQ(db.back().get<std::string>("cstr"), "world");
+
+    // Read-through populates the front tier
+    db.back().set("cold", 3.14);
+    CHECK_EQ(debby::in_memory::stats(db.front()).count, 3);
+    CHECK_EQ(db.get<double>("cold"), 3.14);
+    CHECK_EQ(debby::in_memory::stats(db.front()).count, 4);
+    CHECK_EQ(db.front().get<double>("cold"), 3.14);
+
+    db.remove("int");
+    CHECK_EQ(db.get_or<int>("int", -1), -1);
+    CHECK_EQ(db.back().get_or<int>("int", -1), -1);
+
+    debby::error err;
+    db.get<int>("missing", & err);
+    CHECK_EQ(err.code(), make_error_code(debby::errc::key_not_found));
+}
+
+TEST_CASE("tiered write-through concurrent writes") {
+    auto db = tiered_t::make(front_t::make(), back_t::make());
+    std::vector<std::thread> writers;
+
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([& db, t] {
+            for (int i = 0; i < 1000; i++)
+                db.set("key", t * 1000 + i);
+        });
+    }
+
+    for (auto & w: writers)
+        w.join();
+
+    // Both tiers have the last written value
+    CHECK_EQ(db.front().get<int>("key"), db.back().get<int>("key"));
+}
+
+TEST_CASE("tiered write-behind") {
+    debby::tiered_options opts;
+    opts.policy = debby::write_policy::write_behind;
+    opts.queue_capacity = 64;
+    opts.flush_interval = std::chrono::milliseconds{10};
+
+    auto db = tiered_t::make(front_t::make(), back_t::make(), opts);
+
+    // Repeated writes of the same key are coalesced
+    for (int i = 0; i < 1000; i++)
+        db.set("counter", i);
+
+    // More keys than the queue holds: writers wait for the background thread
+    for (int i = 0; i < 500; i++)
+        db.set("key/" + std::to_string(i), i);
+
+    db.remove("key/0");
+
+    CHECK_EQ(db.get<int>("counter"), 999);
+    CHECK(db.flush());
+
+    CHECK_EQ(db.back().get<int>("counter"), 999);
+    CHECK_EQ(db.back().get<int>("key/499"), 499);
+    CHECK_EQ(db.back().get_or<int>("key/0", -1), -1);
+}
+
+TEST_CASE("tiered write-behind with evicted dirty entries") {
+    debby::tiered_options opts;
+    opts.policy = debby::write_policy::write_behind;
+    opts.flush_interval = std::chrono::milliseconds{60 * 1000};
+
+    debby::in_memory::cache_options cache_opts;
+    cache_opts.capacity = 4096;
+
+    auto db = tiered_t::make(front_t::make(cache_opts), back_t::make(), opts);
+
+    for (int i = 0; i < 1000; i++)
+        db.set("key/" + std::to_string(i), std::string(20, static_cast<char>('a' + i % 26)));
+
+    // Evicted from the front tier and not yet written to the back tier
+    CHECK_GT(debby::in_memory::stats(db.front()).evictions, 0);
+    CHECK_EQ(db.get<std::string>("key/0"), std::string(20, 'a'));
+    CHECK_EQ(db.get<std::string>("key/27"), std::string(20, 'b'));
+}
+
+#if DEBBY__SQLITE3_ENABLED
+TEST_CASE("tiered over sqlite3") {
+    using back_sqlite3_t = debby::keyvalue_database<debby::backend_enum::sqlite3>;
+    using tiered_sqlite3_t = debby::tiered_keyvalue_database<debby::backend_enum::lru_cache_mt
+        , debby::backend_enum::sqlite3>;
+
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-tiered-kv.db");
+    debby::sqlite3::wipe(db_path);
+
+    debby::tiered_options opts;
+    opts.policy = debby::write_policy::write_behind;
+
+    {
+        auto db = tiered_sqlite3_t::make(front_t::make(), back_sqlite3_t::make(db_path, "test-kv", true), opts);
+        REQUIRE(db);
+
+        for (int i = 0; i < 100; i++)
+            db.set("key/" + std::to_string(i), "value/" + std::to_string(i));
+
+        // Pending writes are applied on destruction
+    }
+
+    {
+        auto db = tiered_sqlite3_t::make(front_t::make(), back_sqlite3_t::make(db_path, "test-kv", true));
+        CHECK_EQ(db.get<std::string>("key/99"), "value/99");
+        CHECK_EQ(db.front().get<std::string>("key/99"), "value/99");
+    }
+
+    debby::sqlite3::wipe(db_path);
+}
+#endif
+
+#endif
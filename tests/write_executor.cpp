@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `debby-lib`.
+//
+// Changelog:
+//      2026.10.18 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "pfs/debby/write_executor.hpp"
+#include <pfs/filesystem.hpp>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if DEBBY__SQLITE3_ENABLED
+#   include "pfs/debby/sqlite3.hpp"
+#endif
+
+namespace fs = pfs::filesystem;
+
+#if DEBBY__SQLITE3_ENABLED
+TEST_CASE("sqlite3 key-value write executor") {
+    using database_t = debby::keyvalue_database<debby::backend_enum::sqlite3>;
+    using executor_t = debby::write_executor<database_t>;
+
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-write-executor.db");
+    debby::sqlite3::wipe(db_path);
+
+    {
+        debby::write_executor_options opts;
+        opts.max_batch_size = 100;
+
+        executor_t executor {database_t::make(db_path, "test-kv", true), opts};
+
+        std::vector<std::thread> writers;
+        std::vector<std::vector<std::future<void>>> results(4);
+
+        for (int t = 0; t < 4; t++) {
+            writers.emplace_back([& executor, & results, t] {
+                for (int i = t; i < 1000; i += 4) {
+                    auto key = "key/" + std::to_string(i);
+                    results[t].push_back(executor.submit([key, i] (database_t & db) {
+                        db.set(key, i);
+                    }));
+                }
+            });
+        }
+
+        for (auto & w: writers)
+            w.join();
+
+        for (auto & r: results) {
+            for (auto & f: r)
+                f.get();
+        }
+
+        // Failed operation does not affect others
+        auto f1 = executor.submit([] (database_t & db) { db.set("a", 1); });
+        auto f2 = executor.submit([] (database_t & db) {
+            db.set("b", 2);
+            throw std::runtime_error{"failure"};
+        });
+        auto f3 = executor.submit([] (database_t & db) { db.set("c", 3); });
+
+        CHECK_NOTHROW(f1.get());
+        CHECK_THROWS_AS(f2.get(), std::runtime_error);
+        CHECK_NOTHROW(f3.get());
+
+        executor.flush();
+
+        auto stats = executor.stats();
+        CHECK_EQ(stats.operations, 1004);
+        CHECK_EQ(stats.failures, 1);
+        CHECK_GE(stats.batches, 10);
+        CHECK_LT(stats.batches, 1004);
+    }
+
+    auto db = database_t::make(db_path, "test-kv", true);
+
+    for (int i = 0; i < 1000; i++)
+        REQUIRE_EQ(db.get<int>("key/" + std::to_string(i)), i);
+
+    CHECK_EQ(db.get<int>("a"), 1);
+    CHECK_EQ(db.get_or<int>("b", -1), -1);
+    CHECK_EQ(db.get<int>("c"), 3);
+
+    db = database_t{};
+    debby::sqlite3::wipe(db_path);
+}
+
+TEST_CASE("sqlite3 relational write executor") {
+    using database_t = debby::relational_database<debby::backend_enum::sqlite3>;
+    using executor_t = debby::write_executor<database_t>;
+
+    auto db_path = fs::temp_directory_path() / PFS__LITERAL_PATH("debby-write-executor-rel.db");
+    debby::sqlite3::wipe(db_path);
+
+    {
+        auto db = debby::sqlite3::make(db_path);
+        db.query("CREATE TABLE t (col INTEGER)");
+
+        executor_t executor {std::move(db)};
+        std::vector<std::future<void>> results;
+
+        for (int i = 0; i < 100; i++) {
+            results.push_back(executor.submit([i] (database_t & db) {
+                auto stmt = db.prepare_cached("INSERT INTO t (col) VALUES (?)");
+                stmt.bind(1, i);
+                stmt.exec();
+            }));
+        }
+
+        // SQL error is passed to the future
+        auto failed = executor.submit([] (database_t & db) { db.query("INSERT INTO missing VALUES (1)"); });
+        CHECK_THROWS_AS(failed.get(), debby::error);
+
+        for (auto & f: results)
+            f.get();
+
+        // Operation thrown exception inside nested transaction
+        auto f1 = executor.submit([] (database_t & db) {
+            db.begin();
+            db.query("INSERT INTO t (col) VALUES (-1)");
+            throw std::runtime_error{"failure"};
+        });
+
+        CHECK_THROWS_AS(f1.get(), std::runtime_error);
+
+        // Operation left nested transaction started
+        auto f2 = executor.submit([] (database_t & db) {
+            db.begin();
+            db.query("INSERT INTO t (col) VALUES (-2)");
+        });
+
+        CHECK_THROWS_AS(f2.get(), debby::error);
+
+        auto f3 = executor.submit([] (database_t & db) { db.query("INSERT INTO t (col) VALUES (100)"); });
+        CHECK_NOTHROW(f3.get());
+    }
+
+    auto db = debby::sqlite3::make(db_path);
+    CHECK_EQ(db.rows_count("t"), 101);
+
+    db = database_t{};
+    debby::sqlite3::wipe(db_path);
+}
+#endif